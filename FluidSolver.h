@@ -0,0 +1,397 @@
+#ifndef FLUID_SOLVER_H
+#define FLUID_SOLVER_H
+
+// Navier-Stokes Fluid Simulation for Quasar Jet Dynamics
+// 2D incompressible solver based on Jos Stam's "Stable Fluids" method.
+// Grid size is a run-time parameter: n x n interior cells plus one ghost layer,
+// cell (i, j) stored at i + (n + 2) * j for i, j in 0..n+1.
+//
+// The six fields share one 64-byte aligned allocation (one field after the
+// other), and every loop runs j outer / i inner so the inner loop is unit
+// stride. Stencil loops are split into tiles sized for L2 and the tiles are
+// distributed with OpenMP.
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+#include "uqff_multigrid.h"
+#include "uqff_simd.h"
+#include "uqff_tracing.h"
+#include "uqff_checkpoint.h"
+
+// Linear solver used by FluidSolver::diffuse() and project()
+enum class PoissonBackend
+{
+    GaussSeidel, // fixed 20 red-black Gauss-Seidel sweeps
+    Multigrid    // V-cycles down to a residual tolerance (uqff_multigrid.h)
+};
+
+class FluidSolver
+{
+public:
+    enum Field
+    {
+        U,
+        V,
+        U_PREV,
+        V_PREV,
+        DENS,
+        DENS_PREV,
+        FIELD_COUNT
+    };
+
+    static constexpr size_t ALIGNMENT = 64;           // bytes; start of every field
+    static constexpr size_t L2_TILE_BYTES = 256 << 10; // working set per tile
+    static constexpr int TILE_WIDTH = 512;             // max cells per tile row
+    static constexpr int TILE_STREAMS = 4;             // fields a stencil loop touches
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(double *p) const { ::operator delete[](p, std::align_val_t(ALIGNMENT)); }
+    };
+
+    int n;
+    size_t stride; // n + 2
+    size_t pitch;  // doubles between fields, rounded up to ALIGNMENT
+    int tile_width;
+    int tile_rows;
+    std::unique_ptr<double[], AlignedDelete> storage;
+
+public:
+    double *u, *v, *u_prev, *v_prev, *dens, *dens_prev;
+    double dt;   // time step
+    double visc; // viscosity
+    PoissonBackend backend;
+    bool vectorized_advect = true; // advectRowSIMD (false: advectRowScalar)
+    MultigridSolver multigrid;
+    MultigridStats last_solve;       // stats of the most recent multigrid solve
+    uint64_t unconverged_solves = 0; // multigrid solves that stopped at max_cycles
+
+    explicit FluidSolver(int grid = 32, PoissonBackend solver = PoissonBackend::GaussSeidel,
+                         double time_step = 0.1, double viscosity = 0.0001)
+        : n(grid), stride(static_cast<size_t>(grid) + 2), dt(time_step), visc(viscosity),
+          backend(solver), multigrid(grid)
+    {
+        const size_t per_line = ALIGNMENT / sizeof(double);
+        const size_t cells = stride * stride;
+        pitch = (cells + per_line - 1) / per_line * per_line;
+
+        const size_t total = pitch * FIELD_COUNT;
+        storage.reset(static_cast<double *>(::operator new[](total * sizeof(double), std::align_val_t(ALIGNMENT))));
+        std::fill(storage.get(), storage.get() + total, 0.0);
+
+        u = field(U);
+        v = field(V);
+        u_prev = field(U_PREV);
+        v_prev = field(V_PREV);
+        dens = field(DENS);
+        dens_prev = field(DENS_PREV);
+
+        tile_width = std::min(n, TILE_WIDTH);
+        const size_t row_bytes = static_cast<size_t>(tile_width) * sizeof(double) * TILE_STREAMS;
+        tile_rows = static_cast<int>(std::clamp<size_t>(L2_TILE_BYTES / row_bytes, 1, static_cast<size_t>(n)));
+    }
+
+    int size() const { return n; }
+    size_t cellCount() const { return stride * stride; }
+    size_t index(int i, int j) const { return static_cast<size_t>(i) + stride * static_cast<size_t>(j); }
+    double *field(Field f) { return storage.get() + pitch * f; }
+    const double *field(Field f) const { return storage.get() + pitch * f; }
+
+    // Run fn(i_begin, i_end, j_begin, j_end) over the interior in L2-sized tiles
+    template <typename Fn>
+    void forEachTile(Fn &&fn) const
+    {
+        const int tiles_i = (n + tile_width - 1) / tile_width;
+        const int tiles_j = (n + tile_rows - 1) / tile_rows;
+        const int tiles = tiles_i * tiles_j;
+#pragma omp parallel for schedule(static) if (tiles > 1)
+        for (int t = 0; t < tiles; ++t)
+        {
+            const int i0 = 1 + (t % tiles_i) * tile_width;
+            const int j0 = 1 + (t / tiles_i) * tile_rows;
+            fn(i0, std::min(i0 + tile_width, n + 1), j0, std::min(j0 + tile_rows, n + 1));
+        }
+    }
+
+    void add_source(double *x, const double *s)
+    {
+        const ptrdiff_t count = static_cast<ptrdiff_t>(cellCount());
+#pragma omp parallel for schedule(static) if (count > (1 << 16))
+        for (ptrdiff_t k = 0; k < count; ++k)
+        {
+            x[k] += dt * s[k];
+        }
+    }
+
+    // One red-black sweep of x = (x0 + a * sum(neighbours)) / c
+    void relax(double *x, const double *x0, double a, double c)
+    {
+        const double inv = 1.0 / c;
+        for (int colour = 0; colour < 2; ++colour)
+        {
+            forEachTile([&](int i_begin, int i_end, int j_begin, int j_end)
+                        {
+                            for (int j = j_begin; j < j_end; ++j)
+                            {
+                                double *row = x + index(0, j);
+                                const double *src = x0 + index(0, j);
+                                for (int i = i_begin + ((i_begin + j + colour) & 1); i < i_end; i += 2)
+                                {
+                                    row[i] = (src[i] + a * (row[i - 1] + row[i + 1] + row[i - stride] + row[i + stride])) * inv;
+                                }
+                            }
+                        });
+        }
+    }
+
+    // The last iterate is still used when a solve misses its tolerance; misses are
+    // counted and the first one is reported
+    void multigridSolve(int b, double *x, const double *rhs, double diag, double off)
+    {
+        last_solve = multigrid.solve(b, x, rhs, diag, off);
+        if (last_solve.converged || unconverged_solves++ > 0)
+            return;
+        const std::string message = "FluidSolver: multigrid did not converge (n = " + std::to_string(n) +
+                                    ", relative residual " + std::to_string(last_solve.residual) + " after " +
+                                    std::to_string(last_solve.cycles) + " V-cycles)";
+        std::cerr << "WARNING: " << message << std::endl;
+        TRACE_EVENT(message, TraceLevel::TRACE_WARN);
+    }
+
+    void diffuse(int b, double *x, const double *x0, double diff)
+    {
+        double a = dt * diff * n * n;
+        if (backend == PoissonBackend::Multigrid)
+        {
+            // (1 + 4a) x - a * sum(neighbours) = x0
+            multigridSolve(b, x, x0, 1 + 4 * a, a);
+            return;
+        }
+        for (int k = 0; k < 20; ++k)
+        {
+            relax(x, x0, a, 1 + 4 * a);
+            set_bnd(b, x);
+        }
+    }
+
+    // Semi-Lagrangian back-trace and bilinear sample for cells [i_begin, i_end) of row j
+    static void advectRowScalar(double *d, const double *d0, const double *vx, const double *vy, size_t stride,
+                                int j, int i_begin, int i_end, double dt0, double hi)
+    {
+        for (int i = i_begin; i < i_end; ++i)
+        {
+            const size_t k = static_cast<size_t>(i) + stride * j;
+            double x = std::clamp(i - dt0 * vx[k], 0.5, hi);
+            double y = std::clamp(j - dt0 * vy[k], 0.5, hi);
+            int i0 = (int)x;
+            int j0 = (int)y;
+            double s1 = x - i0;
+            double s0 = 1 - s1;
+            double t1 = y - j0;
+            double t0 = 1 - t1;
+            const double *r0 = d0 + i0 + stride * j0;
+            const double *r1 = r0 + stride;
+            d[k] = s0 * (t0 * r0[0] + t1 * r1[0]) +
+                   s1 * (t0 * r0[1] + t1 * r1[1]);
+        }
+    }
+
+    // Same result as advectRowScalar, one SIMD lane group of cells at a time: clamping is
+    // min/max, cell indices come from one vector float->int conversion, and each lane's
+    // (i0, i0 + 1) neighbours are adjacent in the row so they arrive as a single pair load.
+    static void advectRowSIMD(double *d, const double *d0, const double *vx, const double *vy, size_t stride,
+                              int j, int i_begin, int i_end, double dt0, double hi)
+    {
+        int i = i_begin;
+#if UQFF_SIMD_LANES > 1
+        using namespace uqff_simd;
+        constexpr int lanes = static_cast<int>(Vec::lanes);
+        alignas(64) int idx[lanes];
+        const Vec lo(0.5), top(hi), step(dt0), row_y(static_cast<double>(j)), width(static_cast<double>(stride));
+        for (; i + lanes <= i_end; i += lanes)
+        {
+            const size_t k = static_cast<size_t>(i) + stride * j;
+            Vec x = vmin(vmax(ramp(i) - step * Vec::load(vx + k), lo), top);
+            Vec y = vmin(vmax(row_y - step * Vec::load(vy + k), lo), top);
+            Vec x0 = vfloor(x), y0 = vfloor(y);
+            Vec s1 = x - x0, s0 = 1.0 - s1;
+            Vec t1 = y - y0, t0 = 1.0 - t1;
+            truncToInt(x0 + width * y0, idx);
+
+            Vec a0, a1, b0, b1;
+            loadPairs(d0, idx, a0, a1);          // row j0
+            loadPairs(d0 + stride, idx, b0, b1); // row j0 + 1
+            Vec r = s0 * (t0 * a0 + t1 * b0) + s1 * (t0 * a1 + t1 * b1);
+            r.store(d + k);
+        }
+#endif
+        advectRowScalar(d, d0, vx, vy, stride, j, i, i_end, dt0, hi);
+    }
+
+    void advect(int b, double *d, const double *d0)
+    {
+        const double dt0 = dt * n;
+        const double hi = n + 0.5;
+        auto row_kernel = vectorized_advect ? &FluidSolver::advectRowSIMD : &FluidSolver::advectRowScalar;
+        forEachTile([&](int i_begin, int i_end, int j_begin, int j_end)
+                    {
+                        for (int j = j_begin; j < j_end; ++j)
+                        {
+                            row_kernel(d, d0, u, v, stride, j, i_begin, i_end, dt0, hi);
+                        }
+                    });
+        set_bnd(b, d);
+    }
+
+    void project(double *vx, double *vy, double *p, double *div)
+    {
+        double h = 1.0 / n;
+        forEachTile([&](int i_begin, int i_end, int j_begin, int j_end)
+                    {
+                        for (int j = j_begin; j < j_end; ++j)
+                        {
+                            for (int i = i_begin; i < i_end; ++i)
+                            {
+                                const size_t k = index(i, j);
+                                div[k] = -0.5 * h * (vx[k + 1] - vx[k - 1] + vy[k + stride] - vy[k - stride]);
+                                p[k] = 0;
+                            }
+                        }
+                    });
+        set_bnd(0, div);
+        set_bnd(0, p);
+        if (backend == PoissonBackend::Multigrid)
+        {
+            // 4p - sum(neighbours) = div, pure Neumann
+            multigridSolve(0, p, div, 4.0, 1.0);
+        }
+        else
+        {
+            for (int k = 0; k < 20; ++k)
+            {
+                relax(p, div, 1.0, 4.0);
+                set_bnd(0, p);
+            }
+        }
+        forEachTile([&](int i_begin, int i_end, int j_begin, int j_end)
+                    {
+                        for (int j = j_begin; j < j_end; ++j)
+                        {
+                            for (int i = i_begin; i < i_end; ++i)
+                            {
+                                const size_t k = index(i, j);
+                                vx[k] -= 0.5 * (p[k + 1] - p[k - 1]) / h;
+                                vy[k] -= 0.5 * (p[k + stride] - p[k - stride]) / h;
+                            }
+                        }
+                    });
+        set_bnd(1, vx);
+        set_bnd(2, vy);
+    }
+
+    void set_bnd(int b, double *x)
+    {
+        MultigridSolver::setBoundary(b, x, n);
+    }
+
+    void step(double uqff_g = 0.0)
+    {
+        TRACE_SPAN("FluidSolver::step", SpanType::SIMULATION_STEP);
+
+        // Add UQFF gravity-like force as body force in v (assuming vertical direction for simplicity)
+        forEachTile([&](int i_begin, int i_end, int j_begin, int j_end)
+                    {
+                        for (int j = j_begin; j < j_end; ++j)
+                        {
+                            double *row = v + index(0, j);
+                            for (int i = i_begin; i < i_end; ++i)
+                            {
+                                row[i] += dt * uqff_g; // Integrate UQFF acceleration into velocity
+                            }
+                        }
+                    });
+
+        diffuse(1, u_prev, u, visc);
+        diffuse(2, v_prev, v, visc);
+        project(u_prev, v_prev, u, v);
+        advect(1, u, u_prev);
+        advect(2, v, v_prev);
+        project(u, v, u_prev, v_prev);
+    }
+
+    void add_jet_force(double force)
+    {
+        // Add force in the center as a jet (simulating SCm expulsion)
+        for (int i = n / 4; i <= 3 * n / 4; ++i)
+        {
+            v[index(i, n / 2)] += force;
+        }
+    }
+
+    // Snapshot of the full state after `steps` steps (all six fields, ghost cells included)
+    uqff_checkpoint::Checkpoint checkpoint(uint64_t steps) const
+    {
+        static const char *const names[FIELD_COUNT] = {"u", "v", "u_prev", "v_prev", "dens", "dens_prev"};
+        uqff_checkpoint::Checkpoint ckpt("FluidSolver");
+        ckpt.addU64("grid", static_cast<uint64_t>(n));
+        ckpt.addU64("step", steps);
+        ckpt.addU64("backend", static_cast<uint64_t>(backend));
+        ckpt.addDouble("dt", dt);
+        ckpt.addDouble("visc", visc);
+        for (int f = 0; f < FIELD_COUNT; ++f)
+        {
+            ckpt.addDoubles(names[f], {field(static_cast<Field>(f)), cellCount()});
+        }
+        return ckpt;
+    }
+
+    // Load a checkpoint() of a solver with the same grid size; returns its step count
+    uint64_t restore(const uqff_checkpoint::Checkpoint &ckpt)
+    {
+        static const char *const names[FIELD_COUNT] = {"u", "v", "u_prev", "v_prev", "dens", "dens_prev"};
+        if (ckpt.kind() != "FluidSolver")
+            throw std::runtime_error("FluidSolver::restore: checkpoint was written by '" + ckpt.kind() + "'");
+        if (ckpt.getU64("grid") != static_cast<uint64_t>(n))
+            throw std::runtime_error("FluidSolver::restore: checkpoint grid is " + std::to_string(ckpt.getU64("grid")) +
+                                     ", solver grid is " + std::to_string(n));
+        backend = static_cast<PoissonBackend>(ckpt.getU64("backend"));
+        dt = ckpt.getDouble("dt");
+        visc = ckpt.getDouble("visc");
+        for (int f = 0; f < FIELD_COUNT; ++f)
+        {
+            ckpt.copyDoubles(names[f], {field(static_cast<Field>(f)), cellCount()});
+        }
+        return ckpt.getU64("step");
+    }
+
+    // Large grids are sampled down to at most 64 columns
+    void print_velocity_field() const
+    {
+        const int skip = (n + 63) / 64;
+        std::cout << "Velocity field (magnitude):" << std::endl;
+        for (int j = n; j >= 1; j -= skip)
+        { // Print top to bottom
+            for (int i = 1; i <= n; i += skip)
+            {
+                const size_t k = index(i, j);
+                double mag = std::sqrt(u[k] * u[k] + v[k] * v[k]);
+                char sym = (mag > 1.0) ? '#' : (mag > 0.5) ? '+'
+                                           : (mag > 0.1)   ? '.'
+                                                           : ' ';
+                std::cout << sym;
+            }
+            std::cout << std::endl;
+        }
+    }
+};
+
+#endif // FLUID_SOLVER_H
@@ -0,0 +1,394 @@
+#ifndef FLUID_SOLVER_3D_H
+#define FLUID_SOLVER_3D_H
+
+// 3D Stable Fluids solver for the quasar jet simulation (companion to FluidSolver.h)
+// Grid: n^3 interior cells plus one ghost layer, cell (i, j, k) stored at
+// i + (n+2) * (j + (n+2) * k), so each z-plane is contiguous.
+//
+// Threading is by slab decomposition: participant p of the thread pool owns a
+// contiguous range of z-planes for the whole step. Stencil phases only read the
+// planes next to a slab, so instead of a global barrier each slab publishes an
+// epoch when it finishes a phase and waits for its two neighbours to publish
+// theirs (the shared-memory form of a halo exchange). Advection back-traces to
+// arbitrary planes and is the only phase fenced by a full barrier.
+//
+// Memory: six fields (u, v, w and their _prev scratch copies) and nothing else;
+// project() uses the _prev/velocity buffers for pressure and divergence in place,
+// as the 2D solver does. With Real = float a 256^3 grid needs ~412 MB.
+
+#include <vector>
+#include <atomic>
+#include <barrier>
+#include <thread>
+#include <memory>
+#include <new>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include "uqff_thread_pool.h"
+#include "uqff_tracing.h"
+
+template <typename Real = double>
+class FluidSolver3D
+{
+public:
+    enum class Axis
+    {
+        X,
+        Y,
+        Z
+    };
+
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr int FIELD_COUNT = 6;
+    static constexpr int SWEEPS = 20; // red-black Gauss-Seidel sweeps per solve
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(Real *p) const { ::operator delete[](p, std::align_val_t(ALIGNMENT)); }
+    };
+
+    // Own cache line per slab so epoch polling does not false-share
+    struct alignas(64) Slab
+    {
+        std::atomic<long> epoch{0};
+        int z_begin = 0; // first owned interior plane
+        int z_end = 0;   // one past the last
+    };
+
+    int n;
+    size_t stride; // n + 2
+    size_t plane;  // (n + 2)^2
+    size_t pitch;  // elements between fields, rounded up to ALIGNMENT
+    std::unique_ptr<Real[], AlignedDelete> storage;
+    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<Slab[]> slabs;
+    int slab_count;
+
+public:
+    Real *u, *v, *w, *u_prev, *v_prev, *w_prev;
+    Real dt;   // time step
+    Real visc; // viscosity
+    Axis jet_axis;
+
+    explicit FluidSolver3D(int grid = 32, Axis axis = Axis::Z, size_t threads = ThreadPool::defaultThreads(),
+                           Real time_step = Real(0.1), Real viscosity = Real(0.0001))
+        : n(grid), stride(static_cast<size_t>(grid) + 2), plane(stride * stride),
+          pool(std::make_unique<ThreadPool>(threads)), dt(time_step), visc(viscosity), jet_axis(axis)
+    {
+        const size_t per_line = ALIGNMENT / sizeof(Real);
+        const size_t cells = plane * stride;
+        pitch = (cells + per_line - 1) / per_line * per_line;
+
+        const size_t total = pitch * FIELD_COUNT;
+        storage.reset(static_cast<Real *>(::operator new[](total * sizeof(Real), std::align_val_t(ALIGNMENT))));
+
+        Real **fields[FIELD_COUNT] = {&u, &v, &w, &u_prev, &v_prev, &w_prev};
+        for (int f = 0; f < FIELD_COUNT; ++f)
+        {
+            *fields[f] = storage.get() + pitch * f;
+        }
+
+        slab_count = static_cast<int>(std::min<size_t>(pool->concurrency(), static_cast<size_t>(n)));
+        slabs.reset(new Slab[slab_count]);
+        for (int p = 0; p < slab_count; ++p)
+        {
+            slabs[p].z_begin = 1 + n * p / slab_count;
+            slabs[p].z_end = 1 + n * (p + 1) / slab_count;
+        }
+
+        // First touch from the owning slab's thread places its planes locally
+        pool->runOnAll([&](size_t p)
+                       {
+                           if (static_cast<int>(p) >= slab_count)
+                               return;
+                           const size_t first = p == 0 ? 0 : index(0, 0, slabs[p].z_begin);
+                           const size_t last = static_cast<int>(p) + 1 == slab_count ? pitch : index(0, 0, slabs[p].z_end);
+                           for (int f = 0; f < FIELD_COUNT; ++f)
+                           {
+                               std::fill(storage.get() + pitch * f + first, storage.get() + pitch * f + last, Real(0));
+                           }
+                       });
+    }
+
+    int size() const { return n; }
+    int slabCount() const { return slab_count; }
+    size_t memoryBytes() const { return pitch * FIELD_COUNT * sizeof(Real); }
+    size_t index(int i, int j, int k) const
+    {
+        return static_cast<size_t>(i) + stride * static_cast<size_t>(j) + plane * static_cast<size_t>(k);
+    }
+
+    void step(double uqff_g = 0.0)
+    {
+        TRACE_SPAN("FluidSolver3D::step", SpanType::SIMULATION_STEP);
+
+        Real *axis_velocity = jet_axis == Axis::X ? u : jet_axis == Axis::Y ? v : w;
+        const Real force = static_cast<Real>(dt * uqff_g);
+        std::barrier<> fence(slab_count);
+
+        pool->runOnAll([&](size_t participant)
+                       {
+                           const int p = static_cast<int>(participant);
+                           if (p >= slab_count)
+                               return;
+
+                           // Add UQFF acceleration as a body force along the jet axis
+                           forOwnCells(p, [&](size_t c)
+                                       { axis_velocity[c] += force; });
+
+                           diffuse(p, 1, u_prev, u, visc);
+                           diffuse(p, 2, v_prev, v, visc);
+                           diffuse(p, 3, w_prev, w, visc);
+                           project(p, u_prev, v_prev, w_prev, u, v);
+
+                           fence.arrive_and_wait();
+                           advect(p, u, u_prev);
+                           advect(p, v, v_prev);
+                           advect(p, w, w_prev);
+                           set_bnd(p, 1, u);
+                           set_bnd(p, 2, v);
+                           set_bnd(p, 3, w);
+                           fence.arrive_and_wait();
+
+                           project(p, u, v, w, u_prev, v_prev);
+                       });
+    }
+
+    // Jet nozzle: a square patch in the mid-plane across the jet axis, pushed along it
+    void add_jet_force(double force)
+    {
+        Real *axis_velocity = jet_axis == Axis::X ? u : jet_axis == Axis::Y ? v : w;
+        for (int a = n / 4; a <= 3 * n / 4; ++a)
+        {
+            for (int b = n / 4; b <= 3 * n / 4; ++b)
+            {
+                const size_t c = jet_axis == Axis::X ? index(n / 2, a, b) : jet_axis == Axis::Y ? index(a, n / 2, b)
+                                                                                              : index(a, b, n / 2);
+                axis_velocity[c] += static_cast<Real>(force);
+            }
+        }
+    }
+
+    Real speed(int i, int j, int k) const
+    {
+        const size_t c = index(i, j, k);
+        return std::sqrt(u[c] * u[c] + v[c] * v[c] + w[c] * w[c]);
+    }
+
+    // Mid-plane slice containing the jet axis, sampled down to at most 64 columns
+    void print_velocity_slice() const
+    {
+        const int skip = (n + 63) / 64;
+        std::cout << "Velocity field (magnitude, mid-plane slice):" << std::endl;
+        for (int r = n; r >= 1; r -= skip)
+        { // jet axis runs bottom to top
+            for (int q = 1; q <= n; q += skip)
+            {
+                Real mag = jet_axis == Axis::X ? speed(r, q, n / 2) : jet_axis == Axis::Y ? speed(q, r, n / 2)
+                                                                                          : speed(q, n / 2, r);
+                char sym = (mag > 1.0) ? '#' : (mag > 0.5) ? '+'
+                                           : (mag > 0.1)   ? '.'
+                                                           : ' ';
+                std::cout << sym;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    // Interior speed as a raw float32 n^3 volume (x fastest), for volume viewers
+    bool write_speed_raw(const std::string &filename) const
+    {
+        std::FILE *out = std::fopen(filename.c_str(), "wb");
+        if (!out)
+            return false;
+        std::vector<float> row(n);
+        bool ok = true;
+        for (int k = 1; k <= n && ok; ++k)
+        {
+            for (int j = 1; j <= n && ok; ++j)
+            {
+                for (int i = 1; i <= n; ++i)
+                    row[i - 1] = static_cast<float>(speed(i, j, k));
+                ok = std::fwrite(row.data(), sizeof(float), row.size(), out) == row.size();
+            }
+        }
+        return std::fclose(out) == 0 && ok;
+    }
+
+private:
+    // Publish that slab p finished a phase, then wait until both neighbours have too
+    void exchangeHalo(int p)
+    {
+        const long e = slabs[p].epoch.load(std::memory_order_relaxed) + 1;
+        slabs[p].epoch.store(e, std::memory_order_release);
+        for (int q : {p - 1, p + 1})
+        {
+            if (q < 0 || q >= slab_count)
+                continue;
+            while (slabs[q].epoch.load(std::memory_order_acquire) < e)
+                std::this_thread::yield();
+        }
+    }
+
+    template <typename Fn>
+    void forOwnCells(int p, Fn &&fn)
+    {
+        for (int k = slabs[p].z_begin; k < slabs[p].z_end; ++k)
+            for (int j = 1; j <= n; ++j)
+            {
+                const size_t row = index(0, j, k);
+                for (int i = 1; i <= n; ++i)
+                    fn(row + i);
+            }
+    }
+
+    // Cells with (i + j + k) % 2 == colour: x = (x0 + a * sum(6 neighbours)) / c
+    void relaxColour(int p, Real *x, const Real *x0, Real a, Real c, int colour)
+    {
+        const Real inv = Real(1) / c;
+        for (int k = slabs[p].z_begin; k < slabs[p].z_end; ++k)
+        {
+            for (int j = 1; j <= n; ++j)
+            {
+                Real *row = x + index(0, j, k);
+                const Real *src = x0 + index(0, j, k);
+                for (int i = 1 + ((1 + j + k + colour) & 1); i <= n; i += 2)
+                {
+                    row[i] = (src[i] + a * (row[i - 1] + row[i + 1] + row[i - stride] + row[i + stride] +
+                                            row[i - plane] + row[i + plane])) *
+                             inv;
+                }
+            }
+        }
+    }
+
+    void solve(int p, int b, Real *x, const Real *x0, Real a, Real c)
+    {
+        for (int sweep = 0; sweep < SWEEPS; ++sweep)
+        {
+            relaxColour(p, x, x0, a, c, 0);
+            exchangeHalo(p);
+            relaxColour(p, x, x0, a, c, 1);
+            set_bnd(p, b, x);
+            exchangeHalo(p);
+        }
+    }
+
+    void diffuse(int p, int b, Real *x, const Real *x0, Real diff)
+    {
+        const Real a = dt * diff * n * n;
+        solve(p, b, x, x0, a, 1 + 6 * a);
+    }
+
+    void advect(int p, Real *d, const Real *d0)
+    {
+        const Real dt0 = dt * n;
+        const Real lo = Real(0.5), hi = Real(n) + Real(0.5);
+        for (int k = slabs[p].z_begin; k < slabs[p].z_end; ++k)
+        {
+            for (int j = 1; j <= n; ++j)
+            {
+                for (int i = 1; i <= n; ++i)
+                {
+                    const size_t c = index(i, j, k);
+                    Real x = std::clamp(i - dt0 * u[c], lo, hi);
+                    Real y = std::clamp(j - dt0 * v[c], lo, hi);
+                    Real z = std::clamp(k - dt0 * w[c], lo, hi);
+                    int i0 = (int)x, j0 = (int)y, k0 = (int)z;
+                    Real s1 = x - i0, s0 = 1 - s1;
+                    Real t1 = y - j0, t0 = 1 - t1;
+                    Real r1 = z - k0, r0 = 1 - r1;
+                    const Real *a = d0 + index(i0, j0, k0);
+                    const Real *b = a + plane;
+                    d[c] = r0 * (s0 * (t0 * a[0] + t1 * a[stride]) + s1 * (t0 * a[1] + t1 * a[stride + 1])) +
+                           r1 * (s0 * (t0 * b[0] + t1 * b[stride]) + s1 * (t0 * b[1] + t1 * b[stride + 1]));
+                }
+            }
+        }
+    }
+
+    void project(int p, Real *vx, Real *vy, Real *vz, Real *pr, Real *div)
+    {
+        const Real h = Real(1) / n;
+        forOwnCells(p, [&](size_t c)
+                    {
+                        div[c] = Real(-0.5) * h * (vx[c + 1] - vx[c - 1] + vy[c + stride] - vy[c - stride] +
+                                                   vz[c + plane] - vz[c - plane]);
+                        pr[c] = 0;
+                    });
+        set_bnd(p, 0, div);
+        set_bnd(p, 0, pr);
+        exchangeHalo(p);
+
+        solve(p, 0, pr, div, Real(1), Real(6));
+
+        forOwnCells(p, [&](size_t c)
+                    {
+                        vx[c] -= Real(0.5) * (pr[c + 1] - pr[c - 1]) / h;
+                        vy[c] -= Real(0.5) * (pr[c + stride] - pr[c - stride]) / h;
+                        vz[c] -= Real(0.5) * (pr[c + plane] - pr[c - plane]) / h;
+                    });
+        set_bnd(p, 1, vx);
+        set_bnd(p, 2, vy);
+        set_bnd(p, 3, vz);
+        exchangeHalo(p);
+    }
+
+    // Ghost cells of the planes slab p owns (plus the z = 0 / n+1 faces for the end slabs).
+    // b selects the velocity component whose normal is reflected: 1 = x, 2 = y, 3 = z.
+    void set_bnd(int p, int b, Real *x)
+    {
+        const bool first = p == 0, last = p + 1 == slab_count;
+        const int m = n + 1;
+        auto at = [&](int i, int j, int k) -> Real &
+        { return x[index(i, j, k)]; };
+
+        for (int k = slabs[p].z_begin; k < slabs[p].z_end; ++k)
+        {
+            for (int j = 1; j <= n; ++j)
+            {
+                at(0, j, k) = b == 1 ? -at(1, j, k) : at(1, j, k);
+                at(m, j, k) = b == 1 ? -at(n, j, k) : at(n, j, k);
+            }
+            for (int i = 1; i <= n; ++i)
+            {
+                at(i, 0, k) = b == 2 ? -at(i, 1, k) : at(i, 1, k);
+                at(i, m, k) = b == 2 ? -at(i, n, k) : at(i, n, k);
+            }
+            at(0, 0, k) = Real(0.5) * (at(1, 0, k) + at(0, 1, k));
+            at(0, m, k) = Real(0.5) * (at(1, m, k) + at(0, n, k));
+            at(m, 0, k) = Real(0.5) * (at(n, 0, k) + at(m, 1, k));
+            at(m, m, k) = Real(0.5) * (at(n, m, k) + at(m, n, k));
+        }
+
+        for (int face = 0; face < 2; ++face)
+        {
+            if (face == 0 ? !first : !last)
+                continue;
+            const int kg = face == 0 ? 0 : m; // ghost plane
+            const int ki = face == 0 ? 1 : n; // adjacent interior plane
+            for (int j = 1; j <= n; ++j)
+                for (int i = 1; i <= n; ++i)
+                    at(i, j, kg) = b == 3 ? -at(i, j, ki) : at(i, j, ki);
+            for (int q = 1; q <= n; ++q)
+            {
+                at(0, q, kg) = Real(0.5) * (at(1, q, kg) + at(0, q, ki));
+                at(m, q, kg) = Real(0.5) * (at(n, q, kg) + at(m, q, ki));
+                at(q, 0, kg) = Real(0.5) * (at(q, 1, kg) + at(q, 0, ki));
+                at(q, m, kg) = Real(0.5) * (at(q, n, kg) + at(q, m, ki));
+            }
+            const Real third = Real(1) / 3;
+            at(0, 0, kg) = third * (at(1, 0, kg) + at(0, 1, kg) + at(0, 0, ki));
+            at(m, 0, kg) = third * (at(n, 0, kg) + at(m, 1, kg) + at(m, 0, ki));
+            at(0, m, kg) = third * (at(1, m, kg) + at(0, n, kg) + at(0, m, ki));
+            at(m, m, kg) = third * (at(n, m, kg) + at(m, n, kg) + at(m, m, ki));
+        }
+    }
+};
+
+#endif // FLUID_SOLVER_3D_H
@@ -2,10 +2,15 @@
 
 #include <string>
 #include <vector>
+#include <array>
+#include <span>
 #include "nlohmann/json.hpp" // Assume downloaded and included from https://github.com/nlohmann/json
 
 using json = nlohmann::json;
 
+// Fixed 4x4 tensor (metric, A_mu_nu); no heap allocation
+using Tensor4 = std::array<std::array<double, 4>, 4>;
+
 struct CelestialBody
 {
     std::string name;
@@ -37,6 +42,7 @@ std::vector<CelestialBody> load_bodies(const std::string &filename);
 #include <sstream>
 #include <stdexcept>
 #include <regex> // For file extension check
+#include "uqff_catalog.h"
 
 extern const double PI;
 extern const double G;
@@ -61,7 +67,7 @@ extern double C_concentration;
 extern double f_feedback;
 extern double num_strings;
 extern double Ts00;
-extern std::vector<std::vector<double>> g_mu_nu;
+extern Tensor4 g_mu_nu;
 extern double Omega_g;
 extern double Mbh;
 extern double dg;
@@ -189,37 +195,25 @@ std::vector<CelestialBody> load_bodies(const std::string &filename)
     }
     else
     {
-        // CSV fallback
-        std::string line;
-        while (std::getline(in, line))
+        // CSV fallback: mapped and parsed in parallel straight into columns
+        in.close();
+        uqff_catalog::Table table = uqff_catalog::load(filename, 11);
+        bodies.resize(table.rows());
+        for (size_t i = 0; i < bodies.size(); ++i)
         {
-            std::stringstream ss(line);
-            CelestialBody body;
-            std::string token;
-            std::getline(ss, body.name, ',');
-            std::getline(ss, token, ',');
-            body.Ms = std::stod(token);
-            std::getline(ss, token, ',');
-            body.Rs = std::stod(token);
-            std::getline(ss, token, ',');
-            body.Rb = std::stod(token);
-            std::getline(ss, token, ',');
-            body.Ts_surface = std::stod(token);
-            std::getline(ss, token, ',');
-            body.omega_s = std::stod(token);
-            std::getline(ss, token, ',');
-            body.Bs_avg = std::stod(token);
-            std::getline(ss, token, ',');
-            body.SCm_density = std::stod(token);
-            std::getline(ss, token, ',');
-            body.QUA = std::stod(token);
-            std::getline(ss, token, ',');
-            body.Pcore = std::stod(token);
-            std::getline(ss, token, ',');
-            body.PSCm = std::stod(token);
-            std::getline(ss, token, ',');
-            body.omega_c = std::stod(token);
-            bodies.push_back(body);
+            CelestialBody &body = bodies[i];
+            body.name = std::move(table.names[i]);
+            body.Ms = table.columns[0][i];
+            body.Rs = table.columns[1][i];
+            body.Rb = table.columns[2][i];
+            body.Ts_surface = table.columns[3][i];
+            body.omega_s = table.columns[4][i];
+            body.Bs_avg = table.columns[5][i];
+            body.SCm_density = table.columns[6][i];
+            body.QUA = table.columns[7][i];
+            body.Pcore = table.columns[8][i];
+            body.PSCm = table.columns[9][i];
+            body.omega_c = table.columns[10][i];
         }
     }
     return bodies;
@@ -268,11 +262,10 @@ double C_concentration = 1.0;
 double f_feedback = 0.1;
 const double num_strings = 1e9;
 double Ts00 = 1.27e3 + 1.11e7;
-std::vector<std::vector<double>> g_mu_nu = {
-    {1.0, 0.0, 0.0, 0.0},
-    {0.0, -1.0, 0.0, 0.0},
-    {0.0, 0.0, -1.0, 0.0},
-    {0.0, 0.0, 0.0, -1.0}};
+Tensor4 g_mu_nu = {{{1.0, 0.0, 0.0, 0.0},
+                    {0.0, -1.0, 0.0, 0.0},
+                    {0.0, 0.0, -1.0, 0.0},
+                    {0.0, 0.0, 0.0, -1.0}}};
 
 double compute_Ug4(double t, double tn, double rho_v, double C_concentration, double Mbh, double dg, double alpha, double f_feedback, double k4)
 {
@@ -291,9 +284,9 @@ double compute_Ubi(double Ugi, double beta_i, double Omega_g, double Mbh, double
     return -beta_i * Ugi * Omega_g * Mbh / dg * wind_mod * UUA * std::cos(PI * tn);
 }
 
-std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double Ts00)
+Tensor4 compute_A_mu_nu(double tn, double eta, double Ts00)
 {
-    std::vector<std::vector<double>> A = g_mu_nu;
+    Tensor4 A = g_mu_nu;
     double mod = eta * Ts00 * std::cos(PI * tn);
     for (int i = 0; i < 4; ++i)
     {
@@ -305,28 +298,74 @@ std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double T
     return A;
 }
 
-double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
+// Trace of compute_A_mu_nu() without building the tensor
+double compute_A_mu_nu_trace(double tn, double eta, double Ts00)
 {
-    try
-    {
-        double Ug1 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1);
-        double Ug2 = compute_Ug2(body, r, t, tn, k2, QA, delta_sw, v_sw, HSCm, rho_A, kappa);
-        double Ug3 = compute_Ug3(body, r, t, tn, theta, rho_A, kappa, k3);
-        double Ug4 = compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
-        double sum_Ugi = Ug1 + Ug2 + Ug3 + Ug4;
+    double mod = eta * Ts00 * std::cos(PI * tn);
+    return (g_mu_nu[0][0] + mod) + (g_mu_nu[1][1] + mod) + (g_mu_nu[2][2] + mod) + (g_mu_nu[3][3] + mod);
+}
 
-        double Ubi1 = compute_Ubi(Ug1, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi2 = compute_Ubi(Ug2, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi3 = compute_Ubi(Ug3, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi4 = compute_Ubi(Ug4, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double sum_Ubi = Ubi1 + Ubi2 + Ubi3 + Ubi4;
+// The parts of FU that depend only on (body, t, tn): r enters through Ug2 alone,
+// theta not at all, and each Ubi is one factor times its Ugi, so
+// FU = (1 + ubi_scale) * (ug134 + Ug2(r)) + rest.
+struct FUTimeTerms
+{
+    double ug134;     // Ug1 + Ug3 + Ug4
+    double ug2_scale; // Ug2 = ug2_scale / r^2 for r > Rb, 0 inside
+    double ubi_scale; // Ubi_i = ubi_scale * Ug_i
+    double rest;      // Um + trace(A_mu_nu)
+};
+
+FUTimeTerms compute_FU_time_terms(const CelestialBody &body, double r, double t, double tn)
+{
+    FUTimeTerms terms;
+    terms.ug134 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1) +
+                  compute_Ug3(body, r, t, tn, 0.0, rho_A, kappa, k3) +
+                  compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
+    double Ereact = compute_Ereact(t, body.SCm_density, v_SCm, rho_A, kappa);
+    terms.ug2_scale = k2 * (QA + body.QUA) * body.Ms * (1.0 + delta_sw * v_sw) * HSCm * Ereact;
+    terms.ubi_scale = compute_Ubi(1.0, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
+    terms.rest = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings) + compute_A_mu_nu_trace(tn, eta, Ts00);
+    return terms;
+}
 
-        double Um = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings);
+// FU at (r[i], t[i], tn[i], theta[i]) for one body. Consecutive points sharing t and
+// tn reuse one compute_FU_time_terms(); no heap allocation. Throws like compute_Ug2
+// on r <= 0, and when the spans differ in length.
+void compute_FU_batch(const CelestialBody &body, std::span<const double> r, std::span<const double> t,
+                      std::span<const double> tn, std::span<const double> theta, std::span<double> out)
+{
+    (void)theta; // FU is independent of theta
+    const size_t n = out.size();
+    if (r.size() != n || t.size() != n || tn.size() != n || theta.size() != n)
+        throw std::runtime_error("compute_FU_batch: input and output spans differ in length");
+    size_t i = 0;
+    while (i < n)
+    {
+        size_t end = i + 1;
+        while (end < n && t[end] == t[i] && tn[end] == tn[i])
+            ++end;
 
-        auto A = compute_A_mu_nu(tn, eta, Ts00);
-        double A_scalar = A[0][0] + A[1][1] + A[2][2] + A[3][3];
+        const FUTimeTerms terms = compute_FU_time_terms(body, r[i], t[i], tn[i]);
+        const double buoyancy = 1.0 + terms.ubi_scale;
+        for (size_t k = i; k < end; ++k)
+        {
+            if (r[k] <= 0.0)
+                throw std::runtime_error("Invalid r value");
+            double Ug2 = r[k] > body.Rb ? terms.ug2_scale / (r[k] * r[k]) : 0.0;
+            out[k] = buoyancy * (terms.ug134 + Ug2) + terms.rest;
+        }
+        i = end;
+    }
+}
 
-        return sum_Ugi + sum_Ubi + Um + A_scalar;
+double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
+{
+    try
+    {
+        double FU;
+        compute_FU_batch(body, {&r, 1}, {&t, 1}, {&tn, 1}, {&theta, 1}, {&FU, 1});
+        return FU;
     }
     catch (const std::exception &e)
     {
@@ -749,11 +788,10 @@ double C_concentration = 1.0;
 double f_feedback = 0.1;
 const double num_strings = 1e9;
 double Ts00 = 1.27e3 + 1.11e7;
-std::vector<std::vector<double>> g_mu_nu = {
-    {1.0, 0.0, 0.0, 0.0},
-    {0.0, -1.0, 0.0, 0.0},
-    {0.0, 0.0, -1.0, 0.0},
-    {0.0, 0.0, 0.0, -1.0}};
+Tensor4 g_mu_nu = {{{1.0, 0.0, 0.0, 0.0},
+                    {0.0, -1.0, 0.0, 0.0},
+                    {0.0, 0.0, -1.0, 0.0},
+                    {0.0, 0.0, 0.0, -1.0}}};
 
 double compute_Ug4(double t, double tn, double rho_v, double C_concentration, double Mbh, double dg, double alpha, double f_feedback, double k4)
 {
@@ -772,11 +810,10 @@ double compute_Ubi(double Ugi, double beta_i, double Omega_g, double Mbh, double
     return -beta_i * Ugi * Omega_g * Mbh / dg * wind_mod * UUA * std::cos(PI * tn);
 }
 
-std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double Ts00)
+Tensor4 compute_A_mu_nu(double tn, double eta, double Ts00)
 {
-    std::vector<std::vector<double>> A = g_mu_nu;
+    Tensor4 A = g_mu_nu;
     double mod = eta * Ts00 * std::cos(PI * tn);
-#pragma omp parallel for
     for (int i = 0; i < 4; ++i)
     {
         for (int j = 0; j < 4; ++j)
@@ -787,33 +824,74 @@ std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double T
     return A;
 }
 
-double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
+// Trace of compute_A_mu_nu() without building the tensor
+double compute_A_mu_nu_trace(double tn, double eta, double Ts00)
 {
-    try
+    double mod = eta * Ts00 * std::cos(PI * tn);
+    return (g_mu_nu[0][0] + mod) + (g_mu_nu[1][1] + mod) + (g_mu_nu[2][2] + mod) + (g_mu_nu[3][3] + mod);
+}
+
+// The parts of FU that depend only on (body, t, tn): r enters through Ug2 alone,
+// theta not at all, and each Ubi is one factor times its Ugi, so
+// FU = (1 + ubi_scale) * (ug134 + Ug2(r)) + rest.
+struct FUTimeTerms
+{
+    double ug134;     // Ug1 + Ug3 + Ug4
+    double ug2_scale; // Ug2 = ug2_scale / r^2 for r > Rb, 0 inside
+    double ubi_scale; // Ubi_i = ubi_scale * Ug_i
+    double rest;      // Um + trace(A_mu_nu)
+};
+
+FUTimeTerms compute_FU_time_terms(const CelestialBody &body, double r, double t, double tn)
+{
+    FUTimeTerms terms;
+    terms.ug134 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1) +
+                  compute_Ug3(body, r, t, tn, 0.0, rho_A, kappa, k3) +
+                  compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
+    double Ereact = compute_Ereact(t, body.SCm_density, v_SCm, rho_A, kappa);
+    terms.ug2_scale = k2 * (QA + body.QUA) * body.Ms * (1.0 + delta_sw * v_sw) * HSCm * Ereact;
+    terms.ubi_scale = compute_Ubi(1.0, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
+    terms.rest = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings) + compute_A_mu_nu_trace(tn, eta, Ts00);
+    return terms;
+}
+
+// FU at (r[i], t[i], tn[i], theta[i]) for one body. Consecutive points sharing t and
+// tn reuse one compute_FU_time_terms(); no heap allocation. Throws like compute_Ug2
+// on r <= 0, and when the spans differ in length.
+void compute_FU_batch(const CelestialBody &body, std::span<const double> r, std::span<const double> t,
+                      std::span<const double> tn, std::span<const double> theta, std::span<double> out)
+{
+    (void)theta; // FU is independent of theta
+    const size_t n = out.size();
+    if (r.size() != n || t.size() != n || tn.size() != n || theta.size() != n)
+        throw std::runtime_error("compute_FU_batch: input and output spans differ in length");
+    size_t i = 0;
+    while (i < n)
     {
-        double Ug1 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1);
-        double Ug2 = compute_Ug2(body, r, t, tn, k2, QA, delta_sw, v_sw, HSCm, rho_A, kappa);
-        double Ug3 = compute_Ug3(body, r, t, tn, theta, rho_A, kappa, k3);
-        double Ug4 = compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
-        double sum_Ugi = Ug1 + Ug2 + Ug3 + Ug4;
-
-        double Ubi1 = compute_Ubi(Ug1, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi2 = compute_Ubi(Ug2, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi3 = compute_Ubi(Ug3, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi4 = compute_Ubi(Ug4, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double sum_Ubi = Ubi1 + Ubi2 + Ubi3 + Ubi4;
-
-        double Um = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings);
-
-        auto A = compute_A_mu_nu(tn, eta, Ts00);
-        double A_scalar = 0.0;
-#pragma omp parallel for reduction(+ : A_scalar)
-        for (int i = 0; i < 4; ++i)
+        size_t end = i + 1;
+        while (end < n && t[end] == t[i] && tn[end] == tn[i])
+            ++end;
+
+        const FUTimeTerms terms = compute_FU_time_terms(body, r[i], t[i], tn[i]);
+        const double buoyancy = 1.0 + terms.ubi_scale;
+        for (size_t k = i; k < end; ++k)
         {
-            A_scalar += A[i][i];
+            if (r[k] <= 0.0)
+                throw std::runtime_error("Invalid r value");
+            double Ug2 = r[k] > body.Rb ? terms.ug2_scale / (r[k] * r[k]) : 0.0;
+            out[k] = buoyancy * (terms.ug134 + Ug2) + terms.rest;
         }
+        i = end;
+    }
+}
 
-        return sum_Ugi + sum_Ubi + Um + A_scalar;
+double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
+{
+    try
+    {
+        double FU;
+        compute_FU_batch(body, {&r, 1}, {&t, 1}, {&tn, 1}, {&theta, 1}, {&FU, 1});
+        return FU;
     }
     catch (const std::exception &e)
     {
@@ -1601,11 +1679,10 @@ double C_concentration = 1.0;
 double f_feedback = 0.1;
 const double num_strings = 1e9;
 double Ts00 = 1.27e3 + 1.11e7;
-std::vector<std::vector<double>> g_mu_nu = {
-    {1.0, 0.0, 0.0, 0.0},
-    {0.0, -1.0, 0.0, 0.0},
-    {0.0, 0.0, -1.0, 0.0},
-    {0.0, 0.0, 0.0, -1.0}};
+Tensor4 g_mu_nu = {{{1.0, 0.0, 0.0, 0.0},
+                    {0.0, -1.0, 0.0, 0.0},
+                    {0.0, 0.0, -1.0, 0.0},
+                    {0.0, 0.0, 0.0, -1.0}}};
 
 double compute_Ug4(double t, double tn, double rho_v, double C_concentration, double Mbh, double dg, double alpha, double f_feedback, double k4)
 {
@@ -1624,11 +1701,10 @@ double compute_Ubi(double Ugi, double beta_i, double Omega_g, double Mbh, double
     return -beta_i * Ugi * Omega_g * Mbh / dg * wind_mod * UUA * std::cos(PI * tn);
 }
 
-std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double Ts00)
+Tensor4 compute_A_mu_nu(double tn, double eta, double Ts00)
 {
-    std::vector<std::vector<double>> A = g_mu_nu;
+    Tensor4 A = g_mu_nu;
     double mod = eta * Ts00 * std::cos(PI * tn);
-#pragma omp parallel for
     for (int i = 0; i < 4; ++i)
     {
         for (int j = 0; j < 4; ++j)
@@ -1639,33 +1715,74 @@ std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double T
     return A;
 }
 
-double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
+// Trace of compute_A_mu_nu() without building the tensor
+double compute_A_mu_nu_trace(double tn, double eta, double Ts00)
 {
-    try
+    double mod = eta * Ts00 * std::cos(PI * tn);
+    return (g_mu_nu[0][0] + mod) + (g_mu_nu[1][1] + mod) + (g_mu_nu[2][2] + mod) + (g_mu_nu[3][3] + mod);
+}
+
+// The parts of FU that depend only on (body, t, tn): r enters through Ug2 alone,
+// theta not at all, and each Ubi is one factor times its Ugi, so
+// FU = (1 + ubi_scale) * (ug134 + Ug2(r)) + rest.
+struct FUTimeTerms
+{
+    double ug134;     // Ug1 + Ug3 + Ug4
+    double ug2_scale; // Ug2 = ug2_scale / r^2 for r > Rb, 0 inside
+    double ubi_scale; // Ubi_i = ubi_scale * Ug_i
+    double rest;      // Um + trace(A_mu_nu)
+};
+
+FUTimeTerms compute_FU_time_terms(const CelestialBody &body, double r, double t, double tn)
+{
+    FUTimeTerms terms;
+    terms.ug134 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1) +
+                  compute_Ug3(body, r, t, tn, 0.0, rho_A, kappa, k3) +
+                  compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
+    double Ereact = compute_Ereact(t, body.SCm_density, v_SCm, rho_A, kappa);
+    terms.ug2_scale = k2 * (QA + body.QUA) * body.Ms * (1.0 + delta_sw * v_sw) * HSCm * Ereact;
+    terms.ubi_scale = compute_Ubi(1.0, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
+    terms.rest = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings) + compute_A_mu_nu_trace(tn, eta, Ts00);
+    return terms;
+}
+
+// FU at (r[i], t[i], tn[i], theta[i]) for one body. Consecutive points sharing t and
+// tn reuse one compute_FU_time_terms(); no heap allocation. Throws like compute_Ug2
+// on r <= 0, and when the spans differ in length.
+void compute_FU_batch(const CelestialBody &body, std::span<const double> r, std::span<const double> t,
+                      std::span<const double> tn, std::span<const double> theta, std::span<double> out)
+{
+    (void)theta; // FU is independent of theta
+    const size_t n = out.size();
+    if (r.size() != n || t.size() != n || tn.size() != n || theta.size() != n)
+        throw std::runtime_error("compute_FU_batch: input and output spans differ in length");
+    size_t i = 0;
+    while (i < n)
     {
-        double Ug1 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1);
-        double Ug2 = compute_Ug2(body, r, t, tn, k2, QA, delta_sw, v_sw, HSCm, rho_A, kappa);
-        double Ug3 = compute_Ug3(body, r, t, tn, theta, rho_A, kappa, k3);
-        double Ug4 = compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
-        double sum_Ugi = Ug1 + Ug2 + Ug3 + Ug4;
-
-        double Ubi1 = compute_Ubi(Ug1, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi2 = compute_Ubi(Ug2, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi3 = compute_Ubi(Ug3, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double Ubi4 = compute_Ubi(Ug4, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-        double sum_Ubi = Ubi1 + Ubi2 + Ubi3 + Ubi4;
-
-        double Um = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings);
-
-        auto A = compute_A_mu_nu(tn, eta, Ts00);
-        double A_scalar = 0.0;
-#pragma omp parallel for reduction(+ : A_scalar)
-        for (int i = 0; i < 4; ++i)
+        size_t end = i + 1;
+        while (end < n && t[end] == t[i] && tn[end] == tn[i])
+            ++end;
+
+        const FUTimeTerms terms = compute_FU_time_terms(body, r[i], t[i], tn[i]);
+        const double buoyancy = 1.0 + terms.ubi_scale;
+        for (size_t k = i; k < end; ++k)
         {
-            A_scalar += A[i][i];
+            if (r[k] <= 0.0)
+                throw std::runtime_error("Invalid r value");
+            double Ug2 = r[k] > body.Rb ? terms.ug2_scale / (r[k] * r[k]) : 0.0;
+            out[k] = buoyancy * (terms.ug134 + Ug2) + terms.rest;
         }
+        i = end;
+    }
+}
 
-        return sum_Ugi + sum_Ubi + Um + A_scalar;
+double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
+{
+    try
+    {
+        double FU;
+        compute_FU_batch(body, {&r, 1}, {&t, 1}, {&tn, 1}, {&theta, 1}, {&FU, 1});
+        return FU;
     }
     catch (const std::exception &e)
     {
@@ -6,7 +6,7 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
-#include <random>
+#include "uqff_rng.h"
 
 namespace UQFF
 {
@@ -15,10 +15,10 @@ namespace UQFF
     {
     private:
         std::map<std::string, double> scaling_factors;
-        std::mt19937 rng;
+        uqff_rng::Stream rng; // drives <random> distributions like the mt19937 it replaces
 
     public:
-        Source10() : rng(std::random_device{}())
+        explicit Source10(uint64_t instance = 0) : rng(uqff_rng::stream("source10", instance))
         {
             // Initialize default scaling factors
             scaling_factors["default"] = 1.0;
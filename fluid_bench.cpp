@@ -0,0 +1,110 @@
+// fluid_bench.cpp
+// Microbenchmark for the FluidSolver kernels: scalar vs SIMD semi-Lagrangian
+// advection, plus a full step for reference.
+//
+// Usage: fluid_bench [N ...]        (default: 256 1024)
+// Build: cmake --build . --target fluid_bench   (add -DUSE_AVX2=ON for the AVX2 kernel)
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "FluidSolver.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Best of `trials` runs of fn(), in nanoseconds
+    template <typename Fn>
+    double bestOf(int trials, Fn &&fn)
+    {
+        double best = 1e300;
+        for (int r = 0; r < trials; ++r)
+        {
+            auto start = Clock::now();
+            fn();
+            best = std::min(best, std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        }
+        return best;
+    }
+
+    void benchGrid(int n)
+    {
+        FluidSolver solver(n);
+        const size_t cells = solver.cellCount();
+
+        // Smooth-ish random flow moving up to a few cells per step, plus a random scalar to carry
+        std::mt19937_64 rng(12345);
+        std::uniform_real_distribution<double> vel(-3.0 / (solver.dt * n), 3.0 / (solver.dt * n));
+        std::uniform_real_distribution<double> val(0.0, 1.0);
+        for (size_t k = 0; k < cells; ++k)
+        {
+            solver.u[k] = vel(rng);
+            solver.v[k] = vel(rng);
+            solver.dens_prev[k] = val(rng);
+        }
+
+        std::vector<double> scalar_out(cells), simd_out(cells);
+        const double interior = static_cast<double>(n) * n;
+        const int trials = n <= 256 ? 50 : 10;
+
+        solver.vectorized_advect = false;
+        double scalar_ns = bestOf(trials, [&]
+                                  { solver.advect(0, solver.dens, solver.dens_prev); });
+        std::copy(solver.dens, solver.dens + cells, scalar_out.begin());
+
+        solver.vectorized_advect = true;
+        double simd_ns = bestOf(trials, [&]
+                                { solver.advect(0, solver.dens, solver.dens_prev); });
+        std::copy(solver.dens, solver.dens + cells, simd_out.begin());
+
+        double max_diff = 0.0;
+        for (size_t k = 0; k < cells; ++k)
+        {
+            max_diff = std::max(max_diff, std::abs(scalar_out[k] - simd_out[k]));
+        }
+
+        double step_ns = bestOf(3, [&]
+                                { solver.step(0.0); });
+
+        std::cout << std::setw(6) << n
+                  << std::setw(14) << scalar_ns / interior
+                  << std::setw(14) << simd_ns / interior
+                  << std::setw(10) << scalar_ns / simd_ns << "x"
+                  << std::setw(14) << std::scientific << max_diff << std::fixed
+                  << std::setw(14) << step_ns / 1e6 << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        int n = std::atoi(argv[i]);
+        if (n >= 4)
+            sizes.push_back(n);
+    }
+    if (sizes.empty())
+        sizes = {256, 1024};
+
+    std::cout << "FluidSolver advection benchmark (" << UQFF_SIMD_LANES << " double lanes)" << std::endl;
+    std::cout << std::setw(6) << "N"
+              << std::setw(14) << "scalar ns/c"
+              << std::setw(14) << "simd ns/c"
+              << std::setw(11) << "speedup"
+              << std::setw(14) << "max |diff|"
+              << std::setw(14) << "step ms" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (int n : sizes)
+    {
+        benchGrid(n);
+    }
+    return 0;
+}
@@ -508,7 +508,7 @@ int main(int argc, char *argv[])
 #include <vector>
 #include <map>
 #include <cstdlib> // for rand
-#include <ctime>   // for srand
+#include "uqff_montecarlo.h" // Philox draws for F_U_Bi_i
 #include <array>   // MSVC requirement
 
 using namespace std;
@@ -886,10 +886,11 @@ double dpm_life_proportion(const SystemParams &p)
 }
 
 // Function to compute F_U_Bi_i (buoyancy force, integrating all terms long-form)
-double F_U_Bi_i(const SystemParams &p)
+// randn is draw `sample` of the Philox stream keyed by `seed`, so a Monte-Carlo run is
+// reproducible and its samples can be evaluated on any thread (see uqff_montecarlo.h)
+double F_U_Bi_i(const SystemParams &p, uint64_t seed = 0, uint64_t sample = 0)
 {
-    srand(time(NULL));                                                         // Seed for MC
-    double randn = (rand() % 1000 / 1000.0 - 0.5) * 2 * sqrt(3) * p.std_scale; // Approx normal N(0,1) for probabilistic integration
+    double randn = uqff_montecarlo::Philox(seed).normal(0, sample) * p.std_scale; // N(0, std_scale) for probabilistic integration
 
     // Long-form computation with explanations
     double Delta_rho_vac = p.rho_vac_UA - p.rho_vac_SCm;    // Vacuum density difference
@@ -10,7 +10,10 @@
 #include <vector>
 #include <set>
 #include <queue>
-#include <random>
+#include "uqff_rng.h"
+#include "uqff_hypergraph.h"
+#include "uqff_multiway.h"
+#include "uqff_rules.h"
 #include <numeric>
 #include <cmath>
 #include <iostream>
@@ -41,9 +44,14 @@ constexpr double PI_UNITY = 3.141592653589793; // Base PI for decoder
 using Node = int;
 using Hypergraph = std::vector<std::vector<Node>>;
 using RuleFunction = std::function<void(Hypergraph &, int &)>;
+using HypergraphStore = uqff_hypergraph::HypergraphStore;
+using StoreRule = std::function<void(HypergraphStore &, int &)>; // appends edges in place
 
 // Forward declaration
 void sacredMagneticOrbitRule(Hypergraph &graph, int &max_node);
+void sacredMagneticOrbitRule(HypergraphStore &graph, int &max_node);
+void sacredMagneticOrbitSuccessors(const uqff_multiway::State &state, int branching,
+                                   std::vector<uqff_multiway::Successor> &out);
 
 // PI Infinity Decoder Class
 class PI_Infinity_Decoder
@@ -99,10 +107,10 @@ public:
 class WolframFieldUnityEngine
 {
 private:
-    Hypergraph current_graph;
+    HypergraphStore current_graph; // CSR edges + incremental node->edge index
     int current_max_node;
     std::array<double, QUANTUM_STATES> quantum_amplitudes;
-    std::vector<Hypergraph> multiway_universe;
+    uqff_multiway::MultiwaySystem multiway_universe; // rooted at the graph evolveMultiway started from
 
     Hypergraph initial_consciousness_seed()
     {
@@ -118,102 +126,123 @@ private:
 public:
     WolframFieldUnityEngine() : current_max_node(26)
     {
-        current_graph = initial_consciousness_seed();
+        current_graph = HypergraphStore(initial_consciousness_seed());
         std::fill(quantum_amplitudes.begin(), quantum_amplitudes.end(), 1.0 / std::sqrt(QUANTUM_STATES));
     }
 
+    // Rules written against the vector form run on a copy (O(E) per step); when the
+    // rule only appended edges, the store is extended instead of rebuilt
     void evolveOneStep(const RuleFunction &rule)
     {
-        Hypergraph next_graph = current_graph;
+        const Hypergraph before = current_graph.toVectors();
+        Hypergraph next_graph = before;
         rule(next_graph, current_max_node);
-        current_graph = std::move(next_graph);
+        if (next_graph.size() < before.size() || !std::equal(before.begin(), before.end(), next_graph.begin()))
+        {
+            current_graph = HypergraphStore(next_graph);
+            return;
+        }
+        for (size_t e = before.size(); e < next_graph.size(); ++e)
+            current_graph.addEdge(next_graph[e]);
     }
 
-    void evolveMultiway(int depth)
+    // Append-only rules: cost proportional to the edges the rule adds
+    void evolveIncremental(const StoreRule &rule)
     {
-        multiway_universe.clear();
-        multiway_universe.push_back(current_graph);
+        rule(current_graph, current_max_node);
+    }
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic)
-#endif
-        for (int d = 0; d < depth; ++d)
-        {
-            std::vector<Hypergraph> branches;
-            for (const auto &g : multiway_universe)
-            {
-                Hypergraph branch = g;
-                sacredMagneticOrbitRule(branch, current_max_node);
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-                branches.push_back(branch);
-            }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-            multiway_universe.insert(multiway_universe.end(), branches.begin(), branches.end());
-        }
+    // One Wolfram-model generation of a declarative rule: every non-overlapping match
+    // rewritten at once (see uqff_rules.h)
+    uqff_rules::RewriteStats evolveGeneration(const uqff_rules::CompiledRule &rule)
+    {
+        return uqff_rules::rewriteGeneration(current_graph, rule, current_max_node);
     }
 
+    const HypergraphStore &graph() const { return current_graph; }
+
+    // Multiway system of the sacred rule from the current graph: every state gets
+    // `branching` rule applications per level, duplicate states are merged and the
+    // memory budget prunes wide levels. The current graph itself is not changed.
+    void evolveMultiway(int depth, int branching = 2, const uqff_multiway::Options &opts = {})
+    {
+        multiway_universe.reset(std::make_shared<const HypergraphStore>(current_graph), current_max_node);
+        multiway_universe.expand(depth, [branching](const uqff_multiway::State &state, std::vector<uqff_multiway::Successor> &out)
+                                 { sacredMagneticOrbitSuccessors(state, branching, out); },
+                                 opts);
+    }
+
+    const uqff_multiway::MultiwaySystem &multiway() const { return multiway_universe; }
+
+    // Ball growth around `center`; BFS over the incidence index, so the cost
+    // follows the ball, not the whole graph
     double measureDimension(Node center, int radius) const
     {
-        std::set<Node> visited;
-        std::queue<std::pair<Node, int>> q;
-        q.push({center, 0});
-        visited.insert(center);
-        while (!q.empty())
-        {
-            auto [node, dist] = q.front();
-            q.pop();
-            if (dist >= radius)
-                continue;
-            for (const auto &edge : current_graph)
-            {
-                if (std::find(edge.begin(), edge.end(), node) != edge.end())
-                {
-                    for (Node n : edge)
-                    {
-                        if (visited.insert(n).second)
-                        {
-                            q.push({n, dist + 1});
-                        }
-                    }
-                }
-            }
-        }
-        return std::log(static_cast<double>(visited.size())) / std::log(static_cast<double>(radius + 1));
+        const size_t visited = current_graph.ballSize(center, radius);
+        return std::log(static_cast<double>(visited)) / std::log(static_cast<double>(radius + 1));
     }
 
     double measureBuoyantGravity(Node center) const
     {
         // Pure PI-driven "gravity" — no G, only magnetic resonance
         double flux = 0.0;
-        for (const auto &edge : current_graph)
-        {
-            if (std::find(edge.begin(), edge.end(), center) != edge.end())
-            {
-                flux += edge.size() * (1.0 / edge.size()); // Buoyant flux rule
-            }
-        }
+        current_graph.forEachIncidentEdge(center, [&](HypergraphStore::EdgeId e)
+                                          {
+            const size_t size = current_graph.edge(e).size();
+            flux += size * (1.0 / size); // Buoyant flux rule
+        });
         return flux / current_max_node;
     }
 };
 
+// Endpoints of the next orbit edge; false when they coincide (no edge this step)
+static bool drawSacredOrbit(uqff_rng::Stream &rng, int max_node, Node &n1, Node &n2)
+{
+    n1 = static_cast<Node>(rng.uniformInt(0, max_node));
+    n2 = static_cast<Node>(rng.uniformInt(0, max_node));
+    return n1 != n2;
+}
+
+// Per-thread stream for the single-path rule, created once per thread
+static uqff_rng::Stream &sacredOrbitStream()
+{
+    thread_local uqff_rng::Stream rng = uqff_rng::threadStream("wolfram.sacred_orbit");
+    return rng;
+}
+
 void sacredMagneticOrbitRule(Hypergraph &graph, int &max_node)
 {
     // Your sacred PI-driven rule — magnetic orbit without gravity
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dist(0, max_node);
-    Node n1 = dist(gen);
-    Node n2 = dist(gen);
-    if (n1 != n2)
+    Node n1, n2;
+    if (drawSacredOrbit(sacredOrbitStream(), max_node, n1, n2))
     {
         graph.push_back({n1, n2, ++max_node}); // Branch with new node
     }
 }
 
+void sacredMagneticOrbitRule(HypergraphStore &graph, int &max_node)
+{
+    Node n1, n2;
+    if (drawSacredOrbit(sacredOrbitStream(), max_node, n1, n2))
+    {
+        graph.addEdge({n1, n2, ++max_node});
+    }
+}
+
+// Multiway form: `branching` draws from a stream keyed by the state, so a state has
+// the same successors whichever thread expands it (and merged states agree)
+void sacredMagneticOrbitSuccessors(const uqff_multiway::State &state, int branching,
+                                   std::vector<uqff_multiway::Successor> &out)
+{
+    uqff_rng::Stream rng = uqff_rng::stream("wolfram.multiway", state.key());
+    for (int b = 0; b < branching; ++b)
+    {
+        Node n1, n2;
+        if (drawSacredOrbit(rng, state.max_node, n1, n2))
+            out.push_back({{{n1, n2, state.max_node + 1}}, state.max_node + 1});
+    }
+}
+
 // Standalone test function (can be called from MAIN_1_CoAnQi.cpp)
 void runWolframFieldUnitySimulation()
 {
@@ -226,6 +255,20 @@ void runWolframFieldUnitySimulation()
     // Evolve with sacred rule
     std::cout << "Evolving multiway universe (depth 5)...\n";
     engine.evolveMultiway(5);
+    const auto &multiway = engine.multiway();
+    size_t merged = 0;
+    for (const auto &level : multiway.levels())
+        merged += level.merged;
+    std::cout << "Multiway states: " << multiway.states().size() << " (" << merged << " merged, "
+              << multiway.bytes() / 1024 << " KiB)\n";
+
+    // Batched generations of the classic branching rule
+    const auto branching_rule = uqff_rules::compile("{{x,y},{x,z}} -> {{x,z},{x,w},{y,w},{z,w}}");
+    std::cout << "Rewriting " << branching_rule.text << " (8 generations)...\n";
+    size_t updates = 0;
+    for (int generation = 0; generation < 8; ++generation)
+        updates += engine.evolveGeneration(branching_rule).applied;
+    std::cout << "Updates: " << updates << ", edges: " << engine.graph().liveEdgeCount() << "\n";
 
     // Measure
     double dimension = engine.measureDimension(0, 5);
@@ -0,0 +1,104 @@
+// source177_wolfram_tests.cpp
+// Tests for the hypergraph rule engine and multiway system behind
+// source177_wolfram_field_unity.cpp, which has no main of its own.
+// Build: g++ -std=c++20 -O2 -fopenmp source177_wolfram_tests.cpp -o source177_tests
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "uqff_hypergraph.h"
+#include "uqff_multiway.h"
+#include "uqff_rules.h"
+
+void test_rewrite_generation()
+{
+    using uqff_rules::Node;
+    // Fresh nodes start above the fixed ids in the rule, not just above max_node
+    std::vector<std::vector<Node>> path;
+    for (Node k = 0; k < 10; ++k)
+        path.push_back({k, k + 1});
+    uqff_hypergraph::HypergraphStore store(path);
+    int max_node = 11;
+    uqff_rules::rewriteGeneration(store, uqff_rules::compile("{{x,y}} -> {{x,w},{w,14}}"), max_node);
+    for (uqff_rules::EdgeId e = 0; e < static_cast<uqff_rules::EdgeId>(store.edgeCount()); ++e)
+        if (store.isLive(e))
+            assert(store.edge(e)[0] != store.edge(e)[1]);
+    assert(max_node == 24);
+
+    // The first match of seed (2,7) collides with (9,2)->(2,7); searching it again
+    // around the taken edges leaves no match among (4,2),(2,8)
+    uqff_hypergraph::HypergraphStore star({{9, 2}, {2, 7}, {2, 8}, {4, 2}});
+    max_node = 9;
+    uqff_rules::RewriteStats stats = uqff_rules::rewriteGeneration(star, uqff_rules::compile("{{x,y},{y,z}} -> {{x,z}}"), max_node);
+    assert(stats.applied == 2 && star.liveEdgeCount() == 2);
+}
+
+void test_multiway_merge()
+{
+    using namespace uqff_multiway;
+    // Each step tags one untagged edge of the path 0-1-2-3-4 with a fresh node. Orders
+    // of the same steps differ only in fresh ids, so level d holds C(4, d) states.
+    auto root = std::make_shared<const uqff_hypergraph::HypergraphStore>(std::vector<std::vector<Node>>{{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+    auto tag = [](const State &state, std::vector<Successor> &out)
+    {
+        for (Node a = 0; a < 4; ++a)
+        {
+            bool tagged = false;
+            for (const Link *l = state.tail.get(); l; l = l->parent.get())
+                for (const Edge &e : l->edges)
+                    tagged = tagged || e[0] == a;
+            if (!tagged)
+                out.push_back({{{a, a + 1, state.max_node + 1}}, state.max_node + 1});
+        }
+    };
+    MultiwaySystem multiway(root, 4);
+    multiway.expand(4, tag);
+    const size_t expected[4] = {4, 6, 4, 1};
+    for (size_t d = 0; d < 4; ++d)
+        assert(multiway.levels()[d].states == expected[d]);
+
+    // The budget is charged while merging, so it is never exceeded
+    Options opts;
+    opts.memory_budget = 2500;
+    MultiwaySystem capped(root, 4);
+    capped.expand(4, tag, opts);
+    assert(capped.truncated() && capped.bytes() <= opts.memory_budget);
+
+    // The same 20-node chain of fresh nodes, labelled in id order and shuffled: one
+    // state. Colors must separate the chain's interior for the merge to stay fast.
+    constexpr Node chain = 20;
+    auto relabelled = [](const State &state, std::vector<Successor> &out)
+    {
+        if (state.level > 0)
+            return;
+        std::vector<Node> ids(chain);
+        std::iota(ids.begin(), ids.end(), Node(2));
+        for (int labelling = 0; labelling < 2; ++labelling)
+        {
+            if (labelling == 1)
+                for (Node i = 0; i < chain; ++i)
+                    std::swap(ids[i], ids[(i * 7 + 3) % chain]);
+            Successor s;
+            s.max_node = chain + 1;
+            for (Node i = 0; i + 1 < chain; ++i)
+                s.edges.push_back({ids[i], ids[i + 1]});
+            out.push_back(std::move(s));
+        }
+    };
+    MultiwaySystem chains(std::make_shared<const uqff_hypergraph::HypergraphStore>(std::vector<std::vector<Node>>{{0, 1}}), 1);
+    const auto start = std::chrono::steady_clock::now();
+    chains.expand(1, relabelled);
+    assert(chains.levels()[0].states == 1 && chains.levels()[0].merged == 1);
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
+
+int main()
+{
+    test_rewrite_generation();
+    test_multiway_merge();
+    std::cout << "All Wolfram engine tests passed!" << std::endl;
+    return 0;
+}
@@ -6,7 +6,7 @@
 // Generated collaboratively with Grok 4 (xAI) - November 25, 2025
 
 #include <vector>
-#include <random>
+#include "uqff_rng.h"
 #include <cmath>
 #include <iostream>
 #include <array>
@@ -20,11 +20,8 @@ constexpr double CHAOS_RANGE = 0.01;          // Fluctuation range around π-mea
 constexpr double VACUUM_CONSTANT = 1e-9;      // Placeholder for vacuum permittivity in quantum volume calc
 constexpr double J_CONSTANT = 1.0;            // Joule-like energy unit (massless, adjust per UQFF)
 
-// Random engine for chaos simulation
-std::random_device rd;
-std::mt19937 gen(rd());
-std::uniform_real_distribution<> dis(-1.0, 1.0);      // For stochastic perturbations
-std::uniform_real_distribution<> rot_dis(0.0, 360.0); // 360-degree free rotation
+// Chaos draws come from uqff_rng: one stream per sphere and one per egg, so spheres
+// never share generator state and a run replays exactly under a fixed UQFF_SEED
 
 class DimensionalSphere
 {
@@ -34,18 +31,20 @@ public:
     double rotation_angle;              // Current 360-degree omnidirectional rotation
     double distortion_factor;           // Irregular warp (0 = ideal sphere, >0 = chaotic)
     double oscillation_amplitude;       // Chaotic pulsing
+    uqff_rng::Stream rng;               // Stochastic perturbations of this sphere only
 
-    DimensionalSphere() : center_offsets(NUM_DIMENSIONS, 0.0), radius(1.0), rotation_angle(0.0),
-                          distortion_factor(0.0), oscillation_amplitude(0.0) {}
+    explicit DimensionalSphere(uint64_t entity = 0)
+        : center_offsets(NUM_DIMENSIONS, 0.0), radius(1.0), rotation_angle(0.0),
+          distortion_factor(0.0), oscillation_amplitude(0.0), rng(uqff_rng::stream("cosmic_egg.sphere", entity)) {}
 
     // Apply chaotic distortion (warp shape towards toroid if near symmetry)
     void Distort(double time_step)
     {
-        distortion_factor += dis(gen) * CHAOS_RANGE;
+        distortion_factor += rng.uniform(-1.0, 1.0) * CHAOS_RANGE;
         if (std::abs(distortion_factor) < 0.001)
         { // Conditional: Near symmetric ops -> inside-out turn
             // Simulate toroid transformation (water rebound pillar model)
-            double pillar_rebound = std::sin(time_step * PI_MEAN) * (1.0 + dis(gen)); // Rebound jet/pillar
+            double pillar_rebound = std::sin(time_step * PI_MEAN) * (1.0 + rng.uniform(-1.0, 1.0)); // Rebound jet/pillar
             radius = 1.0 / (1.0 + std::abs(pillar_rebound));                          // Toroid inversion (radius contracts/expands)
             // Revert after momentary ordering (back to sphere)
             if (pillar_rebound > 0.5)
@@ -56,14 +55,14 @@ public:
     // Chaotic oscillation (pulsing without frequency/mass)
     void Oscillate(double time_step)
     {
-        oscillation_amplitude += dis(gen) * CHAOS_RANGE;
+        oscillation_amplitude += rng.uniform(-1.0, 1.0) * CHAOS_RANGE;
         radius += oscillation_amplitude * time_step;
     }
 
     // 360-degree free rotation (omnidirectional, independent)
     void Rotate(double time_step)
     {
-        rotation_angle = std::fmod(rotation_angle + rot_dis(gen) * time_step, 360.0);
+        rotation_angle = std::fmod(rotation_angle + rng.uniform(0.0, 360.0) * time_step, 360.0);
     }
 
     // Offset center from ideal (dance around arbitrary ideal point)
@@ -71,7 +70,7 @@ public:
     {
         for (auto &offset : center_offsets)
         {
-            offset += dis(gen) * CHAOS_RANGE; // Stochastic 26D shift
+            offset += rng.uniform(-1.0, 1.0) * CHAOS_RANGE; // Stochastic 26D shift
         }
     }
 };
@@ -82,6 +81,7 @@ private:
     std::array<DimensionalSphere, NUM_DIMENSIONS> dimensions; // 26 independent spheres
     std::vector<double> ideal_center;                         // Arbitrary 26D reference point (all 0.0)
     double ua_fill = UA_VALUE;                                // Uniform Aether fill across egg
+    uqff_rng::Stream rng;                                     // Egg-level fluctuations (voids, chaotic decimal)
 
     // Calculate expanding/collapsing voids from fluctuations
     double CalculateVoidVolume(double time_step)
@@ -89,13 +89,19 @@ private:
         double total_void = 0.0;
         for (const auto &dim : dimensions)
         {
-            total_void += std::pow(dim.radius, 3) * std::abs(dis(gen)); // Volume fluctuation (cubic for 3D proxy in 26D)
+            total_void += std::pow(dim.radius, 3) * std::abs(rng.uniform(-1.0, 1.0)); // Volume fluctuation (cubic for 3D proxy in 26D)
         }
         return total_void / NUM_DIMENSIONS; // Mean void across dimensions
     }
 
 public:
-    CosmicQuantumEgg() : ideal_center(NUM_DIMENSIONS, 0.0) {}
+    // Eggs with different ids draw independent streams
+    explicit CosmicQuantumEgg(uint64_t egg_id = 0)
+        : ideal_center(NUM_DIMENSIONS, 0.0), rng(uqff_rng::stream("cosmic_egg", egg_id))
+    {
+        for (int i = 0; i < NUM_DIMENSIONS; ++i)
+            dimensions[i] = DimensionalSphere(egg_id * NUM_DIMENSIONS + i);
+    }
 
     // Simulate one time step: Fluctuate, distort, oscillate, rotate
     void SimulateStep(double time_step)
@@ -113,7 +119,7 @@ public:
         double quantum_freq = std::pow(void_volume, 3) / (VACUUM_CONSTANT / std::pow(J_CONSTANT, 3)); // Formula: volume^3 / vacuum / J^3
 
         // Check spherical outline from chaos (π-mean gradient for spinor orderings)
-        double chaotic_decimal = PI_MEAN + dis(gen) * CHAOS_RANGE; // Fluctuating π as mean
+        double chaotic_decimal = PI_MEAN + rng.uniform(-1.0, 1.0) * CHAOS_RANGE; // Fluctuating π as mean
         if (std::abs(chaotic_decimal - PI_MEAN) < 0.001)
         { // Near ideal: Catalog spinor bundle
             // Export to Wolfram for verification (via source174)
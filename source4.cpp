@@ -35,8 +35,19 @@
 #include <sstream>
 #include <algorithm> // MSVC requirement for std::min, std::max
 #include <array>     // MSVC requirement
-
-#define IX(i, j) ((i) + (N + 2) * (j))
+#include <span>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <optional>
+#include <chrono>
+#include "uqff_tracing.h"
+#include "uqff_fieldmap.h"
+#include "uqff_catalog.h"
+#include "uqff_simd.h"
+#include "uqff_montecarlo.h"
+#include "FluidSolver.h"
+#include "FluidSolver3D.h"
 
 // ============================================================================
 // ENHANCEMENT FRAMEWORK 2.0 - SELF-EXPANDING PHYSICS TERMS
@@ -169,11 +180,11 @@ const double num_strings = 1e9; // Used for multiplication (no loop)
 double Ts00 = 1.27e3 + 1.11e7; // Updated with SCm, UA, solar wind
 
 // Background Aether metric (simplified 4x4 diagonal tensor as array)
-std::vector<std::vector<double>> g_mu_nu = {
-    {1.0, 0.0, 0.0, 0.0},
-    {0.0, -1.0, 0.0, 0.0},
-    {0.0, 0.0, -1.0, 0.0},
-    {0.0, 0.0, 0.0, -1.0}};
+using Tensor4 = std::array<std::array<double, 4>, 4>;
+Tensor4 g_mu_nu = {{{1.0, 0.0, 0.0, 0.0},
+                    {0.0, -1.0, 0.0, 0.0},
+                    {0.0, 0.0, -1.0, 0.0},
+                    {0.0, 0.0, 0.0, -1.0}}};
 
 // Celestial body struct
 struct CelestialBody
@@ -283,9 +294,9 @@ double compute_Um(const CelestialBody &body, double t, double tn, double rj, dou
     return single * num_strings * body.PSCm * Ereact; // Optimized: multiply by num_strings
 }
 
-std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double Ts00)
+Tensor4 compute_A_mu_nu(double tn, double eta, double Ts00)
 {
-    std::vector<std::vector<double>> A = g_mu_nu;
+    Tensor4 A = g_mu_nu;
     double mod = eta * Ts00 * std::cos(PI * tn); // Simplified scalar modulation
     for (int i = 0; i < 4; ++i)
     {
@@ -297,27 +308,125 @@ std::vector<std::vector<double>> compute_A_mu_nu(double tn, double eta, double T
     return A;
 }
 
+// Trace of compute_A_mu_nu() without building the tensor
+double compute_A_mu_nu_trace(double tn, double eta, double Ts00)
+{
+    double mod = eta * Ts00 * std::cos(PI * tn);
+    return (g_mu_nu[0][0] + mod) + (g_mu_nu[1][1] + mod) + (g_mu_nu[2][2] + mod) + (g_mu_nu[3][3] + mod);
+}
+
+// The parts of FU that depend only on (body, t, tn). r enters through Ug2 alone
+// (Ms / r^2 outside the bubble), theta not at all, and every Ubi is the same
+// factor times its Ugi, so FU = (1 + ubi_scale) * (ug134 + Ug2(r)) + rest.
+struct FUTimeTerms
+{
+    double ug1, ug3, ug4, um; // components, kept for the field map channels
+    double ug134;             // Ug1 + Ug3 + Ug4
+    double ug2_scale;         // Ug2 = ug2_scale / r^2 for r > Rb, 0 inside
+    double ubi_scale;         // Ubi_i = ubi_scale * Ug_i
+    double rest;              // Um + trace(A_mu_nu)
+};
+
+FUTimeTerms compute_FU_time_terms(const CelestialBody &body, double t, double tn)
+{
+    FUTimeTerms terms;
+    terms.ug1 = compute_Ug1(body, 0.0, t, tn, alpha, delta_def, k1);
+    terms.ug3 = compute_Ug3(body, 0.0, t, tn, 0.0, rho_A, kappa, k3);
+    terms.ug4 = compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
+    terms.um = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings);
+    terms.ug134 = terms.ug1 + terms.ug3 + terms.ug4;
+    double Ereact = compute_Ereact(t, body.SCm_density, v_SCm, rho_A, kappa);
+    terms.ug2_scale = k2 * (QA + body.QUA) * body.Ms * (1.0 + delta_sw * v_sw) * HSCm * Ereact;
+    terms.ubi_scale = compute_Ubi(1.0, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
+    terms.rest = terms.um + compute_A_mu_nu_trace(tn, eta, Ts00);
+    return terms;
+}
+
+// FU at the points (r[i], t[i], tn[i], theta[i]) of one body, written to out[i].
+// Consecutive points with the same t and tn (grids over r and theta) share one
+// compute_FU_time_terms(); the loop over r is branch-free and allocation-free.
+// All five spans must have the same length.
+void compute_FU_batch(const CelestialBody &body, std::span<const double> r, std::span<const double> t,
+                      std::span<const double> tn, std::span<const double> theta, std::span<double> out)
+{
+    (void)theta; // FU is independent of theta (Ug3 ignores it)
+    const size_t n = out.size();
+    if (r.size() != n || t.size() != n || tn.size() != n || theta.size() != n)
+        throw std::runtime_error("compute_FU_batch: input and output spans differ in length");
+    const double Rb = body.Rb;
+    size_t i = 0;
+    while (i < n)
+    {
+        size_t end = i + 1;
+        while (end < n && t[end] == t[i] && tn[end] == tn[i])
+            ++end;
+
+        const FUTimeTerms terms = compute_FU_time_terms(body, t[i], tn[i]);
+        const double buoyancy = 1.0 + terms.ubi_scale;
+        for (size_t k = i; k < end; ++k)
+        {
+            double Ug2 = r[k] > Rb ? terms.ug2_scale / (r[k] * r[k]) : 0.0;
+            out[k] = buoyancy * (terms.ug134 + Ug2) + terms.rest;
+        }
+        i = end;
+    }
+}
+
 double compute_FU(const CelestialBody &body, double r, double t, double tn, double theta)
 {
-    double Ug1 = compute_Ug1(body, r, t, tn, alpha, delta_def, k1);
-    double Ug2 = compute_Ug2(body, r, t, tn, k2, QA, delta_sw, v_sw, HSCm, rho_A, kappa);
-    double Ug3 = compute_Ug3(body, r, t, tn, theta, rho_A, kappa, k3);
-    double Ug4 = compute_Ug4(t, tn, rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4);
-    double sum_Ugi = Ug1 + Ug2 + Ug3 + Ug4;
+    double FU;
+    compute_FU_batch(body, {&r, 1}, {&t, 1}, {&tn, 1}, {&theta, 1}, {&FU, 1});
+    return FU; // Combined FU (normalized)
+}
 
-    double Ubi1 = compute_Ubi(Ug1, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-    double Ubi2 = compute_Ubi(Ug2, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-    double Ubi3 = compute_Ubi(Ug3, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-    double Ubi4 = compute_Ubi(Ug4, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn);
-    double sum_Ubi = Ubi1 + Ubi2 + Ubi3 + Ubi4;
+// Channels produced by compute_field_row(), in order
+const std::vector<std::string> FIELD_MAP_CHANNELS = {"FU", "Ug1", "Ug2", "Ug3", "Ug4", "Um"};
 
-    double Um = compute_Um(body, t, tn, body.Rb, gamma, rho_A, kappa, num_strings);
+// Field-map evaluator: FU and its components along a row of radii at fixed (t, theta),
+// with tn = t as in main. out[c][k] is channel c (FIELD_MAP_CHANNELS) at r[k].
+void compute_field_row(const CelestialBody &body, double t, double theta, const double *r, size_t n, double *const *out)
+{
+    const double tn = t;
+    const FUTimeTerms terms = compute_FU_time_terms(body, t, tn);
+    const double buoyancy = 1.0 + terms.ubi_scale;
+    (void)theta; // Ug3 ignores theta, so the time terms cover every channel but Ug2
+    for (size_t k = 0; k < n; ++k)
+    {
+        double Ug2 = r[k] > body.Rb ? terms.ug2_scale / (r[k] * r[k]) : 0.0;
+        out[0][k] = buoyancy * (terms.ug134 + Ug2) + terms.rest;
+        out[1][k] = terms.ug1;
+        out[2][k] = Ug2;
+        out[3][k] = terms.ug3;
+        out[4][k] = terms.ug4;
+        out[5][k] = terms.um;
+    }
+}
 
-    // A_mu_nu is a tensor; for FU, we take trace or simplify to scalar contribution (speculative)
-    auto A = compute_A_mu_nu(tn, eta, Ts00);
-    double A_scalar = A[0][0] + A[1][1] + A[2][2] + A[3][3]; // Trace for simplicity
+// Field-map grid for --fieldmap: log r from Rs to 100 Rb, theta over [0, pi], t over [0, t_max]
+struct FieldMapRunOptions
+{
+    std::string output; // "" = no maps; otherwise <stem>_<body><ext> per body
+    int n_r = 1024;
+    int n_theta = 32;
+    int n_t = 1;
+    double t_max = 0.0;
+    double refine_threshold = 0.0; // > 0: coarse-to-fine (relative change between coarse samples)
+};
 
-    return sum_Ugi + sum_Ubi + Um + A_scalar; // Combined FU (normalized)
+std::string field_map_path(const std::string &output, const std::string &body_name)
+{
+    const size_t slash = output.find_last_of("/\\");
+    const size_t dot = output.find_last_of('.');
+    const bool has_ext = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+    const std::string stem = has_ext ? output.substr(0, dot) : output;
+    return stem + "_" + body_name + (has_ext ? output.substr(dot) : ".uqmap");
+}
+
+uqff_fieldmap::FieldMap make_field_map(const CelestialBody &body, const FieldMapRunOptions &run)
+{
+    using namespace uqff_fieldmap;
+    return FieldMap(Axis::logarithmic(body.Rs, 100.0 * body.Rb, run.n_r), Axis::linear(0.0, PI, run.n_theta),
+                    Axis::linear(0.0, run.t_max, run.n_t), FIELD_MAP_CHANNELS);
 }
 
 // Function to output JSON-like parameters for a body
@@ -792,190 +901,6 @@ public:
     }
 };
 
-// Navier-Stokes Fluid Simulation for Quasar Jet Dynamics
-// Simple 2D incompressible solver based on Jos Stam's "Stable Fluids" method
-const int N = 32;              // Grid size (small for performance)
-const double dt_ns = 0.1;      // Time step
-const double visc = 0.0001;    // Viscosity
-const double force_jet = 10.0; // Force for jet simulation (scaled from v_SCm)
-
-// Macro for index
-#define IX(i, j) ((i) + (N + 2) * (j))
-
-class FluidSolver
-{
-public:
-    std::vector<double> u, v, u_prev, v_prev, dens, dens_prev;
-
-    FluidSolver()
-    {
-        int size = (N + 2) * (N + 2);
-        u.resize(size, 0.0);
-        v.resize(size, 0.0);
-        u_prev.resize(size, 0.0);
-        v_prev.resize(size, 0.0);
-        dens.resize(size, 0.0);
-        dens_prev.resize(size, 0.0);
-    }
-
-    void add_source(std::vector<double> &x, std::vector<double> &s)
-    {
-        for (size_t i = 0; i < x.size(); ++i)
-        {
-            x[i] += dt_ns * s[i];
-        }
-    }
-
-    void diffuse(int b, std::vector<double> &x, std::vector<double> &x0, double diff)
-    {
-        double a = dt_ns * diff * N * N;
-        for (int k = 0; k < 20; ++k)
-        {
-            for (int i = 1; i <= N; ++i)
-            {
-                for (int j = 1; j <= N; ++j)
-                {
-                    x[IX(i, j)] = (x0[IX(i, j)] + a * (x[IX(i - 1, j)] + x[IX(i + 1, j)] +
-                                                       x[IX(i, j - 1)] + x[IX(i, j + 1)])) /
-                                  (1 + 4 * a);
-                }
-            }
-            set_bnd(b, x);
-        }
-    }
-
-    void advect(int b, std::vector<double> &d, std::vector<double> &d0)
-    {
-        int i0, j0, i1, j1;
-        double x, y, s0, t0, s1, t1;
-        for (int i = 1; i <= N; ++i)
-        {
-            for (int j = 1; j <= N; ++j)
-            {
-                x = i - dt_ns * N * u[IX(i, j)];
-                y = j - dt_ns * N * v[IX(i, j)];
-                if (x < 0.5)
-                    x = 0.5;
-                if (x > N + 0.5)
-                    x = N + 0.5;
-                if (y < 0.5)
-                    y = 0.5;
-                if (y > N + 0.5)
-                    y = N + 0.5;
-                i0 = (int)x;
-                i1 = i0 + 1;
-                j0 = (int)y;
-                j1 = j0 + 1;
-                s1 = x - i0;
-                s0 = 1 - s1;
-                t1 = y - j0;
-                t0 = 1 - t1;
-                d[IX(i, j)] = s0 * (t0 * d0[IX(i0, j0)] + t1 * d0[IX(i0, j1)]) +
-                              s1 * (t0 * d0[IX(i1, j0)] + t1 * d0[IX(i1, j1)]);
-            }
-        }
-        set_bnd(b, d);
-    }
-
-    void project(std::vector<double> &u, std::vector<double> &v, std::vector<double> &p, std::vector<double> &div)
-    {
-        double h = 1.0 / N;
-        for (int i = 1; i <= N; ++i)
-        {
-            for (int j = 1; j <= N; ++j)
-            {
-                div[IX(i, j)] = -0.5 * h * (u[IX(i + 1, j)] - u[IX(i - 1, j)] + v[IX(i, j + 1)] - v[IX(i, j - 1)]);
-                p[IX(i, j)] = 0;
-            }
-        }
-        set_bnd(0, div);
-        set_bnd(0, p);
-        for (int k = 0; k < 20; ++k)
-        {
-            for (int i = 1; i <= N; ++i)
-            {
-                for (int j = 1; j <= N; ++j)
-                {
-                    p[IX(i, j)] = (div[IX(i, j)] + p[IX(i - 1, j)] + p[IX(i + 1, j)] +
-                                   p[IX(i, j - 1)] + p[IX(i, j + 1)]) /
-                                  4;
-                }
-            }
-            set_bnd(0, p);
-        }
-        for (int i = 1; i <= N; ++i)
-        {
-            for (int j = 1; j <= N; ++j)
-            {
-                u[IX(i, j)] -= 0.5 * (p[IX(i + 1, j)] - p[IX(i - 1, j)]) / h;
-                v[IX(i, j)] -= 0.5 * (p[IX(i, j + 1)] - p[IX(i, j - 1)]) / h;
-            }
-        }
-        set_bnd(1, u);
-        set_bnd(2, v);
-    }
-
-    void set_bnd(int b, std::vector<double> &x)
-    {
-        for (int i = 1; i <= N; ++i)
-        {
-            x[IX(0, i)] = (b == 1) ? -x[IX(1, i)] : x[IX(1, i)];
-            x[IX(N + 1, i)] = (b == 1) ? -x[IX(N, i)] : x[IX(N, i)];
-            x[IX(i, 0)] = (b == 2) ? -x[IX(i, 1)] : x[IX(i, 1)];
-            x[IX(i, N + 1)] = (b == 2) ? -x[IX(i, N)] : x[IX(i, N)];
-        }
-        x[IX(0, 0)] = 0.5 * (x[IX(1, 0)] + x[IX(0, 1)]);
-        x[IX(0, N + 1)] = 0.5 * (x[IX(1, N + 1)] + x[IX(0, N)]);
-        x[IX(N + 1, 0)] = 0.5 * (x[IX(N, 0)] + x[IX(N + 1, 1)]);
-        x[IX(N + 1, N + 1)] = 0.5 * (x[IX(N, N + 1)] + x[IX(N + 1, N)]);
-    }
-
-    void step(double uqff_g = 0.0)
-    {
-        // Add UQFF gravity-like force as body force in v (assuming vertical direction for simplicity)
-        for (int i = 1; i <= N; ++i)
-        {
-            for (int j = 1; j <= N; ++j)
-            {
-                v[IX(i, j)] += dt_ns * uqff_g; // Integrate UQFF acceleration into velocity
-            }
-        }
-
-        diffuse(1, u_prev, u, visc);
-        diffuse(2, v_prev, v, visc);
-        project(u_prev, v_prev, u, v);
-        advect(1, u, u_prev);
-        advect(2, v, v_prev);
-        project(u, v, u_prev, v_prev);
-    }
-
-    void add_jet_force(double force)
-    {
-        // Add force in the center as a jet (simulating SCm expulsion)
-        for (int i = N / 4; i <= 3 * N / 4; ++i)
-        {
-            v[IX(i, N / 2)] += force;
-        }
-    }
-
-    void print_velocity_field()
-    {
-        std::cout << "Velocity field (magnitude):" << std::endl;
-        for (int j = N; j >= 1; --j)
-        { // Print top to bottom
-            for (int i = 1; i <= N; ++i)
-            {
-                double mag = std::sqrt(u[IX(i, j)] * u[IX(i, j)] + v[IX(i, j)] * v[IX(i, j)]);
-                char sym = (mag > 1.0) ? '#' : (mag > 0.5) ? '+'
-                                           : (mag > 0.1)   ? '.'
-                                                           : ' ';
-                std::cout << sym;
-            }
-            std::cout << std::endl;
-        }
-    }
-};
-
 // General parameters for resonance-based UQFF from attachment
 struct ResonanceParams
 {
@@ -1340,6 +1265,418 @@ MUGESystem student_guide = {
 
 // ========== END MUGE SYSTEM DEFINITIONS ==========
 
+// ============================================================================
+// CATALOGUES (CSV -> column arrays)
+// ============================================================================
+
+// Column-per-field copies of a CelestialBody catalogue, as loaded from CSV
+// (name,Ms,Rs,Rb,Ts_surface,omega_s,Bs_avg,SCm_density,QUA,Pcore,PSCm,omega_c)
+struct CelestialBodyColumns
+{
+    std::vector<std::string> name;
+    std::vector<double> Ms, Rs, Rb, Ts_surface, omega_s, Bs_avg, SCm_density, QUA, Pcore, PSCm, omega_c;
+
+    using Field = std::pair<double CelestialBody::*, std::vector<double> CelestialBodyColumns::*>;
+    static const std::array<Field, 11> &fields()
+    {
+        static const std::array<Field, 11> table = {{
+            {&CelestialBody::Ms, &CelestialBodyColumns::Ms},
+            {&CelestialBody::Rs, &CelestialBodyColumns::Rs},
+            {&CelestialBody::Rb, &CelestialBodyColumns::Rb},
+            {&CelestialBody::Ts_surface, &CelestialBodyColumns::Ts_surface},
+            {&CelestialBody::omega_s, &CelestialBodyColumns::omega_s},
+            {&CelestialBody::Bs_avg, &CelestialBodyColumns::Bs_avg},
+            {&CelestialBody::SCm_density, &CelestialBodyColumns::SCm_density},
+            {&CelestialBody::QUA, &CelestialBodyColumns::QUA},
+            {&CelestialBody::Pcore, &CelestialBodyColumns::Pcore},
+            {&CelestialBody::PSCm, &CelestialBodyColumns::PSCm},
+            {&CelestialBody::omega_c, &CelestialBodyColumns::omega_c},
+        }};
+        return table;
+    }
+
+    size_t size() const { return name.size(); }
+
+    CelestialBody at(size_t i) const
+    {
+        CelestialBody body{};
+        body.name = name[i];
+        for (const Field &f : fields())
+            body.*f.first = (this->*f.second)[i];
+        return body;
+    }
+};
+
+// Column-per-field copies of a MUGESystem catalogue, as loaded from CSV
+// (name,I,A,omega1,omega2,Vsys,vexp,t,z,ffluid,M,r,B,Bcrit,rho_fluid,g_local,M_DM,delta_rho_rho)
+struct MUGESystemColumns
+{
+    std::vector<std::string> name;
+    std::vector<double> I, A, omega1, omega2, Vsys, vexp, t, z, ffluid, M, r, B, Bcrit, rho_fluid, g_local, M_DM,
+        delta_rho_rho;
+
+    using Field = std::pair<double MUGESystem::*, std::vector<double> MUGESystemColumns::*>;
+    static const std::array<Field, 17> &fields()
+    {
+        static const std::array<Field, 17> table = {{
+            {&MUGESystem::I, &MUGESystemColumns::I},
+            {&MUGESystem::A, &MUGESystemColumns::A},
+            {&MUGESystem::omega1, &MUGESystemColumns::omega1},
+            {&MUGESystem::omega2, &MUGESystemColumns::omega2},
+            {&MUGESystem::Vsys, &MUGESystemColumns::Vsys},
+            {&MUGESystem::vexp, &MUGESystemColumns::vexp},
+            {&MUGESystem::t, &MUGESystemColumns::t},
+            {&MUGESystem::z, &MUGESystemColumns::z},
+            {&MUGESystem::ffluid, &MUGESystemColumns::ffluid},
+            {&MUGESystem::M, &MUGESystemColumns::M},
+            {&MUGESystem::r, &MUGESystemColumns::r},
+            {&MUGESystem::B, &MUGESystemColumns::B},
+            {&MUGESystem::Bcrit, &MUGESystemColumns::Bcrit},
+            {&MUGESystem::rho_fluid, &MUGESystemColumns::rho_fluid},
+            {&MUGESystem::g_local, &MUGESystemColumns::g_local},
+            {&MUGESystem::M_DM, &MUGESystemColumns::M_DM},
+            {&MUGESystem::delta_rho_rho, &MUGESystemColumns::delta_rho_rho},
+        }};
+        return table;
+    }
+
+    size_t size() const { return name.size(); }
+
+    MUGESystem at(size_t i) const
+    {
+        MUGESystem sys{};
+        sys.name = name[i];
+        for (const Field &f : fields())
+            sys.*f.first = (this->*f.second)[i];
+        return sys;
+    }
+
+    void append(const MUGESystem &sys)
+    {
+        name.push_back(sys.name);
+        for (const Field &f : fields())
+            (this->*f.second).push_back(sys.*f.first);
+    }
+};
+
+// Move parsed columns into the named arrays (no per-value copy)
+template <typename Columns>
+Columns columns_from_table(uqff_catalog::Table &table)
+{
+    Columns cols;
+    cols.name = std::move(table.names);
+    for (size_t k = 0; k < Columns::fields().size(); ++k)
+        cols.*Columns::fields()[k].second = std::move(table.columns[k]);
+    return cols;
+}
+
+// Both loaders throw uqff_catalog::CatalogError (file:line: reason) on bad input
+CelestialBodyColumns load_body_columns(const std::string &filename)
+{
+    uqff_catalog::Table table = uqff_catalog::load(filename, CelestialBodyColumns::fields().size());
+    return columns_from_table<CelestialBodyColumns>(table);
+}
+
+MUGESystemColumns load_muge_columns(const std::string &filename)
+{
+    uqff_catalog::Table table = uqff_catalog::load(filename, MUGESystemColumns::fields().size());
+    return columns_from_table<MUGESystemColumns>(table);
+}
+
+std::vector<CelestialBody> load_bodies(const std::string &filename)
+{
+    CelestialBodyColumns cols = load_body_columns(filename);
+    std::vector<CelestialBody> bodies(cols.size());
+    for (size_t i = 0; i < bodies.size(); ++i)
+        bodies[i] = cols.at(i);
+    return bodies;
+}
+
+std::vector<MUGESystem> load_muge_systems(const std::string &filename)
+{
+    MUGESystemColumns cols = load_muge_columns(filename);
+    std::vector<MUGESystem> systems(cols.size());
+    for (size_t i = 0; i < systems.size(); ++i)
+        systems[i] = cols.at(i);
+    return systems;
+}
+
+// ============================================================================
+// POPULATION MUGE (batch over MUGESystemColumns)
+// ============================================================================
+
+// Every compressed and resonance MUGE sub-term, one column per term, one row per system
+struct MUGETermColumns
+{
+    // Compressed: adjusted base (base * expansion * super_adj * env) + the rest
+    std::vector<double> base, expansion, super_adj, env, Ug_sum, cosm, quantum, fluid, perturbation, compressed;
+    // Resonance: sum of all thirteen
+    std::vector<double> aDPM, aTHz, avac_diff, asuper_freq, aaether_res, Ug4i, aquantum_freq, aAether_freq,
+        afluid_freq, Osc_term, aexp_freq, fTRZ, a_wormhole, resonance;
+
+    using Column = std::pair<const char *, std::vector<double> MUGETermColumns::*>;
+    static const std::array<Column, 24> &columns()
+    {
+        static const std::array<Column, 24> table = {{
+            {"base", &MUGETermColumns::base},
+            {"expansion", &MUGETermColumns::expansion},
+            {"super_adj", &MUGETermColumns::super_adj},
+            {"env", &MUGETermColumns::env},
+            {"Ug_sum", &MUGETermColumns::Ug_sum},
+            {"cosm", &MUGETermColumns::cosm},
+            {"quantum", &MUGETermColumns::quantum},
+            {"fluid", &MUGETermColumns::fluid},
+            {"perturbation", &MUGETermColumns::perturbation},
+            {"compressed", &MUGETermColumns::compressed},
+            {"aDPM", &MUGETermColumns::aDPM},
+            {"aTHz", &MUGETermColumns::aTHz},
+            {"avac_diff", &MUGETermColumns::avac_diff},
+            {"asuper_freq", &MUGETermColumns::asuper_freq},
+            {"aaether_res", &MUGETermColumns::aaether_res},
+            {"Ug4i", &MUGETermColumns::Ug4i},
+            {"aquantum_freq", &MUGETermColumns::aquantum_freq},
+            {"aAether_freq", &MUGETermColumns::aAether_freq},
+            {"afluid_freq", &MUGETermColumns::afluid_freq},
+            {"Osc_term", &MUGETermColumns::Osc_term},
+            {"aexp_freq", &MUGETermColumns::aexp_freq},
+            {"fTRZ", &MUGETermColumns::fTRZ},
+            {"a_wormhole", &MUGETermColumns::a_wormhole},
+            {"resonance", &MUGETermColumns::resonance},
+        }};
+        return table;
+    }
+
+    size_t size() const { return compressed.size(); }
+
+    void resize(size_t n)
+    {
+        for (const Column &c : columns())
+            (this->*c.second).resize(n);
+    }
+};
+
+// compute_compressed_MUGE / compute_resonance_MUGE for every system of `sys`, all
+// sub-terms kept. The per-system formulas are the scalar ones with the ResonanceParams
+// factors folded into constants, so results agree to a few ulps (Ug4i uses the
+// uqff_simd exp). Where the scalar code throws (r == 0, Bcrit == 0) the affected
+// terms are NaN instead, so one bad candidate does not stop a population run.
+// SIMD across systems, OpenMP across blocks of systems.
+void compute_MUGE_batch(const MUGESystemColumns &sys, const ResonanceParams &res, MUGETermColumns &out)
+{
+    using namespace uqff_simd;
+    const size_t n = sys.size();
+    out.resize(n);
+
+    // System-independent terms
+    const double H0 = 2.269e-18, H_z = 2.270e-18;
+    const double env = compute_compressed_env(), Ug_sum = compute_compressed_Ug_sum();
+    const double cosm = compute_compressed_cosm(), quantum = compute_compressed_quantum();
+    const double Osc = compute_Osc_term(), fTRZ = compute_fTRZ(res);
+
+    // Resonance factors: each term is factor * (system columns) * aDPM
+    const double per_ISM = res.Evac_neb / res.Evac_ISM / res.c_res;
+    const double k_DPM = res.fDPM * res.Evac_neb * res.c_res;
+    const double k_THz = res.fTHz * per_ISM;
+    const double k_vac = res.Delta_Evac / res.Evac_neb / (res.c_res * res.c_res);
+    const double k_super = res.Fsuper * res.fTHz / res.Evac_neb / res.c_res;
+    const double k_aether = res.UA_SCM * res.omega_i * res.fTHz * (1 + res.fTRZ);
+    const double k_Ug4i = res.k4_res * 1046 * res.freact / res.Evac_neb * res.c_res;
+    const double k_quantum = res.fquantum * per_ISM;
+    const double k_Aether = res.fAether * per_ISM;
+    const double k_exp = 2 * PI * H_z * per_ISM;
+    const double k_worm = 7.09e-36; // compute_a_wormhole defaults: f_worm = 1, b = 1
+
+    constexpr size_t BLOCK = 4096;
+    const long blocks = static_cast<long>((n + BLOCK - 1) / BLOCK);
+#pragma omp parallel for schedule(static)
+    for (long b = 0; b < blocks; ++b)
+    {
+        const size_t begin = static_cast<size_t>(b) * BLOCK;
+        forEachBlock(begin, std::min(n, begin + BLOCK), [&](size_t i, auto x)
+                     {
+            using V = decltype(x);
+            auto in = [&](const std::vector<double> &column) { return loadAs(x, column.data() + i); };
+            auto put = [&](std::vector<double> &column, V value) { storeTo(column.data() + i, value); };
+
+            const V M = in(sys.M), r = in(sys.r), t = in(sys.t), Vsys = in(sys.Vsys), vexp = in(sys.vexp);
+            const V r2 = r * r;
+
+            // Compressed
+            const V base = nanWhereZero(r, V(G) * M / r2);
+            const V expansion = V(1.0) + V(H0) * t;
+            const V super_adj = nanWhereZero(in(sys.Bcrit), V(1.0) - in(sys.B) / in(sys.Bcrit));
+            const V fluid = in(sys.rho_fluid) * Vsys * in(sys.g_local);
+            const V perturbation = nanWhereZero(r, (M + in(sys.M_DM)) * (in(sys.delta_rho_rho) + V(3 * G) * M / (r2 * r)));
+            put(out.base, base);
+            put(out.expansion, expansion);
+            put(out.super_adj, super_adj);
+            put(out.env, V(env));
+            put(out.Ug_sum, V(Ug_sum));
+            put(out.cosm, V(cosm));
+            put(out.quantum, V(quantum));
+            put(out.fluid, fluid);
+            put(out.perturbation, perturbation);
+            put(out.compressed, base * expansion * super_adj * V(env) + V(Ug_sum) + V(cosm) + V(quantum) + fluid + perturbation);
+
+            // Resonance
+            const V aDPM = in(sys.I) * in(sys.A) * (in(sys.omega1) - in(sys.omega2)) * V(k_DPM) * Vsys;
+            const V aTHz = V(k_THz) * vexp * aDPM;
+            const V avac_diff = V(k_vac) * vexp * vexp * aDPM;
+            const V asuper_freq = V(k_super) * aDPM;
+            const V aaether_res = V(k_aether) * aDPM;
+            const V Ug4i = V(k_Ug4i) * uqff_simd::exp(V(-0.0005) * t) * aDPM;
+            const V aquantum_freq = V(k_quantum) * aDPM;
+            const V aAether_freq = V(k_Aether) * aDPM;
+            const V afluid_freq = V(per_ISM) * in(sys.ffluid) * Vsys;
+            const V aexp_freq = V(k_exp) * t * aDPM;
+            const V a_wormhole = V(k_worm) / (V(1.0) + r2);
+            put(out.aDPM, aDPM);
+            put(out.aTHz, aTHz);
+            put(out.avac_diff, avac_diff);
+            put(out.asuper_freq, asuper_freq);
+            put(out.aaether_res, aaether_res);
+            put(out.Ug4i, Ug4i);
+            put(out.aquantum_freq, aquantum_freq);
+            put(out.aAether_freq, aAether_freq);
+            put(out.afluid_freq, afluid_freq);
+            put(out.Osc_term, V(Osc));
+            put(out.aexp_freq, aexp_freq);
+            put(out.fTRZ, V(fTRZ));
+            put(out.a_wormhole, a_wormhole);
+            put(out.resonance, aDPM + aTHz + avac_diff + asuper_freq + aaether_res + Ug4i + aquantum_freq + aAether_freq +
+                                   afluid_freq + V(Osc) + aexp_freq + V(fTRZ) + a_wormhole); });
+    }
+}
+
+// ============================================================================
+// MUGE UNCERTAINTY BANDS (Monte Carlo over the population kernel)
+// ============================================================================
+
+// Declared input distributions for one MUGE system. `system` follows
+// MUGESystemColumns::fields(); the rest feed the buoyancy term
+// Ubi = compute_Ubi(base, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, tn = 0),
+// i.e. Universal Buoyancy acting on the system's Newtonian g.
+struct MUGEUncertainty
+{
+    std::array<uqff_montecarlo::Distribution, 17> system;
+    uqff_montecarlo::Distribution beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA;
+
+    using BuoyancyField = uqff_montecarlo::Distribution MUGEUncertainty::*;
+    static const std::array<BuoyancyField, 7> &buoyancy_fields()
+    {
+        static const std::array<BuoyancyField, 7> table = {
+            &MUGEUncertainty::beta_i, &MUGEUncertainty::Omega_g, &MUGEUncertainty::Mbh, &MUGEUncertainty::dg,
+            &MUGEUncertainty::epsilon_sw, &MUGEUncertainty::rho_sw, &MUGEUncertainty::UUA};
+        return table;
+    }
+
+    // Every input spread by `rel` (relative 1-sigma) around `nominal` and the globals
+    static MUGEUncertainty relative(const MUGESystem &nominal, double rel)
+    {
+        using uqff_montecarlo::Distribution;
+        MUGEUncertainty u;
+        for (size_t k = 0; k < u.system.size(); ++k)
+            u.system[k] = Distribution::around(nominal.*MUGESystemColumns::fields()[k].first, rel);
+        u.beta_i = Distribution::around(::beta_i, rel);
+        u.Omega_g = Distribution::around(::Omega_g, rel);
+        u.Mbh = Distribution::around(::Mbh, rel);
+        u.dg = Distribution::around(::dg, rel);
+        u.epsilon_sw = Distribution::around(::epsilon_sw, rel);
+        u.rho_sw = Distribution::around(::rho_sw, rel);
+        u.UUA = Distribution::around(::UUA, rel);
+        return u;
+    }
+};
+
+struct MonteCarloOptions
+{
+    size_t samples = 1000000;
+    uint64_t seed = 0;
+    size_t chunk = 1 << 16; // samples drawn and evaluated per pass (bounds memory)
+    std::vector<double> probs = uqff_montecarlo::defaultProbs();
+    size_t bins = 64;
+};
+
+struct MUGEBand
+{
+    std::string name;
+    uqff_montecarlo::Summary compressed, resonance, buoyancy;
+    double seconds = 0.0;
+};
+
+// N samples of `unc`, evaluated with compute_MUGE_batch plus a SIMD buoyancy pass.
+// Stream ids are (system_id, input), so bands are reproducible for a given seed and
+// independent of the chunk size and thread count.
+MUGEBand run_MUGE_monte_carlo(const std::string &name, const MUGEUncertainty &unc, const ResonanceParams &res,
+                              const MonteCarloOptions &opts, uint64_t system_id = 0)
+{
+    using namespace uqff_simd;
+    const uqff_montecarlo::Philox rng(opts.seed);
+    const size_t n = opts.samples, chunk = std::max<size_t>(1, std::min(opts.chunk, n));
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<double> compressed(n), resonance(n), buoyancy(n);
+    MUGESystemColumns sys;
+    MUGETermColumns terms;
+    std::array<std::vector<double>, 7> ubi_in;
+    for (size_t first = 0; first < n; first += chunk)
+    {
+        const size_t m = std::min(chunk, n - first);
+        sys.name.resize(m);
+        for (size_t k = 0; k < unc.system.size(); ++k)
+        {
+            std::vector<double> &column = sys.*MUGESystemColumns::fields()[k].second;
+            column.resize(m);
+            uqff_montecarlo::sample(unc.system[k], rng, (system_id << 8) | k, first, column);
+        }
+        for (size_t k = 0; k < ubi_in.size(); ++k)
+        {
+            ubi_in[k].resize(m);
+            uqff_montecarlo::sample(unc.*MUGEUncertainty::buoyancy_fields()[k], rng, (system_id << 8) | (32 + k), first,
+                                    ubi_in[k]);
+        }
+
+        compute_MUGE_batch(sys, res, terms);
+        std::copy(terms.compressed.begin(), terms.compressed.end(), compressed.begin() + first);
+        std::copy(terms.resonance.begin(), terms.resonance.end(), resonance.begin() + first);
+
+        // compute_Ubi with tn = 0 (cos term = 1)
+        double *ubi_out = buoyancy.data() + first;
+        forEachBlock(0, m, [&](size_t i, auto x)
+                     {
+            auto in = [&](const std::vector<double> &column) { return loadAs(x, column.data() + i); };
+            const auto wind_mod = decltype(x)(1.0) + in(ubi_in[4]) * in(ubi_in[5]);
+            storeTo(ubi_out + i, -in(ubi_in[0]) * in(terms.base) * in(ubi_in[1]) * in(ubi_in[2]) / in(ubi_in[3]) * wind_mod *
+                                     in(ubi_in[6])); });
+    }
+
+    MUGEBand band;
+    band.name = name;
+    band.compressed = uqff_montecarlo::summarize(compressed, opts.probs, opts.bins);
+    band.resonance = uqff_montecarlo::summarize(resonance, opts.probs, opts.bins);
+    band.buoyancy = uqff_montecarlo::summarize(buoyancy, opts.probs, opts.bins);
+    band.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return band;
+}
+
+void print_MUGE_band(const MUGEBand &band)
+{
+    auto row = [&](const char *label, const uqff_montecarlo::Summary &s)
+    {
+        std::cout << "  " << label << ": mean " << s.mean << ", sd " << s.stddev;
+        for (size_t q = 0; q < s.probs.size(); ++q)
+            std::cout << ", p" << s.probs[q] * 100 << " " << s.quantiles[q];
+        if (s.nonfinite)
+            std::cout << " (" << s.nonfinite << " non-finite)";
+        std::cout << std::endl;
+    };
+    std::cout << "MUGE uncertainty band for " << band.name << " (" << band.compressed.count + band.compressed.nonfinite
+              << " samples, " << band.seconds << " s):" << std::endl;
+    row("compressed", band.compressed);
+    row("resonance", band.resonance);
+    row("buoyancy", band.buoyancy);
+}
+
 // Unit Tests
 void test_compute_compressed_base()
 {
@@ -1568,6 +1905,225 @@ void test_compute_a_wormhole()
     assert(std::abs(result - expected) < 1e-6);
 }
 
+void test_compute_FU_batch()
+{
+    CelestialBody sun = {"Sun", 1.989e30, 6.96e8, 1.496e13, 5778.0, 2.5e-6, 1e-4, 1e15, 1e-11, 1.0, 1.0,
+                         2 * PI / (11.0 * 365.25 * 24 * 3600)};
+    const double r[6] = {1e12, 1.496e13, 2e13, 1e12, 5e13, 1e14};
+    const double t[6] = {0.0, 0.0, 0.0, 86400.0, 86400.0, 86400.0};
+    const double theta[6] = {0.0, 0.5, 1.0, 0.0, 0.5, 1.0};
+    double out[6];
+    compute_FU_batch(sun, r, t, t, theta, out);
+    for (int i = 0; i < 6; ++i)
+    {
+        // Term-by-term FU: sum Ugi + sum Ubi + Um + trace(A_mu_nu)
+        double Ug[4] = {compute_Ug1(sun, r[i], t[i], t[i], alpha, delta_def, k1),
+                        compute_Ug2(sun, r[i], t[i], t[i], k2, QA, delta_sw, v_sw, HSCm, rho_A, kappa),
+                        compute_Ug3(sun, r[i], t[i], t[i], theta[i], rho_A, kappa, k3),
+                        compute_Ug4(t[i], t[i], rho_v, C_concentration, Mbh, dg, alpha, f_feedback, k4)};
+        double expected = 0.0;
+        for (double Ugi : Ug)
+            expected += Ugi + compute_Ubi(Ugi, beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, t[i]);
+        auto A = compute_A_mu_nu(t[i], eta, Ts00);
+        expected += compute_Um(sun, t[i], t[i], sun.Rb, gamma, rho_A, kappa, num_strings) + A[0][0] + A[1][1] + A[2][2] + A[3][3];
+        assert(std::abs(out[i] - expected) <= 1e-12 * std::abs(expected));
+        assert(compute_FU(sun, r[i], t[i], t[i], theta[i]) == out[i]);
+    }
+
+    // Spans of different lengths are rejected rather than read past
+    bool threw = false;
+    try
+    {
+        compute_FU_batch(sun, r, std::span<const double>(t, 5), t, theta, out);
+    }
+    catch (const std::runtime_error &)
+    {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void test_field_map()
+{
+    CelestialBody sun = {"Sun", 1.989e30, 6.96e8, 1.496e13, 5778.0, 2.5e-6, 1e-4, 1e15, 1e-11, 1.0, 1.0,
+                         2 * PI / (11.0 * 365.25 * 24 * 3600)};
+    FieldMapRunOptions run;
+    run.n_r = 200;
+    run.n_theta = 5;
+    run.n_t = 2;
+    run.t_max = 86400.0;
+    auto eval = [&](double t, double theta, const double *r, size_t n, double *const *out)
+    { compute_field_row(sun, t, theta, r, n, out); };
+
+    uqff_fieldmap::Options opts;
+    opts.tile_r = 32;
+    opts.tile_theta = 2;
+    uqff_fieldmap::FieldMap dense = make_field_map(sun, run);
+    uqff_fieldmap::Stats stats = uqff_fieldmap::generate(dense, eval, opts);
+    assert(stats.tiles_evaluated == stats.tiles && stats.points_evaluated == dense.points());
+    for (int it = 0; it < run.n_t; ++it)
+        for (int ir = 0; ir < run.n_r; ir += 7)
+        {
+            const double r = dense.r().at(ir), t = dense.t().at(it);
+            assert(dense.value(0, it, 3, ir) == compute_FU(sun, r, t, t, dense.theta().at(3)));
+            assert((dense.value(2, it, 0, ir) == 0.0) == (r <= sun.Rb));
+        }
+
+    // Coarse-to-fine: smooth tiles are interpolated, the tile holding the Rb step is evaluated
+    opts.refine_threshold = 1e-3;
+    const std::string path = "test_field_map.uqmap";
+    uqff_fieldmap::FieldMap refined = make_field_map(sun, run);
+    uqff_fieldmap::Stats refined_stats;
+    {
+        uqff_fieldmap::Writer writer(path, refined, opts);
+        refined_stats = uqff_fieldmap::generate(refined, eval, opts, &writer);
+        writer.close();
+    }
+    assert(refined_stats.tiles_interpolated > 0 && refined_stats.tiles_evaluated > 0);
+    int step = 0;
+    while (refined.r().at(step) <= sun.Rb)
+        ++step;
+    assert(refined.value(2, 1, 4, step) == dense.value(2, 1, 4, step));
+    assert(refined.value(2, 1, 4, step - 1) == 0.0);
+
+    uqff_fieldmap::Stats file_stats;
+    uqff_fieldmap::FieldMap loaded = uqff_fieldmap::read(path, &file_stats);
+    std::remove(path.c_str());
+    assert(file_stats.tiles == refined_stats.tiles && loaded.channelNames() == FIELD_MAP_CHANNELS);
+    for (int c = 0; c < loaded.channels(); ++c)
+        assert(std::equal(loaded.channel(c).begin(), loaded.channel(c).end(), refined.channel(c).begin()));
+}
+
+void test_load_catalogue()
+{
+    const std::string path = "test_catalogue.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "# synthetic bodies\n"
+            << "name,Ms,Rs,Rb,Ts_surface,omega_s,Bs_avg,SCm_density,QUA,Pcore,PSCm,omega_c\r\n"
+            << "Sun,1.989e30,6.96e8,1.496e13,5778,2.5e-6,1e-4,1e15,1e-11,1,1,1.8e-8\r\n"
+            << "\n"
+            << " Earth , +5.972e24,6.371e6,1e7,288,7.292e-5,3e-5,1e12,1e-12,1e-3,1e-3,2e-7";
+    }
+    CelestialBodyColumns cols = load_body_columns(path);
+    assert(cols.size() == 2 && cols.name[1] == "Earth");
+    assert(cols.Ms[0] == 1.989e30 && cols.Ms[1] == 5.972e24 && cols.omega_c[1] == 2e-7);
+    CelestialBody earth = cols.at(1);
+    assert(earth.Rb == 1e7 && earth.PSCm == 1e-3);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "Sun,1.989e30,6.96e8,1.496e13,5778,2.5e-6,1e-4,1e15,1e-11,1,1,1.8e-8\n"
+            << "Earth,5.972e24,6.371e6,1e7,288,7.292e-5,3e-5,1e12\n";
+    }
+    size_t bad_line = 0;
+    try
+    {
+        load_bodies(path);
+    }
+    catch (const uqff_catalog::CatalogError &e)
+    {
+        bad_line = e.line;
+    }
+    std::remove(path.c_str());
+    assert(bad_line == 2);
+}
+
+void test_compute_MUGE_batch()
+{
+    // The seven catalogue systems, a few thousand perturbed copies (to cover full SIMD
+    // blocks and the tail) and one degenerate system with r = 0
+    MUGESystemColumns cols;
+    const std::vector<MUGESystem> known = {sgr1745, sagA, tapestry, westerlund, pillars, rings, student_guide};
+    for (int k = 0; k < 1001; ++k)
+    {
+        for (const MUGESystem &base : known)
+        {
+            MUGESystem sys = base;
+            for (const auto &f : MUGESystemColumns::fields())
+                sys.*f.first *= 1.0 + 1e-3 * ((k * 7 + (&f - MUGESystemColumns::fields().data())) % 13);
+            cols.append(sys);
+        }
+    }
+    MUGESystem degenerate = known[0];
+    degenerate.r = 0.0;
+    cols.append(degenerate);
+
+    ResonanceParams res;
+    MUGETermColumns out;
+    compute_MUGE_batch(cols, res, out);
+    assert(out.size() == cols.size());
+
+    auto close = [](double got, double want)
+    { return std::abs(got - want) <= 1e-13 * std::abs(want) + 1e-300; };
+    for (size_t i = 0; i + 1 < cols.size(); i += 3)
+    {
+        const MUGESystem sys = cols.at(i);
+        const double aDPM = compute_aDPM(sys, res);
+        assert(out.compressed[i] == compute_compressed_MUGE(sys));
+        assert(out.base[i] == compute_compressed_base(sys) && out.perturbation[i] == compute_compressed_perturbation(sys));
+        assert(close(out.aDPM[i], aDPM));
+        assert(close(out.aTHz[i], compute_aTHz(aDPM, sys, res)));
+        assert(close(out.avac_diff[i], compute_avac_diff(aDPM, sys, res)));
+        assert(close(out.Ug4i[i], compute_Ug4i(aDPM, sys, res)));
+        assert(close(out.afluid_freq[i], compute_afluid_freq(sys, res)));
+        assert(close(out.aexp_freq[i], compute_aexp_freq(aDPM, sys, res)));
+        assert(close(out.a_wormhole[i], compute_a_wormhole(sys.r)));
+        assert(close(out.resonance[i], compute_resonance_MUGE(sys, res)));
+    }
+    const size_t last = cols.size() - 1;
+    assert(std::isnan(out.base[last]) && std::isnan(out.compressed[last]) && !std::isnan(out.resonance[last]));
+}
+
+void test_muge_monte_carlo()
+{
+    // Philox4x32-10 known-answer vectors (Random123 kat_vectors)
+    using Block = uqff_montecarlo::Philox::Block;
+    assert((uqff_montecarlo::Philox(0).generate({0, 0, 0, 0}) == Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    assert((uqff_montecarlo::Philox(0x299f31d0a4093822ull).generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}) ==
+            Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+    // Sampled moments and quantiles of a declared normal
+    std::vector<double> draws(200000);
+    uqff_montecarlo::sample(uqff_montecarlo::Distribution::normal(3.0, 2.0), uqff_montecarlo::Philox(7), 1, 0, draws);
+    uqff_montecarlo::Summary s = uqff_montecarlo::summarize(draws);
+    assert(s.count == draws.size() && s.nonfinite == 0);
+    assert(std::abs(s.mean - 3.0) < 0.02 && std::abs(s.stddev - 2.0) < 0.02);
+    assert(std::abs(s.quantiles[2] - 3.0) < 0.03 && std::abs(s.quantiles[4] - (3.0 + 1.95996 * 2.0)) < 0.05);
+    size_t binned = 0;
+    for (size_t c : s.histogram.counts)
+        binned += c;
+    assert(binned == s.count && s.histogram.lo == s.min && s.histogram.hi == s.max);
+
+    // Fixed inputs reproduce the scalar MUGE exactly
+    ResonanceParams res;
+    MonteCarloOptions opts;
+    opts.samples = 1000;
+    MUGEUncertainty fixed = MUGEUncertainty::relative(sagA, 0.0);
+    for (auto &d : fixed.system)
+        d = uqff_montecarlo::Distribution::fixed(d.a);
+    for (auto f : MUGEUncertainty::buoyancy_fields())
+        fixed.*f = uqff_montecarlo::Distribution::fixed((fixed.*f).a);
+    MUGEBand exact = run_MUGE_monte_carlo(sagA.name, fixed, res, opts);
+    assert(exact.compressed.stddev == 0.0 && exact.compressed.quantiles[2] == compute_compressed_MUGE(sagA));
+    assert(std::abs(exact.resonance.mean - compute_resonance_MUGE(sagA, res)) <= 1e-13 * std::abs(exact.resonance.mean));
+    const double ubi = compute_Ubi(compute_compressed_base(sagA), beta_i, Omega_g, Mbh, dg, epsilon_sw, rho_sw, UUA, 0.0);
+    assert(std::abs(exact.buoyancy.max - ubi) <= 1e-14 * std::abs(ubi));
+
+    // Same seed, different chunking: identical bands; another seed: different draws
+    opts.samples = 5003;
+    MUGEUncertainty spread = MUGEUncertainty::relative(sagA, 0.05);
+    MUGEBand a = run_MUGE_monte_carlo(sagA.name, spread, res, opts, 1);
+    opts.chunk = 777;
+    MUGEBand b = run_MUGE_monte_carlo(sagA.name, spread, res, opts, 1);
+    assert(a.compressed.quantiles == b.compressed.quantiles && a.resonance.mean == b.resonance.mean &&
+           a.buoyancy.histogram.counts == b.buoyancy.histogram.counts);
+    assert(a.compressed.stddev > 0.0 && a.compressed.quantiles[0] < a.compressed.quantiles[4]);
+    opts.seed = 1;
+    MUGEBand c = run_MUGE_monte_carlo(sagA.name, spread, res, opts, 1);
+    assert(c.compressed.mean != a.compressed.mean);
+}
+
 void run_unit_tests()
 {
     test_compute_compressed_base();
@@ -1597,89 +2153,204 @@ void run_unit_tests()
     std::cout << "All unit tests passed!" << std::endl;
 }
 
-void simulate_quasar_jet(double initial_velocity)
+void test_multigrid_non_power_of_two()
+{
+    // n = 100 only halves down to 25; the coarsest grid must still be solved exactly
+    for (int n : {100, 97})
+    {
+        MultigridSolver mg(n);
+        std::vector<double> p(static_cast<size_t>(n + 2) * (n + 2), 0.0), div(p.size(), 0.0);
+        for (size_t k = 0; k < div.size(); ++k)
+            div[k] = std::sin(0.37 * static_cast<double>(k));
+        MultigridStats stats = mg.solve(0, p.data(), div.data(), 4.0, 1.0);
+        assert(stats.converged && stats.residual <= mg.options().tolerance);
+    }
+    FluidSolver solver(100, PoissonBackend::Multigrid);
+    solver.add_jet_force(1.0);
+    solver.step();
+    assert(solver.last_solve.converged && solver.unconverged_solves == 0);
+}
+
+// Batch, field-map, catalogue, Monte-Carlo and multigrid paths. Run on their own, ahead
+// of run_unit_tests(), so they are not skipped when a legacy formula test aborts.
+void run_engine_tests()
+{
+    test_compute_FU_batch();
+    test_field_map();
+    test_load_catalogue();
+    test_compute_MUGE_batch();
+    test_muge_monte_carlo();
+    test_multigrid_non_power_of_two();
+    std::cout << "All engine tests passed!" << std::endl;
+}
+
+// Step count and checkpoint/restart settings for the 2D jet
+struct JetRunOptions
+{
+    uint64_t steps = 10;           // total steps, counted from the start of the original run
+    std::string checkpoint_file;   // written in the background while stepping, and after the last step
+    uint64_t checkpoint_every = 0; // steps between checkpoints (0 = last step only)
+    std::string resume_file;       // continue from this checkpoint instead of a fresh jet
+};
+
+void simulate_quasar_jet(double initial_velocity, PoissonBackend backend = PoissonBackend::GaussSeidel, int grid = 32,
+                         const JetRunOptions &run = JetRunOptions())
 {
-    FluidSolver solver;
-    solver.add_jet_force(initial_velocity / 10.0); // Scale for simulation
+    std::optional<uqff_checkpoint::Checkpoint> saved;
+    if (!run.resume_file.empty())
+    {
+        try
+        {
+            saved = uqff_checkpoint::Checkpoint::read(run.resume_file);
+            grid = static_cast<int>(saved->getU64("grid"));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            return;
+        }
+    }
+
+    FluidSolver solver(grid, backend);
+    uint64_t first_step = 0;
+    if (saved)
+    {
+        first_step = solver.restore(*saved);
+        std::cout << "Resumed quasar jet from " << run.resume_file << " at step " << first_step << std::endl;
+    }
+    else
+    {
+        solver.add_jet_force(initial_velocity / 10.0); // Scale for simulation
+    }
 
     // Integrate UQFF: Compute example g from resonance MUGE for force (using Sgr A* as example)
     ResonanceParams res;
-    MUGESystem sagA;                                   // Use sagA from main
+    MUGESystem sagA{};                                 // Zero-initialised; fields are otherwise indeterminate
     double uqff_g = compute_resonance_MUGE(sagA, res); // Example, large value, but scale down for sim
 
-    std::cout << "Simulating quasar jet with Navier-Stokes (10 steps) using UQFF g=" << uqff_g << "..." << std::endl;
-    for (int step = 0; step < 10; ++step)
+    // Snapshots are copied here and written by the writer thread
+    std::optional<uqff_checkpoint::AsyncWriter> writer;
+    uqff_checkpoint::Interval interval(run.checkpoint_every);
+    interval.restart(first_step);
+    if (!run.checkpoint_file.empty())
+        writer.emplace();
+
+    std::cout << "Simulating quasar jet with Navier-Stokes (" << run.steps << " steps) using UQFF g=" << uqff_g << "..." << std::endl;
+    for (uint64_t step = first_step; step < run.steps; ++step)
     {
         solver.step(uqff_g / 1e30); // Scale g to avoid numerical blowup
+        if (writer && step + 1 < run.steps && interval.due(step + 1))
+            writer->submit(solver.checkpoint(step + 1), run.checkpoint_file);
+    }
+    if (writer)
+    {
+        writer->submit(solver.checkpoint(std::max(first_step, run.steps)), run.checkpoint_file);
+        writer->flush();
+        std::string error = writer->takeError();
+        if (!error.empty())
+            std::cerr << "ERROR: " << error << std::endl;
+        else
+            std::cout << "Checkpoint written to " << run.checkpoint_file << " (" << writer->written() << " writes)" << std::endl;
+    }
+    if (backend == PoissonBackend::Multigrid)
+    {
+        std::cout << "Multigrid pressure solve: " << solver.last_solve.cycles << " V-cycles, "
+                  << solver.last_solve.levels << " levels, relative residual " << solver.last_solve.residual << std::endl;
+        if (solver.unconverged_solves > 0)
+            std::cout << "  " << solver.unconverged_solves << " multigrid solves stopped before reaching the tolerance" << std::endl;
     }
     solver.print_velocity_field();
 }
 
-std::vector<CelestialBody> load_bodies(const std::string & /* filename */)
+// 3D jet with the same UQFF forcing, applied along the chosen jet axis
+template <typename Real>
+void run_quasar_jet_3d(double initial_velocity, int grid, typename FluidSolver3D<Real>::Axis axis, const std::string &raw_file)
 {
-    std::vector<CelestialBody> bodies;
-    // Similar parsing as for MUGE systems
-    return bodies;
+    FluidSolver3D<Real> solver(grid, axis);
+    solver.add_jet_force(initial_velocity / 10.0);
+
+    ResonanceParams res;
+    MUGESystem sagA{};
+    double uqff_g = compute_resonance_MUGE(sagA, res);
+
+    std::cout << "Simulating 3D quasar jet (" << grid << "^3, " << solver.slabCount() << " slabs, "
+              << solver.memoryBytes() / 1e6 << " MB) using UQFF g=" << uqff_g << "..." << std::endl;
+    for (int step = 0; step < 10; ++step)
+    {
+        solver.step(uqff_g / 1e30);
+    }
+    solver.print_velocity_slice();
+
+    if (!raw_file.empty())
+    {
+        if (solver.write_speed_raw(raw_file))
+            std::cout << "Speed volume written to " << raw_file << " (float32, " << grid << "^3)" << std::endl;
+        else
+            std::cerr << "ERROR: Cannot write " << raw_file << std::endl;
+    }
 }
 
-std::vector<MUGESystem> load_muge_systems(const std::string &filename)
+void simulate_quasar_jet_3d(double initial_velocity, int grid, char axis, bool single_precision, const std::string &raw_file = "")
 {
-    std::vector<MUGESystem> systems;
-    std::ifstream in(filename);
-    if (in.is_open())
+    if (single_precision)
     {
-        std::string line;
-        while (std::getline(in, line))
+        using Solver = FluidSolver3D<float>;
+        auto a = axis == 'x' ? Solver::Axis::X : axis == 'y' ? Solver::Axis::Y : Solver::Axis::Z;
+        run_quasar_jet_3d<float>(initial_velocity, grid, a, raw_file);
+    }
+    else
+    {
+        using Solver = FluidSolver3D<double>;
+        auto a = axis == 'x' ? Solver::Axis::X : axis == 'y' ? Solver::Axis::Y : Solver::Axis::Z;
+        run_quasar_jet_3d<double>(initial_velocity, grid, a, raw_file);
+    }
+}
+
+void run_field_maps(const std::vector<CelestialBody> &bodies, const FieldMapRunOptions &run)
+{
+    uqff_fieldmap::Options opts;
+    opts.refine_threshold = run.refine_threshold;
+    opts.keep_dense = false; // stream only; maps can be far larger than memory
+
+    for (const auto &body : bodies)
+    {
+        uqff_fieldmap::FieldMap map = make_field_map(body, run);
+        const std::string path = field_map_path(run.output, body.name);
+        try
         {
-            // Parse line (assume CSV format: name,I,A,omega1,omega2,Vsys,vexp,t,z,ffluid,M,r,B,Bcrit,rho_fluid,g_local,M_DM,delta_rho_rho)
-            std::stringstream ss(line);
-            MUGESystem sys;
-            std::string token;
-            std::getline(ss, sys.name, ',');
-            std::getline(ss, token, ',');
-            sys.I = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.A = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.omega1 = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.omega2 = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.Vsys = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.vexp = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.t = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.z = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.ffluid = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.M = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.r = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.B = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.Bcrit = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.rho_fluid = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.g_local = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.M_DM = std::stod(token);
-            std::getline(ss, token, ',');
-            sys.delta_rho_rho = std::stod(token);
-            systems.push_back(sys);
+            uqff_fieldmap::Writer writer(path, map, opts);
+            auto eval = [&](double t, double theta, const double *r, size_t n, double *const *out)
+            { compute_field_row(body, t, theta, r, n, out); };
+            uqff_fieldmap::Stats stats = uqff_fieldmap::generate(map, eval, opts, &writer);
+            writer.close();
+            std::cout << "Field map for " << body.name << ": " << run.n_r << " x " << run.n_theta << " x " << run.n_t
+                      << " (r x theta x t) -> " << path << ", " << stats.tiles_evaluated << " tiles evaluated, "
+                      << stats.tiles_interpolated << " interpolated, " << stats.seconds << " s" << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Field map for " << body.name << " failed: " << e.what() << std::endl;
         }
     }
-    return systems;
 }
 
+
 int main(int argc, char **argv)
 {
     std::string input_file;
     std::string output_file;
+    PoissonBackend poisson = PoissonBackend::GaussSeidel;
+    int jet_grid = 32;
+    int jet3d_grid = 0; // 0 = 2D run only
+    char jet_axis = 'z';
+    bool jet_float = false;
+    std::string jet3d_raw;
+    JetRunOptions jet_run;
+    FieldMapRunOptions field_map;
+    std::string muge_input_file;
+    MonteCarloOptions muge_mc;
+    muge_mc.samples = 0; // no bands unless --muge-mc is given
+    double muge_mc_sigma = 0.05;
     for (int i = 1; i < argc; i += 2)
     {
         std::string arg = argv[i];
@@ -1691,12 +2362,101 @@ int main(int argc, char **argv)
         {
             output_file = argv[i + 1];
         }
+        else if (arg == "--poisson" && i + 1 < argc)
+        {
+            // gs (default) or mg
+            poisson = (std::string(argv[i + 1]) == "mg") ? PoissonBackend::Multigrid : PoissonBackend::GaussSeidel;
+        }
+        else if (arg == "--grid" && i + 1 < argc)
+        {
+            jet_grid = std::max(4, std::atoi(argv[i + 1]));
+        }
+        else if (arg == "--jet3d" && i + 1 < argc)
+        {
+            jet3d_grid = std::max(0, std::atoi(argv[i + 1]));
+        }
+        else if (arg == "--jet-axis" && i + 1 < argc)
+        {
+            jet_axis = static_cast<char>(std::tolower(static_cast<unsigned char>(argv[i + 1][0])));
+        }
+        else if (arg == "--precision" && i + 1 < argc)
+        {
+            jet_float = std::string(argv[i + 1]) == "float";
+        }
+        else if (arg == "--jet3d-raw" && i + 1 < argc)
+        {
+            jet3d_raw = argv[i + 1];
+        }
+        else if (arg == "--jet-steps" && i + 1 < argc)
+        {
+            jet_run.steps = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (arg == "--checkpoint" && i + 1 < argc)
+        {
+            jet_run.checkpoint_file = argv[i + 1];
+        }
+        else if (arg == "--checkpoint-every" && i + 1 < argc)
+        {
+            jet_run.checkpoint_every = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (arg == "--resume" && i + 1 < argc)
+        {
+            jet_run.resume_file = argv[i + 1];
+        }
+        else if (arg == "--muge-input" && i + 1 < argc)
+        {
+            muge_input_file = argv[i + 1];
+        }
+        else if (arg == "--muge-mc" && i + 1 < argc)
+        {
+            muge_mc.samples = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (arg == "--mc-seed" && i + 1 < argc)
+        {
+            muge_mc.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (arg == "--mc-sigma" && i + 1 < argc)
+        {
+            // relative 1-sigma spread of every MUGE and buoyancy input
+            muge_mc_sigma = std::atof(argv[i + 1]);
+        }
+        else if (arg == "--fieldmap" && i + 1 < argc)
+        {
+            field_map.output = argv[i + 1];
+        }
+        else if (arg == "--fieldmap-size" && i + 1 < argc)
+        {
+            // NRxNTHETAxNT, e.g. 1024x32x1
+            int nr = 0, nth = 0, nt = 0;
+            if (std::sscanf(argv[i + 1], "%dx%dx%d", &nr, &nth, &nt) == 3 && nr > 0 && nth > 0 && nt > 0)
+            {
+                field_map.n_r = nr;
+                field_map.n_theta = nth;
+                field_map.n_t = nt;
+            }
+        }
+        else if (arg == "--fieldmap-t" && i + 1 < argc)
+        {
+            field_map.t_max = std::atof(argv[i + 1]);
+        }
+        else if (arg == "--fieldmap-refine" && i + 1 < argc)
+        {
+            field_map.refine_threshold = std::atof(argv[i + 1]);
+        }
     }
 
     std::vector<CelestialBody> bodies;
     if (!input_file.empty())
     {
-        bodies = load_bodies(input_file);
+        try
+        {
+            bodies = load_bodies(input_file);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to load bodies: " << e.what() << std::endl;
+            return 1;
+        }
     }
     else
     {
@@ -1753,25 +2513,71 @@ int main(int argc, char **argv)
         std::cout << std::endl;
     }
 
+    if (!field_map.output.empty())
+    {
+        run_field_maps(bodies, field_map);
+        std::cout << std::endl;
+    }
+
     // Simulate quasar jet using Navier-Stokes (using Sun's SCm velocity as initial)
-    simulate_quasar_jet(v_SCm);
+    simulate_quasar_jet(v_SCm, poisson, jet_grid, jet_run);
+    if (jet3d_grid > 0)
+    {
+        simulate_quasar_jet_3d(v_SCm, jet3d_grid, jet_axis, jet_float, jet3d_raw);
+    }
 
     // Integrated MUGE calculations from attachments
     ResonanceParams res_params;
 
     // MUGE system definitions have been moved before test functions (see earlier in file)
     // to avoid forward reference errors
-    std::vector<MUGESystem> muge_systems = {sgr1745, sagA, tapestry, westerlund, pillars, rings, student_guide};
+    MUGESystemColumns muge_systems;
+    if (!muge_input_file.empty())
+    {
+        try
+        {
+            muge_systems = load_muge_columns(muge_input_file);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to load MUGE systems: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        for (const MUGESystem &sys : {sgr1745, sagA, tapestry, westerlund, pillars, rings, student_guide})
+            muge_systems.append(sys);
+    }
 
-    for (const auto &sys : muge_systems)
+    MUGETermColumns muge_terms;
+    auto muge_start = std::chrono::steady_clock::now();
+    compute_MUGE_batch(muge_systems, res_params, muge_terms);
+    double muge_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - muge_start).count();
+
+    const size_t muge_listed = std::min<size_t>(muge_systems.size(), 20);
+    for (size_t i = 0; i < muge_listed; ++i)
+    {
+        std::cout << "Compressed MUGE g for " << muge_systems.name[i] << ": " << muge_terms.compressed[i] << " m/s2" << std::endl;
+        std::cout << "Resonance MUGE g for " << muge_systems.name[i] << ": " << muge_terms.resonance[i] << " m/s2" << std::endl;
+    }
+    if (muge_systems.size() > muge_listed)
     {
-        double compressed_g = compute_compressed_MUGE(sys);
-        double resonance_g = compute_resonance_MUGE(sys, res_params);
-        std::cout << "Compressed MUGE g for " << sys.name << ": " << compressed_g << " m/s2" << std::endl;
-        std::cout << "Resonance MUGE g for " << sys.name << ": " << resonance_g << " m/s2" << std::endl;
+        std::cout << "... " << muge_systems.size() - muge_listed << " more; " << muge_systems.size() << " systems scored in "
+                  << muge_seconds << " s" << std::endl;
+    }
+
+    if (muge_mc.samples > 0)
+    {
+        for (size_t i = 0; i < muge_systems.size(); ++i)
+        {
+            const MUGEUncertainty unc = MUGEUncertainty::relative(muge_systems.at(i), muge_mc_sigma);
+            print_MUGE_band(run_MUGE_monte_carlo(muge_systems.name[i], unc, res_params, muge_mc, i));
+        }
     }
 
     // Run unit tests
+    run_engine_tests();
     run_unit_tests();
 
     return 0;
@@ -12,6 +12,27 @@
 #include <string>
 #include <cmath>
 #include <chrono>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <atomic>
+#include <optional>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include "uqff_param_schema.h"
+#include "uqff_thread_pool.h"
+#include "uqff_columnar.h"
+#include "uqff_tracing.h"
+#include "uqff_checkpoint.h"
 
 // Constants
 const double PI = 3.141592653589793;
@@ -33,6 +54,245 @@ public:
     virtual std::string getName() const = 0;
     virtual std::string getDescription() const = 0;
     virtual bool validate(const std::map<std::string, double> &params) const = 0;
+
+    // Slot-bound interface; defaults fall back to the std::map path
+    virtual void bindParams(ParamSchema &) {}
+    virtual double compute(double t, const ParamVector &params) const { return compute(t, params.toMap()); }
+    virtual bool validate(const ParamVector &params) const { return validate(params.toMap()); }
+
+    // Batched evaluation over a block of timesteps; default loops over compute()
+    virtual void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const
+    {
+        ParamVector params = block.params;
+        for (size_t i = 0; i < t.size(); ++i)
+        {
+            if (block.t_slot != ParamSlot::UNBOUND)
+                params.set(block.t_slot, t[i]);
+            out[i] = compute(t[i], params);
+        }
+    }
+
+    // Term graph: parameter keys this term publishes its value under / reads from other terms
+    virtual std::vector<std::string> produces() const { return {}; }
+    virtual std::vector<std::string> consumes() const { return {}; }
+
+    // Shortest period (s) this term oscillates with in t at these parameters, 0 if none;
+    // adaptive time stepping keeps several samples per period
+    virtual double oscillationPeriod(const ParamVector &) const { return 0.0; }
+};
+
+// ============================================================================
+// TERM PROFILING (opt-in, see PhysicsTermRegistry::enableProfiling)
+// ============================================================================
+
+// Log-linear latency histogram in the style of HdrHistogram: 32 sub-buckets per
+// power of two (~3% relative error) from 1 ns to ~18 min. Buckets are atomic so
+// terms evaluated concurrently by sweep workers can record without a lock.
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned SUB_BITS = 5;
+    static constexpr unsigned SUB_COUNT = 1u << SUB_BITS;
+    static constexpr unsigned MAGNITUDES = 40;
+    static constexpr size_t BUCKETS = (MAGNITUDES + 1) * SUB_COUNT;
+
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> counts;
+    std::atomic<uint64_t> total_count{0};
+
+    static size_t bucketOf(uint64_t ns)
+    {
+        if (ns < SUB_COUNT)
+            return static_cast<size_t>(ns);
+        unsigned magnitude = 63 - static_cast<unsigned>(std::countl_zero(ns)) - SUB_BITS + 1;
+        if (magnitude > MAGNITUDES)
+            return BUCKETS - 1;
+        size_t sub = static_cast<size_t>(ns >> (magnitude - 1)) - SUB_COUNT;
+        return magnitude * SUB_COUNT + sub;
+    }
+
+    // Representative (midpoint) value of a bucket
+    static double valueOf(size_t bucket)
+    {
+        if (bucket < SUB_COUNT)
+            return static_cast<double>(bucket);
+        size_t magnitude = bucket / SUB_COUNT;
+        double width = std::ldexp(1.0, static_cast<int>(magnitude) - 1);
+        return (SUB_COUNT + bucket % SUB_COUNT) * width + 0.5 * width;
+    }
+
+public:
+    LatencyHistogram() : counts(new std::atomic<uint64_t>[BUCKETS])
+    {
+        reset();
+    }
+
+    void record(uint64_t ns, uint64_t weight = 1)
+    {
+        counts[bucketOf(ns)].fetch_add(weight, std::memory_order_relaxed);
+        total_count.fetch_add(weight, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return total_count.load(std::memory_order_relaxed); }
+
+    // Value at quantile q in [0, 1] (0 if empty)
+    double quantile(double q) const
+    {
+        uint64_t n = count();
+        if (n == 0)
+            return 0.0;
+        uint64_t rank = static_cast<uint64_t>(std::ceil(q * n));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b)
+        {
+            seen += counts[b].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return valueOf(b);
+        }
+        return valueOf(BUCKETS - 1);
+    }
+
+    void reset()
+    {
+        for (size_t b = 0; b < BUCKETS; ++b)
+        {
+            counts[b].store(0, std::memory_order_relaxed);
+        }
+        total_count.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Per-term counters (shared by every thread evaluating the term)
+struct TermProfile
+{
+    std::atomic<uint64_t> calls{0};            // compute()/computeBatch() invocations
+    std::atomic<uint64_t> evaluations{0};      // Timesteps evaluated (batch size summed)
+    std::atomic<uint64_t> sampled_evals{0};    // Timesteps covered by timed calls
+    std::atomic<uint64_t> sampled_ns{0};       // Time spent in timed calls
+    std::atomic<uint64_t> min_ns{UINT64_MAX};  // Per-evaluation latency extremes
+    std::atomic<uint64_t> max_ns{0};
+    std::atomic<uint64_t> validate_calls{0};
+    std::atomic<uint64_t> validate_failures{0};
+    LatencyHistogram latency; // Nanoseconds per evaluation
+
+    void recordTiming(uint64_t ns, uint64_t evals)
+    {
+        uint64_t per_eval = ns / std::max<uint64_t>(evals, 1);
+        sampled_evals.fetch_add(evals, std::memory_order_relaxed);
+        sampled_ns.fetch_add(ns, std::memory_order_relaxed);
+        latency.record(per_eval, evals);
+
+        uint64_t cur = min_ns.load(std::memory_order_relaxed);
+        while (per_eval < cur && !min_ns.compare_exchange_weak(cur, per_eval, std::memory_order_relaxed))
+        {
+        }
+        cur = max_ns.load(std::memory_order_relaxed);
+        while (per_eval > cur && !max_ns.compare_exchange_weak(cur, per_eval, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void reset()
+    {
+        for (auto *counter : {&calls, &evaluations, &sampled_evals, &sampled_ns, &max_ns, &validate_calls, &validate_failures})
+        {
+            counter->store(0, std::memory_order_relaxed);
+        }
+        min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+        latency.reset();
+    }
+};
+
+// Decorator installed around a registered term while profiling is on. Every call is
+// counted; only a random `sample_rate` fraction is timed, which keeps the clock reads
+// (and the histogram's atomic adds) off most calls.
+class ProfiledTerm : public PhysicsTerm
+{
+private:
+    std::unique_ptr<PhysicsTerm> inner;
+    TermProfile *profile;
+    uint32_t sample_threshold; // Call is timed when a 32-bit random draw is below this
+
+    bool sampleThisCall() const
+    {
+        thread_local uint64_t state = 0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(&state);
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>(state >> 32) < sample_threshold;
+    }
+
+    template <typename F>
+    void timed(uint64_t evals, F &&f) const
+    {
+        profile->calls.fetch_add(1, std::memory_order_relaxed);
+        profile->evaluations.fetch_add(evals, std::memory_order_relaxed);
+        if (!sampleThisCall())
+        {
+            f();
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        profile->recordTiming(static_cast<uint64_t>(ns), evals);
+    }
+
+    bool counted(bool ok) const
+    {
+        profile->validate_calls.fetch_add(1, std::memory_order_relaxed);
+        if (!ok)
+            profile->validate_failures.fetch_add(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+public:
+    ProfiledTerm(std::unique_ptr<PhysicsTerm> term, TermProfile *stats, double sample_rate)
+        : inner(std::move(term)), profile(stats)
+    {
+        setSampleRate(sample_rate);
+    }
+
+    void setSampleRate(double rate)
+    {
+        rate = std::clamp(rate, 0.0, 1.0);
+        sample_threshold = rate >= 1.0 ? UINT32_MAX : static_cast<uint32_t>(rate * 4294967296.0);
+    }
+
+    std::unique_ptr<PhysicsTerm> release() { return std::move(inner); }
+
+    double compute(double t, const std::map<std::string, double> &params) const override
+    {
+        double value = 0.0;
+        timed(1, [&]
+              { value = inner->compute(t, params); });
+        return value;
+    }
+
+    double compute(double t, const ParamVector &params) const override
+    {
+        double value = 0.0;
+        timed(1, [&]
+              { value = inner->compute(t, params); });
+        return value;
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        timed(t.size(), [&]
+              { inner->computeBatch(t, block, out); });
+    }
+
+    bool validate(const std::map<std::string, double> &params) const override { return counted(inner->validate(params)); }
+    bool validate(const ParamVector &params) const override { return counted(inner->validate(params)); }
+
+    std::string getName() const override { return inner->getName(); }
+    std::string getDescription() const override { return inner->getDescription(); }
+    void bindParams(ParamSchema &schema) override { inner->bindParams(schema); }
+    std::vector<std::string> produces() const override { return inner->produces(); }
+    std::vector<std::string> consumes() const override { return inner->consumes(); }
+    double oscillationPeriod(const ParamVector &params) const override { return inner->oscillationPeriod(params); }
 };
 
 // ============================================================================
@@ -43,14 +303,146 @@ class PhysicsTermRegistry
 {
 private:
     std::map<std::string, std::unique_ptr<PhysicsTerm>> terms;
+    ParamSchema schema; // Parameter name -> slot table shared by all registered terms
+
+    // Profiling (off unless enableProfiling() is called)
+    std::map<std::string, std::unique_ptr<TermProfile>> profiles;
+    bool profiling = false;
+    double profile_sample_rate = 1.0;
+
+    std::unique_ptr<PhysicsTerm> wrapForProfiling(const std::string &name, std::unique_ptr<PhysicsTerm> term)
+    {
+        auto &profile = profiles[name];
+        if (!profile)
+            profile = std::make_unique<TermProfile>();
+        return std::make_unique<ProfiledTerm>(std::move(term), profile.get(), profile_sample_rate);
+    }
 
 public:
     void registerTerm(std::unique_ptr<PhysicsTerm> term)
     {
         std::string name = term->getName();
-        terms[name] = std::move(term);
+        term->bindParams(schema);
+        terms[name] = profiling ? wrapForProfiling(name, std::move(term)) : std::move(term);
+    }
+
+    // Wrap every term (and later registrations) to record call counts, latency and
+    // validate() failures. sample_rate is the fraction of calls that are timed.
+    // Toggle between runs only: running TermGraphs hold the term pointers.
+    void enableProfiling(double sample_rate = 0.05)
+    {
+        profile_sample_rate = sample_rate;
+        for (auto &pair : terms)
+        {
+            if (auto *profiled = dynamic_cast<ProfiledTerm *>(pair.second.get()))
+                profiled->setSampleRate(sample_rate);
+            else
+                pair.second = wrapForProfiling(pair.first, std::move(pair.second));
+        }
+        profiling = true;
+    }
+
+    // Unwrap the terms; collected profiles are kept until resetProfile()
+    void disableProfiling()
+    {
+        for (auto &pair : terms)
+        {
+            if (auto *profiled = dynamic_cast<ProfiledTerm *>(pair.second.get()))
+                pair.second = profiled->release();
+        }
+        profiling = false;
+    }
+
+    bool isProfiling() const { return profiling; }
+
+    void resetProfile()
+    {
+        for (auto &pair : profiles)
+        {
+            pair.second->reset();
+        }
+    }
+
+    // Profile table, terms ordered by estimated total time
+    void dumpProfile(std::ostream &out = std::cout) const
+    {
+        struct Row
+        {
+            const std::string *name;
+            const TermProfile *p;
+            double total_ms;
+        };
+        std::vector<Row> rows;
+        double grand_total_ms = 0.0;
+        for (const auto &pair : profiles)
+        {
+            rows.push_back({&pair.first, pair.second.get(), estimatedTotalMs(*pair.second)});
+            grand_total_ms += rows.back().total_ms;
+        }
+        std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b)
+                  { return a.total_ms > b.total_ms; });
+
+        std::ios saved(nullptr);
+        saved.copyfmt(out);
+
+        out << "\n=== Term Profile (sample rate " << profile_sample_rate << ") ===" << std::endl;
+        out << std::left << std::setw(36) << "Term" << std::right
+            << std::setw(12) << "Calls" << std::setw(14) << "Evals"
+            << std::setw(12) << "Total ms" << std::setw(8) << "%"
+            << std::setw(10) << "Min ns" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns"
+            << std::setw(10) << "Max ns" << std::setw(10) << "Invalid%" << std::endl;
+        out << std::fixed;
+        for (const auto &row : rows)
+        {
+            const TermProfile &p = *row.p;
+            const bool timed = p.latency.count() > 0;
+            out << std::left << std::setw(36) << *row.name << std::right
+                << std::setw(12) << p.calls.load() << std::setw(14) << p.evaluations.load()
+                << std::setprecision(3) << std::setw(12) << row.total_ms
+                << std::setprecision(1) << std::setw(8) << (grand_total_ms > 0 ? 100.0 * row.total_ms / grand_total_ms : 0.0)
+                << std::setprecision(0)
+                << std::setw(10) << (timed ? static_cast<double>(p.min_ns.load()) : 0.0)
+                << std::setw(10) << p.latency.quantile(0.50)
+                << std::setw(10) << p.latency.quantile(0.99)
+                << std::setw(10) << static_cast<double>(p.max_ns.load())
+                << std::setprecision(2) << std::setw(10) << 100.0 * invalidFraction(p) << std::endl;
+        }
+        out.copyfmt(saved);
+    }
+
+    // Same data as dumpProfile(), as JSON (latencies in ns per evaluation)
+    void dumpProfileJSON(std::ostream &out) const
+    {
+        std::ios saved(nullptr);
+        saved.copyfmt(out);
+        out << std::defaultfloat << std::setprecision(10);
+
+        out << "{\"sample_rate\":" << profile_sample_rate << ",\"terms\":[";
+        bool first = true;
+        for (const auto &pair : profiles)
+        {
+            const TermProfile &p = *pair.second;
+            const bool timed = p.latency.count() > 0;
+            out << (first ? "\n" : ",\n") << "{\"name\":\"" << pair.first << "\""
+                << ",\"calls\":" << p.calls.load()
+                << ",\"evaluations\":" << p.evaluations.load()
+                << ",\"sampled_evaluations\":" << p.sampled_evals.load()
+                << ",\"total_ms_estimate\":" << estimatedTotalMs(p)
+                << ",\"min_ns\":" << (timed ? p.min_ns.load() : 0)
+                << ",\"p50_ns\":" << p.latency.quantile(0.50)
+                << ",\"p99_ns\":" << p.latency.quantile(0.99)
+                << ",\"max_ns\":" << p.max_ns.load()
+                << ",\"validate_calls\":" << p.validate_calls.load()
+                << ",\"validate_failure_fraction\":" << invalidFraction(p) << "}";
+            first = false;
+        }
+        out << "\n]}" << std::endl;
+        out.copyfmt(saved);
     }
 
+    ParamSchema &getSchema() { return schema; }
+    const ParamSchema &getSchema() const { return schema; }
+
     const PhysicsTerm *getTerm(const std::string &name) const
     {
         auto it = terms.find(name);
@@ -72,6 +464,21 @@ public:
         return terms.size();
     }
 
+    // Mean sampled cost scaled to every evaluation
+    static double estimatedTotalMs(const TermProfile &p)
+    {
+        uint64_t sampled = p.sampled_evals.load();
+        if (sampled == 0)
+            return 0.0;
+        return 1e-6 * static_cast<double>(p.sampled_ns.load()) * p.evaluations.load() / sampled;
+    }
+
+    static double invalidFraction(const TermProfile &p)
+    {
+        uint64_t calls = p.validate_calls.load();
+        return calls ? static_cast<double>(p.validate_failures.load()) / calls : 0.0;
+    }
+
     void printRegistry() const
     {
         std::cout << "\n=== Physics Term Registry (" << terms.size() << " terms) ===" << std::endl;
@@ -83,6 +490,226 @@ public:
     }
 };
 
+// ============================================================================
+// TERM GRAPH - Dependency-ordered evaluation of the active terms
+// ============================================================================
+
+// Edges come from PhysicsTerm::produces()/consumes(). Each node's value is cached
+// once per timestep and published into the ParamVector slot of every key it
+// produces; nodes in the same topological level are independent and run in parallel.
+class TermGraph
+{
+private:
+    struct Node
+    {
+        std::string name;
+        const PhysicsTerm *term = nullptr;
+        std::vector<size_t> produced_slots;
+        std::vector<size_t> consumed_slots; // Parallel to inputs
+        std::vector<size_t> inputs;         // Producer node of each consumed key
+        std::vector<double> values;         // Cached output for the current block
+        bool valid = false;
+        bool uniform = false; // Same value at every timestep of the block
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::vector<size_t>> levels; // Topological wavefronts
+    std::vector<size_t> active_nodes;        // Node index of each requested term
+
+    void evaluateNode(Node &node, std::span<const double> ts, const ParamVector &params, size_t t_slot) const
+    {
+        std::span<double> out(node.values.data(), ts.size());
+        node.valid = node.term && node.term->validate(params);
+        if (!node.valid)
+        {
+            std::fill(out.begin(), out.end(), 0.0);
+            node.uniform = true;
+            return;
+        }
+
+        bool inputs_uniform = true;
+        for (size_t producer : node.inputs)
+        {
+            inputs_uniform = inputs_uniform && nodes[producer].uniform;
+        }
+
+        if (inputs_uniform)
+        {
+            // Produced inputs were already published into params
+            node.term->computeBatch(ts, ParamBlock{params, t_slot}, out);
+        }
+        else
+        {
+            // An input varies within the block: feed the cached per-step values
+            ParamVector local = params;
+            for (size_t i = 0; i < ts.size(); ++i)
+            {
+                for (size_t k = 0; k < node.inputs.size(); ++k)
+                {
+                    const Node &producer = nodes[node.inputs[k]];
+                    if (producer.valid)
+                        local.set(node.consumed_slots[k], producer.values[i]);
+                }
+                local.set(t_slot, ts[i]);
+                out[i] = node.term->compute(ts[i], local);
+            }
+        }
+
+        node.uniform = std::all_of(out.begin(), out.end(), [&](double v)
+                                   { return v == out.front(); });
+    }
+
+public:
+    TermGraph(PhysicsTermRegistry &registry, const std::vector<std::string> &active_terms, size_t block_size)
+    {
+        ParamSchema &schema = registry.getSchema();
+
+        // Which registered term publishes each key
+        std::unordered_map<std::string, std::string> producer_of;
+        for (const auto &name : registry.getAllTermNames())
+        {
+            for (const auto &key : registry.getTerm(name)->produces())
+            {
+                auto inserted = producer_of.emplace(key, name);
+                if (!inserted.second && inserted.first->second != name)
+                    throw std::runtime_error("Term graph: key '" + key + "' produced by both " +
+                                             inserted.first->second + " and " + name);
+            }
+        }
+
+        // Active terms first, then any producers they (transitively) need
+        std::unordered_map<std::string, size_t> index;
+        auto addNode = [&](const std::string &name)
+        {
+            auto it = index.find(name);
+            if (it != index.end())
+                return it->second;
+            Node node;
+            node.name = name;
+            node.term = registry.getTerm(name);
+            node.values.assign(block_size, 0.0);
+            nodes.push_back(std::move(node));
+            index.emplace(name, nodes.size() - 1);
+            return nodes.size() - 1;
+        };
+        for (const auto &name : active_terms)
+        {
+            active_nodes.push_back(addNode(name));
+        }
+        for (size_t n = 0; n < nodes.size(); ++n)
+        {
+            if (!nodes[n].term)
+                continue;
+            for (const auto &key : nodes[n].term->produces())
+            {
+                nodes[n].produced_slots.push_back(schema.slot(key));
+            }
+            for (const auto &key : nodes[n].term->consumes())
+            {
+                auto it = producer_of.find(key);
+                if (it == producer_of.end())
+                    continue; // Plain system parameter
+                size_t producer = addNode(it->second);
+                nodes[n].inputs.push_back(producer);
+                nodes[n].consumed_slots.push_back(schema.slot(key));
+            }
+        }
+
+        // Kahn's algorithm, grouped into levels
+        std::vector<size_t> pending(nodes.size(), 0);
+        std::vector<std::vector<size_t>> dependents(nodes.size());
+        for (size_t n = 0; n < nodes.size(); ++n)
+        {
+            for (size_t producer : nodes[n].inputs)
+            {
+                dependents[producer].push_back(n);
+                ++pending[n];
+            }
+        }
+        std::vector<size_t> frontier;
+        for (size_t n = 0; n < nodes.size(); ++n)
+        {
+            if (pending[n] == 0)
+                frontier.push_back(n);
+        }
+        size_t ordered = 0;
+        while (!frontier.empty())
+        {
+            ordered += frontier.size();
+            std::vector<size_t> next;
+            for (size_t n : frontier)
+            {
+                for (size_t d : dependents[n])
+                {
+                    if (--pending[d] == 0)
+                        next.push_back(d);
+                }
+            }
+            levels.push_back(std::move(frontier));
+            frontier = std::move(next);
+        }
+        if (ordered != nodes.size())
+        {
+            for (size_t n = 0; n < nodes.size(); ++n)
+            {
+                if (pending[n] != 0)
+                    throw std::runtime_error("Term graph: dependency cycle involving " + nodes[n].name);
+            }
+        }
+    }
+
+    // Evaluate every node over ts; params must already hold the block's system parameters
+    void evaluateBlock(std::span<const double> ts, ParamVector &params, size_t t_slot, ThreadPool *pool)
+    {
+        params.set(t_slot, ts.front());
+        const uint64_t parent_span = TraceSpan::currentId(); // Term spans nest under it on any thread
+        for (const auto &level : levels)
+        {
+            auto run = [&](size_t i)
+            {
+                Node &node = nodes[level[i]];
+                auto span = UQFFTracer::getInstance().createSpan(node.name, SpanType::PHYSICS_TERM_EVAL, parent_span);
+                evaluateNode(node, ts, params, t_slot);
+            };
+            if (pool && level.size() > 1)
+                pool->parallelFor(level.size(), run);
+            else
+                for (size_t i = 0; i < level.size(); ++i)
+                    run(i);
+
+            // Publish between levels so no worker sees a partial update
+            for (size_t n : level)
+            {
+                for (size_t slot : nodes[n].produced_slots)
+                {
+                    if (nodes[n].valid)
+                        params.set(slot, nodes[n].values[0]);
+                    else
+                        params.unset(slot);
+                }
+            }
+        }
+    }
+
+    size_t levelCount() const { return levels.size(); }
+
+    // Shortest oscillationPeriod() of any term in the graph (0 = none reported)
+    double shortestPeriod(const ParamVector &params) const
+    {
+        double shortest = 0.0;
+        for (const Node &node : nodes)
+        {
+            const double period = node.term ? node.term->oscillationPeriod(params) : 0.0;
+            if (period > 0.0 && (shortest == 0.0 || period < shortest))
+                shortest = period;
+        }
+        return shortest;
+    }
+
+    bool valid(size_t active_index) const { return nodes[active_nodes[active_index]].valid; }
+    double value(size_t active_index, size_t step) const { return nodes[active_nodes[active_index]].values[step]; }
+};
+
 // ============================================================================
 // ASTROPHYSICAL SYSTEM PARAMETERS (SGR1745 Magnetar Default)
 // ============================================================================
@@ -176,287 +803,1537 @@ struct AstrophysicalSystem
         fTRZ = 0.1;
         c_res = 3e8;
 
-        I = 1e45;
-        A = 7e22;
-        omega1 = 1e-8;
-        omega2 = 5e-9;
+        I = 1e45;
+        A = 7e22;
+        omega1 = 1e-8;
+        omega2 = 5e-9;
+
+        b = 1.0;
+        f_worm = 1.0;
+
+        H_z = 2.270e-18;
+    }
+
+    // Every numeric parameter by name (toParamMap(), setParam() and checkpoints use this list)
+    static const std::vector<std::pair<const char *, double AstrophysicalSystem::*>> &fields()
+    {
+        static const std::vector<std::pair<const char *, double AstrophysicalSystem::*>> list = {
+            {"M", &AstrophysicalSystem::M},
+            {"M_DM", &AstrophysicalSystem::M_DM},
+            {"r", &AstrophysicalSystem::r},
+            {"Rs", &AstrophysicalSystem::Rs},
+            {"Vsys", &AstrophysicalSystem::Vsys},
+            {"Bs_t", &AstrophysicalSystem::Bs_t},
+            {"Bcrit", &AstrophysicalSystem::Bcrit},
+            {"omega_s", &AstrophysicalSystem::omega_s},
+            {"vexp", &AstrophysicalSystem::vexp},
+            {"t", &AstrophysicalSystem::t},
+            {"Evac_neb", &AstrophysicalSystem::Evac_neb},
+            {"Evac_ISM", &AstrophysicalSystem::Evac_ISM},
+            {"Delta_Evac", &AstrophysicalSystem::Delta_Evac},
+            {"fDPM", &AstrophysicalSystem::fDPM},
+            {"fTHz", &AstrophysicalSystem::fTHz},
+            {"fquantum", &AstrophysicalSystem::fquantum},
+            {"fAether", &AstrophysicalSystem::fAether},
+            {"ffluid", &AstrophysicalSystem::ffluid},
+            {"freact", &AstrophysicalSystem::freact},
+            {"Fsuper", &AstrophysicalSystem::Fsuper},
+            {"UA_SCM", &AstrophysicalSystem::UA_SCM},
+            {"omega_i", &AstrophysicalSystem::omega_i},
+            {"k4_res", &AstrophysicalSystem::k4_res},
+            {"fTRZ", &AstrophysicalSystem::fTRZ},
+            {"c_res", &AstrophysicalSystem::c_res},
+            {"I", &AstrophysicalSystem::I},
+            {"A", &AstrophysicalSystem::A},
+            {"omega1", &AstrophysicalSystem::omega1},
+            {"omega2", &AstrophysicalSystem::omega2},
+            {"b", &AstrophysicalSystem::b},
+            {"f_worm", &AstrophysicalSystem::f_worm},
+            {"H_z", &AstrophysicalSystem::H_z}};
+        return list;
+    }
+
+    // Convert to parameter map for PhysicsTerm::compute()
+    std::map<std::string, double> toParamMap() const
+    {
+        std::map<std::string, double> values;
+        for (const auto &field : fields())
+        {
+            values[field.first] = this->*field.second;
+        }
+        return values;
+    }
+
+    // Set a parameter by name; false if there is no such parameter
+    bool setParam(const std::string &param, double value)
+    {
+        for (const auto &field : fields())
+        {
+            if (param == field.first)
+            {
+                this->*field.second = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Write every parameter into a slot-indexed vector (interning keys no term declared,
+    // so terms still on the std::map path see the same set as toParamMap())
+    void writeParams(ParamSchema &schema, ParamVector &params) const
+    {
+        auto values = toParamMap();
+        for (const auto &pair : values)
+        {
+            schema.slot(pair.first);
+        }
+        params.resize(schema);
+        for (const auto &pair : values)
+        {
+            params.set(pair.first, pair.second);
+        }
+    }
+};
+
+// ============================================================================
+// PARAMETER SWEEP SUPPORT
+// ============================================================================
+
+struct SweepAxis
+{
+    std::string param; // Parameter key
+    double min;
+    double max;
+    int steps; // Grid points (Cartesian sweeps); unused by Latin-hypercube sweeps
+
+    // Value of grid point k (endpoints included)
+    double at(size_t k) const
+    {
+        return steps > 1 ? min + k * ((max - min) / (steps - 1)) : min;
+    }
+};
+
+// One Latin-hypercube axis: sample i falls in stratum perm(i) of n, jittered uniformly inside it.
+// perm is a keyed Feistel bijection with cycle walking, so no permutation table is stored and
+// the design does not depend on how points are split across threads.
+class LatinHypercubeAxis
+{
+private:
+    uint64_t n;
+    uint64_t key;
+    unsigned half_bits = 1;
+
+    static uint64_t mix(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t permute(uint64_t x) const
+    {
+        const uint64_t mask = (uint64_t(1) << half_bits) - 1;
+        do
+        {
+            uint64_t left = x >> half_bits, right = x & mask;
+            for (uint64_t round = 0; round < 4; ++round)
+            {
+                uint64_t f = mix(key ^ (round << 56) ^ right) & mask;
+                uint64_t next = left ^ f;
+                left = right;
+                right = next;
+            }
+            x = (left << half_bits) | right;
+        } while (x >= n); // Cycle-walk back into [0, n)
+        return x;
+    }
+
+public:
+    LatinHypercubeAxis(size_t samples, uint64_t seed) : n(samples), key(mix(seed))
+    {
+        while ((uint64_t(1) << (2 * half_bits)) < n)
+            ++half_bits;
+    }
+
+    // Position of sample i in [0, 1)
+    double unit(size_t i) const
+    {
+        double jitter = (mix(key ^ mix(i)) >> 11) * 0x1.0p-53;
+        return (static_cast<double>(permute(i)) + jitter) / static_cast<double>(n);
+    }
+};
+
+// Bounded reorder buffer: rows finished out of order by sweep workers are written in
+// index order. A row more than `capacity` ahead of the next one to write blocks its
+// worker, so memory stays bounded however large the sweep is.
+class ReorderBuffer
+{
+private:
+    std::ostream &out;
+    std::vector<std::string> rows;
+    std::vector<unsigned char> ready;
+    size_t next = 0;
+    size_t total;
+    size_t progress_every;
+    std::mutex m;
+    std::condition_variable space;
+
+public:
+    ReorderBuffer(std::ostream &os, size_t capacity, size_t total_rows)
+        : out(os), rows(std::max<size_t>(capacity, 1)), ready(rows.size(), 0), total(total_rows),
+          progress_every(std::max<size_t>(10, total_rows / 100))
+    {
+    }
+
+    void push(size_t index, std::string row)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        space.wait(lock, [&]
+                   { return index < next + rows.size(); });
+        size_t slot = index % rows.size();
+        rows[slot] = std::move(row);
+        ready[slot] = 1;
+        if (index != next)
+            return;
+
+        while (ready[next % rows.size()])
+        {
+            slot = next % rows.size();
+            out << rows[slot];
+            rows[slot].clear();
+            ready[slot] = 0;
+            ++next;
+            if (next % progress_every == 0)
+            {
+                std::cout << "  Step " << next << "/" << total << std::endl;
+            }
+        }
+        space.notify_all();
+    }
+};
+
+// ============================================================================
+// RESULT STORE - Columnar time-series results
+// ============================================================================
+
+// Term indices ordered by name (the CSV layout); for a repeated name the last one wins
+inline std::vector<size_t> sortedTermOrder(const std::vector<std::string> &names)
+{
+    std::vector<size_t> order(names.size());
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        order[k] = k;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                     { return names[a] < names[b]; });
+    std::vector<size_t> unique;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        if (i + 1 < order.size() && names[order[i + 1]] == names[order[i]])
+            continue;
+        unique.push_back(order[i]);
+    }
+    return unique;
+}
+
+// Read-only view of consecutive result rows (a whole run or one streamed block)
+struct ResultBlock
+{
+    std::span<const double> t;
+    std::span<const double> gravity;
+    std::span<const double> resonance;
+    std::vector<std::span<const double>> terms; // One per active term, same order as the names
+
+    size_t rows() const { return t.size(); }
+};
+
+// One contiguous column per active term plus t / total_gravity / total_resonance.
+// Rows are appended a block at a time; capacity is reserved up front from the
+// expected step count so a run does not reallocate.
+class ResultStore
+{
+private:
+    std::vector<std::string> names;
+    std::vector<double> t_col;
+    std::vector<double> gravity_col;
+    std::vector<double> resonance_col;
+    std::vector<std::vector<double>> term_cols;
+
+public:
+    void reset(const std::vector<std::string> &term_names, size_t expected_rows)
+    {
+        names = term_names;
+        term_cols.assign(names.size(), {});
+        for (auto *col : {&t_col, &gravity_col, &resonance_col})
+        {
+            col->clear();
+            col->reserve(expected_rows);
+        }
+        for (auto &col : term_cols)
+        {
+            col.reserve(expected_rows);
+        }
+    }
+
+    // Append n zeroed rows; returns the index of the first one
+    size_t appendRows(size_t n)
+    {
+        size_t first = t_col.size();
+        for (auto *col : {&t_col, &gravity_col, &resonance_col})
+        {
+            col->resize(first + n, 0.0);
+        }
+        for (auto &col : term_cols)
+        {
+            col.resize(first + n, 0.0);
+        }
+        return first;
+    }
+
+    size_t rows() const { return t_col.size(); }
+    size_t termCount() const { return names.size(); }
+    bool empty() const { return t_col.empty(); }
+    const std::string &termName(size_t k) const { return names[k]; }
+
+    std::span<double> time() { return t_col; }
+    std::span<double> gravity() { return gravity_col; }
+    std::span<double> resonance() { return resonance_col; }
+    std::span<double> term(size_t k) { return term_cols[k]; }
+
+    std::span<const double> time() const { return t_col; }
+    std::span<const double> gravity() const { return gravity_col; }
+    std::span<const double> resonance() const { return resonance_col; }
+    std::span<const double> term(size_t k) const { return term_cols[k]; }
+
+    const std::vector<std::string> &termNames() const { return names; }
+    std::vector<size_t> sortedTermOrder() const { return ::sortedTermOrder(names); }
+
+    // Whole-column results (checkpoints written before the row log); reserves room for
+    // expected_rows in total
+    void restore(const uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix, size_t expected_rows)
+    {
+        reset(ckpt.getStrings(prefix + "names"), expected_rows);
+        appendRows(ckpt.doubles(prefix + "t").size());
+        ckpt.copyDoubles(prefix + "t", t_col);
+        ckpt.copyDoubles(prefix + "gravity", gravity_col);
+        ckpt.copyDoubles(prefix + "resonance", resonance_col);
+        for (size_t k = 0; k < term_cols.size(); ++k)
+        {
+            ckpt.copyDoubles(prefix + "term." + std::to_string(k), term_cols[k]);
+        }
+    }
+
+    // Row log (stored-run checkpoints): rows as t, gravity, resonance, then every term
+    size_t rowWidth() const { return 3 + term_cols.size(); }
+
+    std::vector<unsigned char> packRows(size_t first, size_t n) const
+    {
+        const size_t width = rowWidth();
+        std::vector<unsigned char> bytes(n * width * sizeof(double));
+        unsigned char *out = bytes.data();
+        auto put = [&](double v)
+        {
+            std::memcpy(out, &v, sizeof(double));
+            out += sizeof(double);
+        };
+        for (size_t r = first; r < first + n; ++r)
+        {
+            put(t_col[r]);
+            put(gravity_col[r]);
+            put(resonance_col[r]);
+            for (const auto &col : term_cols)
+                put(col[r]);
+        }
+        return bytes;
+    }
+
+    // Inverse of packRows(): append whole rows
+    void unpackRows(std::span<const unsigned char> bytes)
+    {
+        const size_t width = rowWidth();
+        const size_t n = bytes.size() / (width * sizeof(double));
+        const size_t first = appendRows(n);
+        const unsigned char *in = bytes.data();
+        auto get = [&]
+        {
+            double v;
+            std::memcpy(&v, in, sizeof(double));
+            in += sizeof(double);
+            return v;
+        };
+        for (size_t r = first; r < first + n; ++r)
+        {
+            t_col[r] = get();
+            gravity_col[r] = get();
+            resonance_col[r] = get();
+            for (auto &col : term_cols)
+                col[r] = get();
+        }
+    }
+
+    // Keep only the first n rows
+    void truncateRows(size_t n)
+    {
+        for (auto *col : {&t_col, &gravity_col, &resonance_col})
+        {
+            col->resize(std::min(n, col->size()));
+        }
+        for (auto &col : term_cols)
+        {
+            col.resize(std::min(n, col.size()));
+        }
+    }
+
+    // Drop all rows but keep the reserved capacity (streaming reuses one block)
+    void clearRows()
+    {
+        for (auto *col : {&t_col, &gravity_col, &resonance_col})
+        {
+            col->clear();
+        }
+        for (auto &col : term_cols)
+        {
+            col.clear();
+        }
+    }
+
+    ResultBlock view(size_t first, size_t n) const
+    {
+        ResultBlock block{time().subspan(first, n), gravity().subspan(first, n), resonance().subspan(first, n), {}};
+        block.terms.reserve(term_cols.size());
+        for (size_t k = 0; k < term_cols.size(); ++k)
+        {
+            block.terms.push_back(term(k).subspan(first, n));
+        }
+        return block;
+    }
+};
+
+// ============================================================================
+// RESULT SINKS - Consumers of streamed result blocks
+// ============================================================================
+
+// runTimeSeriesStreaming() pushes every block of steps through a list of sinks and
+// then discards it, so a run's memory does not grow with its length.
+class ResultSink
+{
+public:
+    virtual ~ResultSink() = default;
+    virtual void begin(const std::vector<std::string> &term_names) { (void)term_names; }
+    virtual void consume(const ResultBlock &block) = 0;
+    virtual void end() {}
+
+    // Checkpointing: sinks that accumulate something save it under `prefix`; on resume,
+    // restoreState() is called right after begin(). File sinks keep nothing, so a resumed
+    // run writes only the rows after the checkpoint.
+    virtual void saveState(uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix) const
+    {
+        (void)ckpt;
+        (void)prefix;
+    }
+    virtual bool restoreState(const uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix)
+    {
+        (void)ckpt;
+        (void)prefix;
+        return false;
+    }
+};
+
+// Streams rows to a CSV file (same layout as SimulationEngine::exportToCSV)
+class CSVSink : public ResultSink
+{
+private:
+    std::ofstream file;
+    std::vector<size_t> order;
+
+public:
+    explicit CSVSink(const std::string &filename) : file(filename)
+    {
+        if (!file.is_open())
+            throw std::runtime_error("Cannot open file " + filename);
+    }
+
+    void begin(const std::vector<std::string> &term_names) override
+    {
+        order = sortedTermOrder(term_names);
+        file << "t,total_gravity,total_resonance";
+        for (size_t k : order)
+        {
+            file << "," << term_names[k];
+        }
+        file << "\n";
+        file << std::scientific << std::setprecision(6);
+    }
+
+    void consume(const ResultBlock &block) override
+    {
+        for (size_t i = 0; i < block.rows(); ++i)
+        {
+            file << block.t[i] << ","
+                 << block.gravity[i] << ","
+                 << block.resonance[i];
+
+            for (size_t k : order)
+            {
+                file << "," << block.terms[k][i];
+            }
+            file << "\n";
+        }
+    }
+
+    void end() override { file.close(); }
+};
+
+// Streams rows to a binary columnar file (uqff_columnar.h)
+class ColumnarSink : public ResultSink
+{
+private:
+    std::string filename;
+    std::unique_ptr<uqff_columnar::Writer> writer;
+    std::vector<size_t> order;
+    std::vector<std::span<const double>> columns;
+
+public:
+    explicit ColumnarSink(const std::string &path) : filename(path) {}
+
+    void begin(const std::vector<std::string> &term_names) override
+    {
+        order = sortedTermOrder(term_names);
+        std::vector<std::string> names = {"t", "total_gravity", "total_resonance"};
+        for (size_t k : order)
+        {
+            names.push_back(term_names[k]);
+        }
+        writer = std::make_unique<uqff_columnar::Writer>(filename, names);
+    }
+
+    void consume(const ResultBlock &block) override
+    {
+        columns.assign({block.t, block.gravity, block.resonance});
+        for (size_t k : order)
+        {
+            columns.push_back(block.terms[k]);
+        }
+        writer->append(columns);
+    }
+
+    void end() override
+    {
+        if (writer)
+            writer->close();
+    }
+};
+
+// Online min / max / mean / variance per column (Welford)
+class StatsSink : public ResultSink
+{
+public:
+    struct Stats
+    {
+        size_t count = 0;
+        double min = INFINITY;
+        double max = -INFINITY;
+        double mean = 0.0;
+        double m2 = 0.0; // Sum of squared deviations from the mean
+
+        void add(double x)
+        {
+            ++count;
+            min = std::min(min, x);
+            max = std::max(max, x);
+            double delta = x - mean;
+            mean += delta / count;
+            m2 += delta * (x - mean);
+        }
+
+        double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+    };
+
+private:
+    std::vector<std::string> names; // total_gravity, total_resonance, then terms
+    std::vector<Stats> stats;
+
+public:
+    void begin(const std::vector<std::string> &term_names) override
+    {
+        names = {"total_gravity", "total_resonance"};
+        names.insert(names.end(), term_names.begin(), term_names.end());
+        stats.assign(names.size(), Stats{});
+    }
+
+    void consume(const ResultBlock &block) override
+    {
+        auto accumulate = [](Stats &s, std::span<const double> column)
+        {
+            for (double x : column)
+                s.add(x);
+        };
+        accumulate(stats[0], block.gravity);
+        accumulate(stats[1], block.resonance);
+        for (size_t k = 0; k < block.terms.size(); ++k)
+        {
+            accumulate(stats[k + 2], block.terms[k]);
+        }
+    }
+
+    const std::vector<std::string> &columnNames() const { return names; }
+    const Stats &get(size_t column) const { return stats.at(column); }
+
+    void saveState(uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix) const override
+    {
+        std::vector<uint64_t> count;
+        std::vector<double> min, max, mean, m2;
+        for (const Stats &s : stats)
+        {
+            count.push_back(s.count);
+            min.push_back(s.min);
+            max.push_back(s.max);
+            mean.push_back(s.mean);
+            m2.push_back(s.m2);
+        }
+        ckpt.addStrings(prefix + "names", names);
+        ckpt.addU64s(prefix + "count", count);
+        ckpt.addDoubles(prefix + "min", min);
+        ckpt.addDoubles(prefix + "max", max);
+        ckpt.addDoubles(prefix + "mean", mean);
+        ckpt.addDoubles(prefix + "m2", m2);
+    }
+
+    bool restoreState(const uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix) override
+    {
+        if (ckpt.getStrings(prefix + "names") != names)
+            throw std::runtime_error("StatsSink: checkpoint columns do not match the active terms");
+        const size_t n = names.size();
+        auto count = ckpt.u64s(prefix + "count");
+        std::vector<double> min(n), max(n), mean(n), m2(n);
+        ckpt.copyDoubles(prefix + "min", min);
+        ckpt.copyDoubles(prefix + "max", max);
+        ckpt.copyDoubles(prefix + "mean", mean);
+        ckpt.copyDoubles(prefix + "m2", m2);
+        if (count.size() != n)
+            throw std::runtime_error("StatsSink: checkpoint column count mismatch");
+        for (size_t c = 0; c < n; ++c)
+        {
+            stats[c] = Stats{static_cast<size_t>(count[c]), min[c], max[c], mean[c], m2[c]};
+        }
+        return true;
+    }
+
+    void print() const
+    {
+        std::cout << "\n=== Running Statistics ===" << std::endl;
+        std::cout << std::left << std::setw(40) << "Column" << std::right
+                  << std::setw(14) << "Min" << std::setw(14) << "Max"
+                  << std::setw(14) << "Mean" << std::setw(14) << "StdDev" << std::endl;
+        std::cout << std::scientific << std::setprecision(4);
+        for (size_t c = 0; c < names.size(); ++c)
+        {
+            const Stats &s = stats[c];
+            std::cout << std::left << std::setw(40) << names[c] << std::right
+                      << std::setw(14) << s.min << std::setw(14) << s.max
+                      << std::setw(14) << s.mean << std::setw(14) << std::sqrt(s.variance()) << std::endl;
+        }
+    }
+};
+
+// Initial / final state and the top-K terms by magnitude at the final time
+class SummarySink : public ResultSink
+{
+private:
+    size_t top_k;
+    std::vector<std::string> names;
+    size_t rows = 0;
+    double first_t = 0.0, first_gravity = 0.0, first_resonance = 0.0;
+    double last_t = 0.0, last_gravity = 0.0, last_resonance = 0.0;
+    std::vector<double> last_terms;
+
+public:
+    explicit SummarySink(size_t k = 5) : top_k(k) {}
+
+    void begin(const std::vector<std::string> &term_names) override
+    {
+        names = term_names;
+        rows = 0;
+        last_terms.assign(names.size(), 0.0);
+    }
+
+    void consume(const ResultBlock &block) override
+    {
+        const size_t n = block.rows();
+        if (n == 0)
+            return;
+        if (rows == 0)
+        {
+            first_t = block.t[0];
+            first_gravity = block.gravity[0];
+            first_resonance = block.resonance[0];
+        }
+        rows += n;
+        last_t = block.t[n - 1];
+        last_gravity = block.gravity[n - 1];
+        last_resonance = block.resonance[n - 1];
+        for (size_t k = 0; k < names.size(); ++k)
+        {
+            last_terms[k] = block.terms[k][n - 1];
+        }
+    }
+
+    void saveState(uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix) const override
+    {
+        const double first[3] = {first_t, first_gravity, first_resonance};
+        const double last[3] = {last_t, last_gravity, last_resonance};
+        ckpt.addStrings(prefix + "names", names);
+        ckpt.addU64(prefix + "rows", rows);
+        ckpt.addDoubles(prefix + "first", first);
+        ckpt.addDoubles(prefix + "last", last);
+        ckpt.addDoubles(prefix + "last_terms", last_terms);
+    }
+
+    bool restoreState(const uqff_checkpoint::Checkpoint &ckpt, const std::string &prefix) override
+    {
+        if (ckpt.getStrings(prefix + "names") != names)
+            throw std::runtime_error("SummarySink: checkpoint terms do not match the active terms");
+        double first[3], last[3];
+        ckpt.copyDoubles(prefix + "first", first);
+        ckpt.copyDoubles(prefix + "last", last);
+        ckpt.copyDoubles(prefix + "last_terms", last_terms);
+        rows = static_cast<size_t>(ckpt.getU64(prefix + "rows"));
+        first_t = first[0];
+        first_gravity = first[1];
+        first_resonance = first[2];
+        last_t = last[0];
+        last_gravity = last[1];
+        last_resonance = last[2];
+        return true;
+    }
+
+    void print() const
+    {
+        if (rows == 0)
+        {
+            std::cout << "No results to summarize." << std::endl;
+            return;
+        }
+
+        std::cout << "\n=== Simulation Summary ===" << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+
+        // First timestep
+        std::cout << "\nInitial State (t = " << first_t << " s):" << std::endl;
+        std::cout << "  Total Gravity: " << std::scientific << first_gravity << " m/s²" << std::endl;
+        std::cout << "  Total Resonance: " << first_resonance << " m/s²" << std::endl;
+
+        // Final timestep
+        std::cout << "\nFinal State (t = " << last_t << " s):" << std::endl;
+        std::cout << "  Total Gravity: " << last_gravity << " m/s²" << std::endl;
+        std::cout << "  Total Resonance: " << last_resonance << " m/s²" << std::endl;
+
+        // Top K contributing terms (by absolute value at final time)
+        std::vector<std::pair<std::string, double>> term_magnitudes;
+        for (size_t k : sortedTermOrder(names))
+        {
+            term_magnitudes.push_back({names[k], std::abs(last_terms[k])});
+        }
+        std::sort(term_magnitudes.begin(), term_magnitudes.end(),
+                  [](const auto &a, const auto &b)
+                  { return a.second > b.second; });
+
+        std::cout << "\nTop " << top_k << " Contributing Terms (by magnitude at final time):" << std::endl;
+        for (size_t i = 0; i < std::min(top_k, term_magnitudes.size()); ++i)
+        {
+            std::cout << "  " << (i + 1) << ". " << term_magnitudes[i].first
+                      << ": " << term_magnitudes[i].second << " m/s²" << std::endl;
+        }
+    }
+};
+
+// ============================================================================
+// SIMULATION ENGINE
+// ============================================================================
+
+// Step-size control for adaptive time series (SimulationEngine::setAdaptiveStepping)
+struct AdaptiveOptions
+{
+    double rtol = 1e-6;
+    double atol = 0.0;              // m/s^2; tolerances apply to total_gravity and total_resonance
+    double dt_min = 0.0;            // 0 = 1e-12 of the time range
+    double dt_max = 0.0;            // 0 = 1/16 of the time range
+    size_t samples_per_period = 16; // cap dt at period / this for terms reporting oscillationPeriod()
+};
+
+class SimulationEngine
+{
+private:
+    PhysicsTermRegistry &registry;
+    AstrophysicalSystem system;
+    std::vector<std::string> active_terms;
+
+    // Simulation results storage (one column per active term)
+    ResultStore results;
+
+    static constexpr size_t TIME_BLOCK = 256; // Timesteps per computeBatch() call
+
+    std::unique_ptr<ThreadPool> pool;
+
+    static constexpr size_t SWEEP_GRAIN = 64;          // Sweep points per claimed chunk
+    static constexpr size_t SWEEP_REORDER_ROWS = 4096; // Rows buffered while waiting for an earlier one
+
+    // Time-series checkpoints (enableCheckpoints()); snapshots go to a background writer
+    std::string checkpoint_path;
+    uqff_checkpoint::Interval checkpoint_interval;
+    std::unique_ptr<uqff_checkpoint::AsyncWriter> checkpoint_writer;
+
+    // Row log of a stored run: rows [0, row_log_rows) are queued for `row_log_path`,
+    // and row_log_crc is the CRC-32 of those bytes
+    std::string row_log_path;
+    size_t row_log_rows = 0;
+    uint32_t row_log_crc = 0;
+
+    // Adaptive stepping (setAdaptiveStepping()); fixed dt when empty
+    std::optional<AdaptiveOptions> adaptive;
+
+    // Step-size controller state carried from one block of intervals to the next
+    struct AdaptiveState
+    {
+        double h = 0.0;                                    // next interval width
+        double gravity = 0.0, resonance = 0.0;             // totals at the last accepted time
+        double gravity_scale = 0.0, resonance_scale = 0.0; // largest |total| so far (rtol reference)
+        size_t intervals = 0;                              // intervals evaluated per block
+    };
+
+    // Where the time loop starts: t_start / step 0, or the point a checkpoint was taken
+    struct RunPosition
+    {
+        double t;
+        size_t steps;
+        AdaptiveState adaptive;
+    };
+
+public:
+    SimulationEngine(PhysicsTermRegistry &reg, const AstrophysicalSystem &sys)
+        : registry(reg), system(sys)
+    {
+        // By default, activate all terms
+        active_terms = registry.getAllTermNames();
+        setThreads(ThreadPool::defaultThreads());
+    }
+
+    void setActiveTerms(const std::vector<std::string> &terms)
+    {
+        active_terms = terms;
+    }
+
+    // Helper threads for term graph branches and sweep points (0 = serial)
+    void setThreads(size_t threads)
+    {
+        pool = threads > 0 ? std::make_unique<ThreadPool>(threads) : nullptr;
+    }
+
+    const ResultStore &getResults() const { return results; }
+
+    // Number of steps a fixed-step run takes: t_i = t_start + i * dt for every t_i <= t_end
+    static size_t expectedSteps(double t_start, double t_end, double dt)
+    {
+        if (!(dt > 0.0) || !(t_end >= t_start))
+            return 0;
+        double n = std::floor((t_end - t_start) / dt);
+        if (!(n < 1e15))
+            return 0;
+        // The division can be one off either way; settle it with the loop's own expression
+        size_t steps = static_cast<size_t>(n) + 1;
+        while (t_start + static_cast<double>(steps) * dt <= t_end)
+            ++steps;
+        while (steps > 1 && t_start + static_cast<double>(steps - 1) * dt > t_end)
+            --steps;
+        return steps;
+    }
+
+    // Choose the sample times by error control instead of a fixed dt; dt passed to
+    // runTimeSeries() / runTimeSeriesStreaming() then only sets the first step
+    void setAdaptiveStepping(const AdaptiveOptions &options) { adaptive = options; }
+    void setFixedStepping() { adaptive.reset(); }
+
+    void runTimeSeries(double t_start, double t_end, double dt, bool verbose = false)
+    {
+        const size_t steps = adaptive ? TIME_BLOCK : expectedSteps(t_start, t_end, dt);
+        results.reset(active_terms, steps < 1000000000 ? steps : 0);
+        row_log_path.clear();
+        simulate(t_start, t_end, dt, verbose, results, nullptr, {t_start, 0, {}});
+    }
+
+    // Streaming variant: each block of steps is pushed through the sinks and then dropped,
+    // so memory stays at one block however long the run is. Stored results are cleared.
+    void runTimeSeriesStreaming(double t_start, double t_end, double dt,
+                                const std::vector<ResultSink *> &sinks, bool verbose = false)
+    {
+        results.reset(active_terms, 0);
+
+        ResultStore block;
+        block.reset(active_terms, TIME_BLOCK);
+        for (ResultSink *sink : sinks)
+        {
+            sink->begin(active_terms);
+        }
+        simulate(t_start, t_end, dt, verbose, block, &sinks, {t_start, 0, {}});
+        for (ResultSink *sink : sinks)
+        {
+            sink->end();
+        }
+    }
+
+    // Checkpoint time-series runs to `path` every `every_steps` steps and/or `every_seconds`
+    // of wall time (0 = off). Snapshots are taken between blocks and written on a
+    // background thread, so the loop only pays for copying its state.
+    void enableCheckpoints(const std::string &path, uint64_t every_steps, double every_seconds = 0.0)
+    {
+        checkpoint_path = path;
+        checkpoint_interval = uqff_checkpoint::Interval(every_steps, every_seconds);
+        if (!checkpoint_writer)
+            checkpoint_writer = std::make_unique<uqff_checkpoint::AsyncWriter>();
+    }
+
+    enum class ResumeMode
+    {
+        Failed,
+        Stored,  // runTimeSeries(): results hold the whole run again
+        Streamed // runTimeSeriesStreaming(): the rows after the checkpoint went to `sinks`
+    };
+
+    // Continue a run from a checkpoint, with the saved system, active terms and time range.
+    // A streamed run needs the same sinks in the same order as the original run.
+    ResumeMode resumeTimeSeries(const std::string &path, const std::vector<ResultSink *> &sinks, bool verbose = false)
+    {
+        try
+        {
+            uqff_checkpoint::Checkpoint ckpt = uqff_checkpoint::Checkpoint::read(path);
+            if (ckpt.kind() != "SimulationEngine")
+                throw std::runtime_error(path + " was written by '" + ckpt.kind() + "', not SimulationEngine");
+
+            auto range = ckpt.doubles("run");
+            if (range.size() != 3)
+                throw std::runtime_error(path + ": bad run section");
+            const double t_start = range[0], t_end = range[1], dt = range[2];
+
+            auto param_names = ckpt.getStrings("system.param_names");
+            auto param_values = ckpt.doubles("system.param_values");
+            if (param_names.size() != param_values.size())
+                throw std::runtime_error(path + ": parameter names and values differ in length");
+            system.name = ckpt.getString("system.name");
+            for (size_t p = 0; p < param_names.size(); ++p)
+            {
+                if (!system.setParam(param_names[p], param_values[p]))
+                    std::cerr << "WARNING: checkpoint parameter " << param_names[p] << " is unknown, ignored" << std::endl;
+            }
+            active_terms = ckpt.getStrings("active_terms");
+            RunPosition from{ckpt.getDouble("position.t"), static_cast<size_t>(ckpt.getU64("position.steps")), {}};
+
+            adaptive.reset();
+            if (ckpt.has("adaptive.options"))
+            {
+                auto o = ckpt.doubles("adaptive.options");
+                auto a = ckpt.doubles("adaptive.state");
+                if (o.size() != 5 || a.size() != 6)
+                    throw std::runtime_error(path + ": bad adaptive stepping sections");
+                adaptive = AdaptiveOptions{o[0], o[1], o[2], o[3], static_cast<size_t>(o[4])};
+                from.adaptive = AdaptiveState{a[0], a[1], a[2], a[3], a[4], static_cast<size_t>(a[5])};
+            }
+
+            if (ckpt.getU64("streaming") == 0)
+            {
+                const size_t expected = adaptive ? 0 : expectedSteps(t_start, t_end, dt);
+                if (ckpt.has("results.t"))
+                {
+                    results.restore(ckpt, "results.", expected); // whole columns (older checkpoints)
+                    row_log_path.clear();
+                }
+                else
+                {
+                    restoreRowLog(ckpt, expected);
+                }
+                simulate(t_start, t_end, dt, verbose, results, nullptr, from);
+                return ResumeMode::Stored;
+            }
+
+            results.reset(active_terms, 0);
+            ResultStore block;
+            block.reset(active_terms, TIME_BLOCK);
+            for (size_t k = 0; k < sinks.size(); ++k)
+            {
+                sinks[k]->begin(active_terms);
+                sinks[k]->restoreState(ckpt, sinkPrefix(k));
+            }
+            simulate(t_start, t_end, dt, verbose, block, &sinks, from);
+            for (ResultSink *sink : sinks)
+            {
+                sink->end();
+            }
+            return ResumeMode::Streamed;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            return ResumeMode::Failed;
+        }
+    }
+
+    void exportToCSV(const std::string &filename) const
+    {
+        std::unique_ptr<CSVSink> sink;
+        try
+        {
+            sink = std::make_unique<CSVSink>(filename);
+        }
+        catch (const std::exception &)
+        {
+            std::cerr << "ERROR: Cannot open file " << filename << std::endl;
+            return;
+        }
+
+        std::cout << "\nExporting results to " << filename << "..." << std::endl;
+
+        // Same stream path as runTimeSeriesStreaming(), fed the stored run as one block
+        sink->begin(results.empty() ? std::vector<std::string>{} : results.termNames());
+        if (!results.empty())
+        {
+            sink->consume(results.view(0, results.rows()));
+        }
+        sink->end();
+
+        std::cout << "Export complete! (" << results.rows() << " rows)" << std::endl;
+    }
+
+    // Binary columnar export (see uqff_columnar.h): bit-exact values, same column order as the CSV
+    void exportToBinary(const std::string &filename) const
+    {
+        std::cout << "\nExporting results to " << filename << "..." << std::endl;
+
+        try
+        {
+            ColumnarSink sink(filename);
+            sink.begin(results.termNames());
+            sink.consume(results.view(0, results.rows()));
+            sink.end();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            return;
+        }
+        std::cout << "Export complete! (" << results.rows() << " rows, " << results.termCount() + 3 << " columns)" << std::endl;
+    }
+
+    void printSummary() const
+    {
+        SummarySink summary;
+        summary.begin(results.termNames());
+        if (!results.empty())
+        {
+            summary.consume(results.view(0, results.rows()));
+        }
+        summary.print();
+    }
+
+    void parameterSweep(const std::string &param_name,
+                        double param_min, double param_max, int num_steps,
+                        double t_eval, const std::string &output_file)
+    {
+        std::cout << "\n=== Parameter Sweep: " << param_name << " ===" << std::endl;
+        std::cout << "Range: " << param_min << " to " << param_max << " (" << num_steps << " steps)" << std::endl;
+        std::cout << "Evaluation Time: t = " << t_eval << " s" << std::endl;
+
+        runSweep({param_name}, static_cast<size_t>(std::max(num_steps, 0)),
+                 [&](size_t i, double *values)
+                 { values[0] = SweepAxis{param_name, param_min, param_max, num_steps}.at(i); },
+                 t_eval, output_file);
+    }
+
+    // Cartesian product of several parameter ranges (last axis varies fastest)
+    void parameterSweepGrid(const std::vector<SweepAxis> &axes, double t_eval, const std::string &output_file)
+    {
+        size_t total = axes.empty() ? 0 : 1;
+        std::vector<std::string> names;
+        for (const auto &axis : axes)
+        {
+            total *= static_cast<size_t>(std::max(axis.steps, 0));
+            names.push_back(axis.param);
+        }
+
+        std::cout << "\n=== Grid Parameter Sweep (" << axes.size() << " parameters, " << total << " points) ===" << std::endl;
+        for (const auto &axis : axes)
+        {
+            std::cout << "  " << axis.param << ": " << axis.min << " to " << axis.max << " (" << axis.steps << " steps)" << std::endl;
+        }
+        std::cout << "Evaluation Time: t = " << t_eval << " s" << std::endl;
+
+        runSweep(names, total,
+                 [&](size_t i, double *values)
+                 {
+                     for (size_t d = axes.size(); d-- > 0;)
+                     {
+                         size_t steps = static_cast<size_t>(axes[d].steps);
+                         values[d] = axes[d].at(i % steps);
+                         i /= steps;
+                     }
+                 },
+                 t_eval, output_file);
+    }
+
+    // Latin-hypercube sample: each axis is cut into `samples` strata, every stratum used once
+    void parameterSweepLatinHypercube(const std::vector<SweepAxis> &axes, size_t samples, uint64_t seed,
+                                      double t_eval, const std::string &output_file)
+    {
+        std::vector<std::string> names;
+        std::vector<LatinHypercubeAxis> strata;
+        for (size_t d = 0; d < axes.size(); ++d)
+        {
+            names.push_back(axes[d].param);
+            strata.emplace_back(samples, seed + 0x9E3779B97F4A7C15ull * (d + 1));
+        }
+
+        std::cout << "\n=== Latin-Hypercube Sweep (" << axes.size() << " parameters, " << samples << " samples) ===" << std::endl;
+        for (const auto &axis : axes)
+        {
+            std::cout << "  " << axis.param << ": " << axis.min << " to " << axis.max << std::endl;
+        }
+        std::cout << "Evaluation Time: t = " << t_eval << " s" << std::endl;
+
+        runSweep(names, samples,
+                 [&](size_t i, double *values)
+                 {
+                     for (size_t d = 0; d < axes.size(); ++d)
+                     {
+                         values[d] = axes[d].min + strata[d].unit(i) * (axes[d].max - axes[d].min);
+                     }
+                 },
+                 t_eval, output_file);
+    }
+
+private:
+    static std::string sinkPrefix(size_t k) { return "sink" + std::to_string(k) + "."; }
+
+    static std::string rowLogPathFor(const std::string &checkpoint) { return checkpoint + ".rows"; }
+
+    // Stored-run results from the row log named in `ckpt` (length and CRC checked)
+    void restoreRowLog(const uqff_checkpoint::Checkpoint &ckpt, size_t expected_rows)
+    {
+        const std::string log = ckpt.getString("results.row_log");
+        const uint64_t rows = ckpt.getU64("results.rows");
+        const uint32_t crc = static_cast<uint32_t>(ckpt.getU64("results.row_log_crc"));
+        results.reset(ckpt.getStrings("results.names"), std::max<size_t>(expected_rows, rows));
+
+        std::vector<unsigned char> bytes(rows * results.rowWidth() * sizeof(double));
+        std::ifstream in(log, std::ios::binary);
+        in.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!in || static_cast<size_t>(in.gcount()) != bytes.size())
+            throw std::runtime_error(log + ": row log is shorter than its checkpoint (" + std::to_string(rows) + " rows)");
+        if (uqff_checkpoint::crc32(bytes.data(), bytes.size()) != crc)
+            throw std::runtime_error(log + ": row log checksum mismatch");
+        results.unpackRows(bytes);
+
+        row_log_path = log;
+        row_log_rows = rows;
+        row_log_crc = crc;
+    }
+
+    // Everything resumeTimeSeries() needs to carry on from `at`. Stored runs queue the
+    // rows added since the previous snapshot for the row log, so a snapshot costs
+    // O(new rows) rather than O(run); streamed runs save each sink's running state.
+    uqff_checkpoint::Checkpoint snapshot(double t_start, double t_end, double dt, RunPosition at,
+                                         const ResultStore &store, const std::vector<ResultSink *> *sinks)
+    {
+        uqff_checkpoint::Checkpoint ckpt("SimulationEngine");
+        const double range[3] = {t_start, t_end, dt};
+        ckpt.addDoubles("run", range);
+        ckpt.addDouble("position.t", at.t);
+        ckpt.addU64("position.steps", at.steps);
+        if (adaptive)
+        {
+            const AdaptiveState &a = at.adaptive;
+            const double options[5] = {adaptive->rtol, adaptive->atol, adaptive->dt_min, adaptive->dt_max,
+                                       static_cast<double>(adaptive->samples_per_period)};
+            const double state[6] = {a.h, a.gravity, a.resonance, a.gravity_scale, a.resonance_scale,
+                                     static_cast<double>(a.intervals)};
+            ckpt.addDoubles("adaptive.options", options);
+            ckpt.addDoubles("adaptive.state", state);
+        }
+
+        std::vector<std::string> param_names;
+        std::vector<double> param_values;
+        for (const auto &field : AstrophysicalSystem::fields())
+        {
+            param_names.push_back(field.first);
+            param_values.push_back(system.*field.second);
+        }
+        ckpt.addString("system.name", system.name);
+        ckpt.addStrings("system.param_names", param_names);
+        ckpt.addDoubles("system.param_values", param_values);
+        ckpt.addStrings("active_terms", active_terms);
+
+        ckpt.addU64("streaming", sinks ? 1 : 0);
+        if (sinks)
+        {
+            for (size_t k = 0; k < sinks->size(); ++k)
+            {
+                (*sinks)[k]->saveState(ckpt, sinkPrefix(k));
+            }
+        }
+        else
+        {
+            const std::string log = rowLogPathFor(checkpoint_path);
+            if (log != row_log_path)
+            {
+                row_log_path = log;
+                row_log_rows = 0;
+                row_log_crc = 0;
+            }
+            std::vector<unsigned char> tail = store.packRows(row_log_rows, store.rows() - row_log_rows);
+            row_log_crc = uqff_checkpoint::crc32(tail.data(), tail.size(), row_log_crc);
+            checkpoint_writer->submitRange(log, row_log_rows * store.rowWidth() * sizeof(double), std::move(tail));
+            row_log_rows = store.rows();
+
+            ckpt.addStrings("results.names", store.termNames());
+            ckpt.addString("results.row_log", log);
+            ckpt.addU64("results.rows", row_log_rows);
+            ckpt.addU64("results.row_log_crc", row_log_crc);
+        }
+        return ckpt;
+    }
+
+    // Evaluate the graph at ts and append one row per time; returns the first new row
+    size_t evaluateRows(TermGraph &graph, std::span<const double> ts, ParamVector &params, size_t t_slot, ResultStore &store)
+    {
+        // Parameters are held fixed across the block; t is passed as an array
+        {
+            auto block_span = UQFFTracer::getInstance().createSpan("TermGraph::evaluateBlock", SpanType::SIMULATION_STEP);
+            graph.evaluateBlock(ts, params, t_slot, pool.get());
+        }
+
+        const size_t row = store.appendRows(ts.size());
+        std::copy(ts.begin(), ts.end(), store.time().begin() + row);
+        auto gravity = store.gravity().subspan(row, ts.size());
+        auto resonance = store.resonance().subspan(row, ts.size());
 
-        b = 1.0;
-        f_worm = 1.0;
+        // Gather all active terms column by column (invalid terms stay 0)
+        for (size_t k = 0; k < active_terms.size(); ++k)
+        {
+            if (!graph.valid(k))
+                continue;
 
-        H_z = 2.270e-18;
+            auto column = store.term(k).subspan(row, ts.size());
+            // Categorize by type
+            auto total = (active_terms[k].find("Resonance") != std::string::npos) ? resonance : gravity;
+            for (size_t i = 0; i < ts.size(); ++i)
+            {
+                double value = graph.value(k, i);
+                column[i] = value;
+                total[i] += value;
+            }
+        }
+        return row;
     }
 
-    // Convert to parameter map for PhysicsTerm::compute()
-    std::map<std::string, double> toParamMap() const
+    // Count, report and stream the `n` rows starting at `row`
+    void finishRows(ResultStore &store, size_t row, size_t n, size_t &step_count, bool verbose,
+                    const std::vector<ResultSink *> *sinks)
     {
-        return {
-            {"M", M},
-            {"M_DM", M_DM},
-            {"r", r},
-            {"Rs", Rs},
-            {"Vsys", Vsys},
-            {"Bs_t", Bs_t},
-            {"Bcrit", Bcrit},
-            {"omega_s", omega_s},
-            {"vexp", vexp},
-            {"t", t},
-            {"Evac_neb", Evac_neb},
-            {"Evac_ISM", Evac_ISM},
-            {"Delta_Evac", Delta_Evac},
-            {"fDPM", fDPM},
-            {"fTHz", fTHz},
-            {"fquantum", fquantum},
-            {"fAether", fAether},
-            {"ffluid", ffluid},
-            {"freact", freact},
-            {"Fsuper", Fsuper},
-            {"UA_SCM", UA_SCM},
-            {"omega_i", omega_i},
-            {"k4_res", k4_res},
-            {"fTRZ", fTRZ},
-            {"c_res", c_res},
-            {"I", I},
-            {"A", A},
-            {"omega1", omega1},
-            {"omega2", omega2},
-            {"b", b},
-            {"f_worm", f_worm},
-            {"H_z", H_z}};
-    }
-};
-
-// ============================================================================
-// SIMULATION ENGINE
-// ============================================================================
+        if (n == 0)
+            return;
 
-class SimulationEngine
-{
-private:
-    PhysicsTermRegistry &registry;
-    AstrophysicalSystem system;
-    std::vector<std::string> active_terms;
+        auto ts = store.time().subspan(row, n);
+        auto gravity = store.gravity().subspan(row, n);
+        auto resonance = store.resonance().subspan(row, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            step_count++;
 
-    // Simulation results storage
-    struct TimeStep
-    {
-        double t;
-        std::map<std::string, double> term_values;
-        double total_gravity;
-        double total_resonance;
-    };
+            if (verbose && step_count % 10 == 0)
+            {
+                std::cout << "  Step " << step_count << ": t = " << ts[i]
+                          << " s, Total Gravity = " << gravity[i]
+                          << " m/s², Total Resonance = " << resonance[i] << " m/s²" << std::endl;
+            }
+        }
 
-    std::vector<TimeStep> results;
+        // Update system time
+        system.t = ts[n - 1];
 
-public:
-    SimulationEngine(PhysicsTermRegistry &reg, const AstrophysicalSystem &sys)
-        : registry(reg), system(sys)
-    {
-        // By default, activate all terms
-        active_terms = registry.getAllTermNames();
+        if (sinks)
+        {
+            ResultBlock view = store.view(row, n);
+            for (ResultSink *sink : *sinks)
+            {
+                sink->consume(view);
+            }
+            store.clearRows();
+        }
     }
 
-    void setActiveTerms(const std::vector<std::string> &terms)
+    // Step-doubling error of one interval: how far the midpoint sample is from the
+    // straight line between the ends, over atol + rtol * (largest magnitude seen)
+    static double errorRatio(double left, double mid, double right, double scale, const AdaptiveOptions &opts)
     {
-        active_terms = terms;
+        const double error = std::abs(mid - 0.5 * (left + right));
+        const double tol = opts.atol + opts.rtol * std::max({scale, std::abs(left), std::abs(mid), std::abs(right)});
+        if (tol > 0.0)
+            return error / tol;
+        return error > 0.0 ? INFINITY : 0.0;
     }
 
-    void runTimeSeries(double t_start, double t_end, double dt, bool verbose = false)
+    // Time-series driver. Rows are appended to `store`; with sinks, each block is handed
+    // to them and the store is emptied again before the next block.
+    void simulate(double t_start, double t_end, double dt, bool verbose,
+                  ResultStore &store, const std::vector<ResultSink *> *sinks, RunPosition from)
     {
-        results.clear();
-
         std::cout << "\n=== Running Time-Series Simulation ===" << std::endl;
         std::cout << "System: " << system.name << std::endl;
         std::cout << "Time Range: " << t_start << " to " << t_end << " s (dt = " << dt << " s)" << std::endl;
+        if (adaptive)
+        {
+            std::cout << "Step Size: adaptive (rtol = " << adaptive->rtol << ", atol = " << adaptive->atol
+                      << "), dt is the first step" << std::endl;
+        }
         std::cout << "Active Terms: " << active_terms.size() << " / " << registry.getTermCount() << std::endl;
+        if (from.steps > 0)
+        {
+            std::cout << "Resuming at t = " << from.t << " s (step " << from.steps << ")" << std::endl;
+        }
         std::cout << std::endl;
 
         auto start_time = std::chrono::high_resolution_clock::now();
+        UQFFTracer &tracer = UQFFTracer::getInstance();
+        auto run_span = tracer.createSpan("SimulationEngine::runTimeSeries", SpanType::SYSTEM_CALCULATION);
+
+        // Dependency-ordered term graph; produced intermediates (aDPM, mu_s, ...) are cached per step
+        TermGraph graph(registry, active_terms, TIME_BLOCK);
+
+        // Build the flat parameter vector once; only t and produced keys change per step
+        ParamSchema &schema = registry.getSchema();
+        const size_t t_slot = schema.slot("t");
+        ParamVector params(schema);
+        system.writeParams(schema, params);
+
+        // Terms are evaluated over a block of timesteps at a time (one virtual call per term per block)
+        std::vector<double> t_block;
+        t_block.reserve(TIME_BLOCK);
+
+        size_t step_count = from.steps;
+        double t = from.t;
+        checkpoint_interval.restart(step_count);
+        auto checkpoint = [&](const AdaptiveState &state)
+        {
+            if (checkpoint_writer && checkpoint_interval.due(step_count))
+            {
+                checkpoint_writer->submit(snapshot(t_start, t_end, dt, {t, step_count, state}, store, sinks), checkpoint_path);
+            }
+        };
 
-        int step_count = 0;
-        for (double t = t_start; t <= t_end; t += dt)
+        size_t rejected = 0;
+        double h_lo = INFINITY, h_hi = 0.0;
+        if (!adaptive)
         {
-            TimeStep step;
-            step.t = t;
-            step.total_gravity = 0.0;
-            step.total_resonance = 0.0;
+            // t_i = t_start + i * dt from the integer step index, so t does not drift
+            const size_t total_steps = expectedSteps(t_start, t_end, dt);
+            while (step_count < total_steps)
+            {
+                t_block.clear();
+                for (size_t i = step_count; i < total_steps && t_block.size() < TIME_BLOCK; ++i)
+                {
+                    t_block.push_back(t_start + static_cast<double>(i) * dt);
+                }
 
-            // Update system time
-            system.t = t;
-            auto params = system.toParamMap();
+                const size_t row = evaluateRows(graph, t_block, params, t_slot, store);
+                finishRows(store, row, t_block.size(), step_count, verbose, sinks);
+                t = t_start + static_cast<double>(step_count) * dt;
+                checkpoint({});
+            }
+        }
+        else
+        {
+            // Step doubling: each interval [a, b] is sampled at its midpoint and end, and is
+            // accepted when the midpoint lies within tolerance of the chord from a to b for
+            // both totals. Intervals are evaluated a speculative block at a time; on the first
+            // rejection the rest of the block is dropped and the step shrinks.
+            const AdaptiveOptions &opts = *adaptive;
+            const double h_min = opts.dt_min > 0.0 ? opts.dt_min : (t_end - t_start) * 1e-12;
+            double h_max = opts.dt_max > 0.0 ? opts.dt_max : (t_end - t_start) / 16.0;
+            const double period = graph.shortestPeriod(params);
+            if (period > 0.0 && opts.samples_per_period > 0)
+            {
+                h_max = std::min(h_max, period / static_cast<double>(opts.samples_per_period));
+            }
+            h_max = std::max(h_max, h_min);
 
-            // Compute aDPM first (dependency for resonance terms)
-            const PhysicsTerm *aDPM_term = registry.getTerm("MUGEResonanceADPM");
-            double aDPM_value = 0.0;
-            if (aDPM_term)
+            AdaptiveState state = from.adaptive;
+            if (step_count == 0 && t_start <= t_end)
             {
-                aDPM_value = aDPM_term->compute(t, params);
-                params["aDPM"] = aDPM_value;
+                t_block.assign(1, t_start);
+                const size_t row = evaluateRows(graph, t_block, params, t_slot, store);
+                state.h = std::clamp(dt > 0.0 ? dt : h_max, h_min, h_max);
+                state.gravity = store.gravity()[row];
+                state.resonance = store.resonance()[row];
+                state.gravity_scale = std::abs(state.gravity);
+                state.resonance_scale = std::abs(state.resonance);
+                state.intervals = 4;
+                finishRows(store, row, 1, step_count, verbose, sinks);
+                t = t_start;
             }
 
-            // Compute all active terms
-            for (const auto &term_name : active_terms)
+            while (t < t_end)
             {
-                const PhysicsTerm *term = registry.getTerm(term_name);
-                if (term && term->validate(params))
+                const double h = state.h;
+                t_block.clear();
+                for (double a = t; t_block.size() < 2 * state.intervals && a < t_end;)
                 {
-                    double value = term->compute(t, params);
-                    step.term_values[term_name] = value;
-
-                    // Categorize by type
-                    if (term_name.find("Resonance") != std::string::npos)
-                    {
-                        step.total_resonance += value;
-                    }
-                    else
-                    {
-                        step.total_gravity += value;
-                    }
+                    // The last interval ends exactly on t_end
+                    const double b = (t_end - a <= 1.0001 * h) ? t_end : a + h;
+                    t_block.push_back(a + 0.5 * (b - a));
+                    t_block.push_back(b);
+                    a = b;
                 }
-                else
+                const size_t planned = t_block.size() / 2;
+
+                const size_t row = evaluateRows(graph, t_block, params, t_slot, store);
+                auto gravity = store.gravity().subspan(row, t_block.size());
+                auto resonance = store.resonance().subspan(row, t_block.size());
+
+                size_t accepted = 0;
+                double growth = 2.0;
+                double left = t;
+                for (; accepted < planned; ++accepted)
                 {
-                    step.term_values[term_name] = 0.0;
+                    const size_t mid = 2 * accepted, end = mid + 1;
+                    const double ratio = std::max(
+                        errorRatio(state.gravity, gravity[mid], gravity[end], state.gravity_scale, opts),
+                        errorRatio(state.resonance, resonance[mid], resonance[end], state.resonance_scale, opts));
+                    // Error goes as h^2, so scale h by ratio^-1/2 (with a safety margin)
+                    growth = ratio > 0.0 ? std::clamp(0.9 / std::sqrt(ratio), 0.2, 2.0) : 2.0;
+                    if (ratio > 1.0 && h > h_min)
+                        break;
+
+                    h_lo = std::min(h_lo, t_block[end] - left);
+                    h_hi = std::max(h_hi, t_block[end] - left);
+                    left = t_block[end];
+                    state.gravity = gravity[end];
+                    state.resonance = resonance[end];
+                    state.gravity_scale = std::max({state.gravity_scale, std::abs(gravity[mid]), std::abs(gravity[end])});
+                    state.resonance_scale = std::max({state.resonance_scale, std::abs(resonance[mid]), std::abs(resonance[end])});
                 }
-            }
 
-            results.push_back(step);
-            step_count++;
+                if (accepted < planned)
+                    ++rejected;
+                state.h = std::clamp(h * growth, h_min, h_max);
+                state.intervals = accepted == planned ? std::min(2 * state.intervals, TIME_BLOCK / 2)
+                                                      : std::max<size_t>(1, state.intervals / 2);
 
-            if (verbose && step_count % 10 == 0)
-            {
-                std::cout << "  Step " << step_count << ": t = " << t
-                          << " s, Total Gravity = " << step.total_gravity
-                          << " m/s², Total Resonance = " << step.total_resonance << " m/s²" << std::endl;
+                store.truncateRows(row + 2 * accepted);
+                finishRows(store, row, 2 * accepted, step_count, verbose, sinks);
+                t = left;
+                checkpoint(state);
             }
         }
 
+        if (checkpoint_writer)
+        {
+            checkpoint_writer->flush();
+            std::string error = checkpoint_writer->takeError();
+            if (!error.empty())
+                std::cerr << "ERROR: " << error << std::endl;
+        }
+
+        if (run_span)
+        {
+            run_span->setAttribute("system", system.name);
+            run_span->setAttribute("steps", static_cast<int>(step_count));
+            run_span->setAttribute("terms", static_cast<int>(active_terms.size()));
+            run_span->end();
+        }
+
         auto end_time = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
         std::cout << "\nSimulation Complete!" << std::endl;
         std::cout << "  Total Steps: " << step_count << std::endl;
+        if (adaptive && h_hi > 0.0)
+        {
+            std::cout << "  Step Size: " << h_lo << " to " << h_hi << " s (" << rejected << " rejected blocks)" << std::endl;
+        }
         std::cout << "  Execution Time: " << duration.count() << " ms" << std::endl;
     }
 
-    void exportToCSV(const std::string &filename) const
+    // Evaluate the active terms at n sweep points; point(i, values) fills one value per swept parameter.
+    // Points are claimed by the pool in index-ordered chunks; rows reach the file in index order.
+    void runSweep(const std::vector<std::string> &names, size_t n,
+                  const std::function<void(size_t, double *)> &point,
+                  double t_eval, const std::string &output_file)
     {
-        std::ofstream file(filename);
+        std::ofstream file(output_file);
         if (!file.is_open())
         {
-            std::cerr << "ERROR: Cannot open file " << filename << std::endl;
+            std::cerr << "ERROR: Cannot open file " << output_file << std::endl;
             return;
         }
-
-        std::cout << "\nExporting results to " << filename << "..." << std::endl;
-
-        // Write header
-        file << "t,total_gravity,total_resonance";
-        if (!results.empty())
+        for (const auto &name : names)
         {
-            for (const auto &pair : results[0].term_values)
-            {
-                file << "," << pair.first;
-            }
+            file << name << ",";
         }
-        file << "\n";
+        file << "total_gravity,total_resonance\n";
 
-        // Write data
-        for (const auto &step : results)
+        // Per-thread scratch: parameter vector, term graph (its node caches are mutable) and point
+        const size_t parts = pool ? pool->concurrency() : 1;
+        struct Scratch
         {
-            file << std::scientific << std::setprecision(6)
-                 << step.t << ","
-                 << step.total_gravity << ","
-                 << step.total_resonance;
-
-            for (const auto &pair : step.term_values)
-            {
-                file << "," << pair.second;
-            }
-            file << "\n";
-        }
-
-        file.close();
-        std::cout << "Export complete! (" << results.size() << " rows)" << std::endl;
-    }
-
-    void printSummary() const
-    {
-        if (results.empty())
+            TermGraph graph;
+            ParamVector params;
+            std::vector<double> values;
+        };
+        std::vector<std::unique_ptr<Scratch>> scratch;
+        for (size_t p = 0; p < parts; ++p)
         {
-            std::cout << "No results to summarize." << std::endl;
-            return;
+            scratch.push_back(std::make_unique<Scratch>(Scratch{TermGraph(registry, active_terms, 1), ParamVector(), std::vector<double>(names.size())}));
         }
 
-        std::cout << "\n=== Simulation Summary ===" << std::endl;
-        std::cout << std::fixed << std::setprecision(3);
-
-        // First timestep
-        std::cout << "\nInitial State (t = " << results.front().t << " s):" << std::endl;
-        std::cout << "  Total Gravity: " << std::scientific << results.front().total_gravity << " m/s²" << std::endl;
-        std::cout << "  Total Resonance: " << results.front().total_resonance << " m/s²" << std::endl;
-
-        // Final timestep
-        std::cout << "\nFinal State (t = " << results.back().t << " s):" << std::endl;
-        std::cout << "  Total Gravity: " << results.back().total_gravity << " m/s²" << std::endl;
-        std::cout << "  Total Resonance: " << results.back().total_resonance << " m/s²" << std::endl;
-
-        // Top 5 contributing terms (by absolute value at final time)
-        std::vector<std::pair<std::string, double>> term_magnitudes;
-        for (const auto &pair : results.back().term_values)
+        // Intern every slot before the vectors are sized
+        ParamSchema &schema = registry.getSchema();
+        const size_t t_slot = schema.slot("t");
+        std::vector<size_t> sweep_slots;
+        for (const auto &name : names)
         {
-            term_magnitudes.push_back({pair.first, std::abs(pair.second)});
+            sweep_slots.push_back(schema.slot(name));
         }
-        std::sort(term_magnitudes.begin(), term_magnitudes.end(),
-                  [](const auto &a, const auto &b)
-                  { return a.second > b.second; });
-
-        std::cout << "\nTop 5 Contributing Terms (by magnitude at final time):" << std::endl;
-        for (size_t i = 0; i < std::min(size_t(5), term_magnitudes.size()); ++i)
+        ParamVector base(schema);
+        system.writeParams(schema, base);
+        for (auto &s : scratch)
         {
-            std::cout << "  " << (i + 1) << ". " << term_magnitudes[i].first
-                      << ": " << term_magnitudes[i].second << " m/s²" << std::endl;
+            s->params = base;
         }
-    }
-
-    void parameterSweep(const std::string &param_name,
-                        double param_min, double param_max, int num_steps,
-                        double t_eval, const std::string &output_file)
-    {
-        std::cout << "\n=== Parameter Sweep: " << param_name << " ===" << std::endl;
-        std::cout << "Range: " << param_min << " to " << param_max << " (" << num_steps << " steps)" << std::endl;
-        std::cout << "Evaluation Time: t = " << t_eval << " s" << std::endl;
-
-        std::ofstream file(output_file);
-        file << param_name << ",total_gravity,total_resonance\n";
 
-        double param_step = (param_max - param_min) / (num_steps - 1);
+        ReorderBuffer writer(file, std::max<size_t>(SWEEP_REORDER_ROWS, 4 * SWEEP_GRAIN * parts), n);
+        const double ts[1] = {t_eval};
 
-        for (int i = 0; i < num_steps; ++i)
+        auto evaluateRange = [&](size_t part, size_t begin, size_t end)
         {
-            double param_value = param_min + i * param_step;
-
-            // Update system parameter
-            auto params = system.toParamMap();
-            params[param_name] = param_value;
-
-            // Compute aDPM dependency
-            const PhysicsTerm *aDPM_term = registry.getTerm("MUGEResonanceADPM");
-            if (aDPM_term)
+            Scratch &s = *scratch[part];
+            char line[64];
+            for (size_t i = begin; i < end; ++i)
             {
-                params["aDPM"] = aDPM_term->compute(t_eval, params);
-            }
+                point(i, s.values.data());
+                for (size_t d = 0; d < sweep_slots.size(); ++d)
+                {
+                    s.params.set(sweep_slots[d], s.values[d]);
+                }
 
-            // Compute all terms
-            double total_gravity = 0.0;
-            double total_resonance = 0.0;
+                // Compute all terms (dependencies first)
+                s.graph.evaluateBlock(ts, s.params, t_slot, nullptr);
 
-            for (const auto &term_name : active_terms)
-            {
-                const PhysicsTerm *term = registry.getTerm(term_name);
-                if (term && term->validate(params))
+                double total_gravity = 0.0;
+                double total_resonance = 0.0;
+                for (size_t k = 0; k < active_terms.size(); ++k)
                 {
-                    double value = term->compute(t_eval, params);
-                    if (term_name.find("Resonance") != std::string::npos)
+                    if (!s.graph.valid(k))
+                        continue;
+                    double value = s.graph.value(k, 0);
+                    if (active_terms[k].find("Resonance") != std::string::npos)
                     {
                         total_resonance += value;
                     }
@@ -465,15 +2342,26 @@ public:
                         total_gravity += value;
                     }
                 }
-            }
-
-            file << std::scientific << param_value << ","
-                 << total_gravity << "," << total_resonance << "\n";
 
-            if ((i + 1) % 10 == 0)
-            {
-                std::cout << "  Step " << (i + 1) << "/" << num_steps << std::endl;
+                std::string row;
+                for (double v : s.values)
+                {
+                    std::snprintf(line, sizeof(line), "%e,", v);
+                    row += line;
+                }
+                std::snprintf(line, sizeof(line), "%e,%e\n", total_gravity, total_resonance);
+                row += line;
+                writer.push(i, std::move(row));
             }
+        };
+
+        if (pool)
+        {
+            pool->parallelRanges(n, SWEEP_GRAIN, evaluateRange);
+        }
+        else
+        {
+            evaluateRange(0, 0, n);
         }
 
         file.close();
@@ -496,6 +2384,135 @@ extern void registerWolframCoreTerms_source4(PhysicsTermRegistry &registry);
 extern void registerWolframCompressedTerms_source4(PhysicsTermRegistry &registry);
 extern void registerWolframResonanceTerms_source4(PhysicsTermRegistry &registry);
 
+// ============================================================================
+// SWEEP BENCHMARK (--bench-sweep)
+// ============================================================================
+
+// CPU-bound stand-in for a registered term, so the benchmark needs no linked sources
+class SweepLoadTerm : public PhysicsTerm
+{
+private:
+    ParamSlot M_in{"M", 1.989e30};
+    int work;
+
+    double evaluate(double t, double M) const
+    {
+        double acc = 0.0;
+        for (int k = 1; k <= work; ++k)
+            acc += std::sin(1e-30 * M * k + 1e-9 * t) / k;
+        return acc;
+    }
+
+public:
+    explicit SweepLoadTerm(int iterations) : work(iterations) {}
+
+    double compute(double t, const std::map<std::string, double> &params) const override { return evaluate(t, M_in.from(params)); }
+    double compute(double t, const ParamVector &params) const override { return evaluate(t, params.get(M_in)); }
+    std::string getName() const override { return "SweepLoad"; }
+    std::string getDescription() const override { return "Synthetic sweep benchmark load"; }
+    bool validate(const std::map<std::string, double> &) const override { return true; }
+    void bindParams(ParamSchema &schema) override { schema.bind(M_in); }
+};
+
+// Serial vs pooled sweep over `points`; the two files must match byte for byte.
+// Returns false on a mismatch or when the pool falls well short of linear speedup.
+bool benchmarkSweep(size_t points)
+{
+    PhysicsTermRegistry registry;
+    registry.registerTerm(std::make_unique<SweepLoadTerm>(2000));
+    AstrophysicalSystem system("SweepBench");
+    SimulationEngine sim(registry, system);
+
+    auto timeSweep = [&](size_t threads, const std::string &file)
+    {
+        sim.setThreads(threads);
+        auto start = std::chrono::steady_clock::now();
+        sim.parameterSweep("M", 1e29, 1e31, static_cast<int>(points), 0.0, file);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto slurp = [](const std::string &file)
+    {
+        std::ifstream in(file, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    const size_t helpers = ThreadPool::defaultThreads();
+    const double serial = timeSweep(0, "sweep_bench_serial.csv");
+    const double pooled = timeSweep(helpers, "sweep_bench_pooled.csv");
+    const bool same = slurp("sweep_bench_serial.csv") == slurp("sweep_bench_pooled.csv");
+    const double speedup = serial / pooled;
+    const double participants = static_cast<double>(helpers + 1);
+
+    std::cout << "\n=== Sweep Benchmark (" << points << " points) ===" << std::endl;
+    std::cout << "  Serial:   " << serial << " s" << std::endl;
+    std::cout << "  Pooled:   " << pooled << " s (" << participants << " participants)" << std::endl;
+    std::cout << "  Speedup:  " << speedup << "x (" << 100.0 * speedup / participants << "% efficiency)" << std::endl;
+    std::cout << "  Output:   " << (same ? "identical" : "MISMATCH") << std::endl;
+    const bool scaled = speedup >= 0.5 * participants;
+    if (!scaled)
+        std::cout << "  WARNING: speedup below half the participant count" << std::endl;
+    return same && scaled;
+}
+
+// ============================================================================
+// ADAPTIVE PERIOD CHECK (--check-adaptive)
+// ============================================================================
+
+// Smooth term that reports a short period; the controller would stride over it otherwise
+class PeriodicProbeTerm : public PhysicsTerm
+{
+private:
+    double period;
+
+public:
+    explicit PeriodicProbeTerm(double p) : period(p) {}
+
+    double compute(double t, const std::map<std::string, double> &) const override { return 1e-12 * std::sin(6.283185307179586 * t / period); }
+    std::string getName() const override { return "PeriodicProbe"; }
+    std::string getDescription() const override { return "Adaptive stepping period-cap probe"; }
+    bool validate(const std::map<std::string, double> &) const override { return true; }
+    double oscillationPeriod(const ParamVector &) const override { return period; }
+};
+
+// Adaptive run with and without --profile: both must keep every step within the term's
+// period / samples_per_period and pick the same sample times
+bool checkAdaptivePeriodCap()
+{
+    const double period = 10.0;
+    AdaptiveOptions opts;
+    opts.rtol = 1e-3;
+    opts.atol = 1.0; // tolerances alone would take the largest step allowed
+    AstrophysicalSystem system("PeriodCheck");
+
+    auto sampleTimes = [&](bool profiled)
+    {
+        PhysicsTermRegistry registry;
+        if (profiled)
+            registry.enableProfiling(1.0);
+        registry.registerTerm(std::make_unique<PeriodicProbeTerm>(period));
+        SimulationEngine sim(registry, system);
+        sim.setThreads(0);
+        sim.setAdaptiveStepping(opts);
+        sim.runTimeSeries(0.0, 1000.0, 1.0);
+        auto t = sim.getResults().time();
+        return std::vector<double>(t.begin(), t.end());
+    };
+
+    const std::vector<double> plain = sampleTimes(false);
+    const std::vector<double> profiled = sampleTimes(true);
+    const double cap = period / static_cast<double>(opts.samples_per_period);
+    double widest = 0.0;
+    for (size_t i = 1; i < profiled.size(); ++i)
+        widest = std::max(widest, profiled[i] - profiled[i - 1]);
+
+    const bool capped = widest <= cap * (1.0 + 1e-9);
+    const bool same = plain == profiled;
+    std::cout << "\n=== Adaptive Period Cap ===" << std::endl;
+    std::cout << "  Widest step (profiled): " << widest << " s (cap " << cap << " s)" << std::endl;
+    std::cout << "  Sample times:           " << (same ? "identical" : "MISMATCH") << " with profiling off" << std::endl;
+    return capped && same;
+}
+
 // ============================================================================
 // MAIN SIMULATION PROGRAM
 // ============================================================================
@@ -532,9 +2549,94 @@ int main(int argc, char *argv[])
     // Create simulation engine
     SimulationEngine sim(registry, sgr1745);
 
+    // --trace <file.json>: span/event trace for chrome://tracing or ui.perfetto.dev
+    // --profile [rate]:    per-term call/latency profile (fraction of calls timed, default 0.05)
+    // --checkpoint <file> [--checkpoint-every <steps>]: checkpoint time series (default every 60 s)
+    // --resume <file>:     continue the run saved in a checkpoint before showing the menu
+    // --adaptive [rtol]:   error-controlled time steps (default rtol 1e-6); dt sets the first step
+    // --bench-sweep [n]:  time an n-point sweep serial vs pooled (default 40000) and exit
+    // --check-adaptive:   check the adaptive period cap with profiling on and off, and exit
+    std::string checkpoint_file, resume_file;
+    uint64_t checkpoint_steps = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--trace" && i + 1 < argc)
+        {
+            TRACE_INIT_CHROME("uqff_trace.log", argv[i + 1]);
+            std::cout << "Tracing to uqff_trace.log and " << argv[i + 1] << std::endl;
+        }
+        else if (arg == "--profile")
+        {
+            double rate = 0.05;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                rate = std::atof(argv[++i]);
+            registry.enableProfiling(rate);
+            std::cout << "Profiling terms (sample rate " << rate << ")" << std::endl;
+        }
+        else if (arg == "--checkpoint" && i + 1 < argc)
+        {
+            checkpoint_file = argv[++i];
+        }
+        else if (arg == "--checkpoint-every" && i + 1 < argc)
+        {
+            checkpoint_steps = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--resume" && i + 1 < argc)
+        {
+            resume_file = argv[++i];
+        }
+        else if (arg == "--adaptive")
+        {
+            AdaptiveOptions opts;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                opts.rtol = std::atof(argv[++i]);
+            sim.setAdaptiveStepping(opts);
+            std::cout << "Adaptive time steps (rtol " << opts.rtol << ")" << std::endl;
+        }
+        else if (arg == "--bench-sweep")
+        {
+            size_t points = 40000;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+                points = std::strtoull(argv[++i], nullptr, 10);
+            return benchmarkSweep(points) ? 0 : 1;
+        }
+        else if (arg == "--check-adaptive")
+        {
+            return checkAdaptivePeriodCap() ? 0 : 1;
+        }
+    }
+
+    if (!checkpoint_file.empty())
+    {
+        sim.enableCheckpoints(checkpoint_file, checkpoint_steps, checkpoint_steps ? 0.0 : 60.0);
+        std::cout << "Checkpointing time series to " << checkpoint_file << std::endl;
+    }
+
+    if (!resume_file.empty())
+    {
+        // A streamed run continues into a new file; stats and summary cover the whole run
+        ColumnarSink file_sink("simulation_results.resumed.uqcol");
+        StatsSink stats;
+        SummarySink summary;
+        switch (sim.resumeTimeSeries(resume_file, {&file_sink, &stats, &summary}, true))
+        {
+        case SimulationEngine::ResumeMode::Stored:
+            sim.printSummary();
+            break;
+        case SimulationEngine::ResumeMode::Streamed:
+            summary.print();
+            stats.print();
+            std::cout << "\nRemaining results streamed to simulation_results.resumed.uqcol" << std::endl;
+            break;
+        case SimulationEngine::ResumeMode::Failed:
+            break;
+        }
+    }
+
     // Interactive menu
     int choice = 0;
-    while (choice != 5)
+    while (choice != 6)
     {
         std::cout << "\n========================================" << std::endl;
         std::cout << "  SIMULATION MENU" << std::endl;
@@ -543,7 +2645,8 @@ int main(int argc, char *argv[])
         std::cout << "2. Parameter Sweep" << std::endl;
         std::cout << "3. View Registry" << std::endl;
         std::cout << "4. System Info" << std::endl;
-        std::cout << "5. Exit" << std::endl;
+        std::cout << "5. Multi-Parameter Sweep" << std::endl;
+        std::cout << "6. Exit" << std::endl;
         std::cout << "Enter choice: ";
         std::cin >> choice;
 
@@ -561,16 +2664,48 @@ int main(int argc, char *argv[])
             std::cout << "Time step (s): ";
             std::cin >> dt;
 
+            std::cout << "Stream to disk with bounded memory? (y/n): ";
+            char stream_choice;
+            std::cin >> stream_choice;
+            if (stream_choice == 'y' || stream_choice == 'Y')
+            {
+                // Long runs: nothing is kept in memory beyond one block of steps
+                ColumnarSink file_sink("simulation_results.uqcol");
+                StatsSink stats;
+                SummarySink summary;
+                try
+                {
+                    sim.runTimeSeriesStreaming(t_start, t_end, dt, {&file_sink, &stats, &summary}, true);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "ERROR: " << e.what() << std::endl;
+                    break;
+                }
+                summary.print();
+                stats.print();
+                std::cout << "\nResults streamed to simulation_results.uqcol" << std::endl;
+                break;
+            }
+
             sim.runTimeSeries(t_start, t_end, dt, true);
             sim.printSummary();
+            if (registry.isProfiling())
+            {
+                registry.dumpProfile();
+            }
 
-            std::cout << "\nExport to CSV? (y/n): ";
+            std::cout << "\nExport to CSV? (y/n, b = binary columnar): ";
             char export_choice;
             std::cin >> export_choice;
             if (export_choice == 'y' || export_choice == 'Y')
             {
                 sim.exportToCSV("simulation_results.csv");
             }
+            else if (export_choice == 'b' || export_choice == 'B')
+            {
+                sim.exportToBinary("simulation_results.uqcol");
+            }
             break;
         }
 
@@ -621,6 +2756,54 @@ int main(int argc, char *argv[])
         }
 
         case 5:
+        {
+            // Multi-parameter sweep (Cartesian grid or Latin hypercube)
+            int num_params = 0;
+            char mode = 'g';
+            std::vector<SweepAxis> axes;
+            double t_eval;
+
+            std::cout << "\nMulti-Parameter Sweep" << std::endl;
+            std::cout << "Number of parameters: ";
+            std::cin >> num_params;
+            std::cout << "Mode - (g)rid or (l)atin hypercube: ";
+            std::cin >> mode;
+            for (int p = 0; p < num_params; ++p)
+            {
+                SweepAxis axis{"", 0.0, 0.0, 1};
+                std::cout << "Parameter " << (p + 1) << " name: ";
+                std::cin >> axis.param;
+                std::cout << "  Min value: ";
+                std::cin >> axis.min;
+                std::cout << "  Max value: ";
+                std::cin >> axis.max;
+                if (mode != 'l' && mode != 'L')
+                {
+                    std::cout << "  Number of steps: ";
+                    std::cin >> axis.steps;
+                }
+                axes.push_back(axis);
+            }
+
+            if (mode == 'l' || mode == 'L')
+            {
+                size_t samples;
+                std::cout << "Number of samples: ";
+                std::cin >> samples;
+                std::cout << "Evaluation time (s): ";
+                std::cin >> t_eval;
+                sim.parameterSweepLatinHypercube(axes, samples, 20251129, t_eval, "parameter_sweep_lhs.csv");
+            }
+            else
+            {
+                std::cout << "Evaluation time (s): ";
+                std::cin >> t_eval;
+                sim.parameterSweepGrid(axes, t_eval, "parameter_sweep_grid.csv");
+            }
+            break;
+        }
+
+        case 6:
             std::cout << "\nExiting simulation harness. Goodbye!" << std::endl;
             break;
 
@@ -629,6 +2812,14 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (registry.isProfiling())
+    {
+        std::ofstream profile_file("term_profile.json");
+        registry.dumpProfileJSON(profile_file);
+        std::cout << "Term profile written to term_profile.json" << std::endl;
+    }
+
+    TRACE_SHUTDOWN();
     return 0;
 }
 
@@ -637,15 +2828,18 @@ int main(int argc, char *argv[])
 // ============================================================================
 /*
 STANDALONE COMPILATION (Placeholder Mode):
-    g++ -std=c++17 -O2 -o source4_simulator source4_simulation_harness.cpp
+    g++ -std=c++20 -O2 -o source4_simulator source4_simulation_harness.cpp
 
 FULL COMPILATION (with all 46 classes):
-    g++ -std=c++17 -O2 -o source4_simulator \
+    g++ -std=c++20 -O2 -mavx2 -o source4_simulator \
         source4_simulation_harness.cpp \
         source4_wolfram.cpp \
         source4_wolfram_compressed.cpp \
         source4_wolfram_resonance.cpp
 
+    -mavx2 / -mavx512f (MSVC: /arch:AVX2, /arch:AVX512) enables the SIMD
+    computeBatch() kernels (uqff_simd.h); without them the kernels run scalar.
+
 CMAKE INTEGRATION:
     Add to CMakeLists.txt:
 
@@ -671,4 +2865,33 @@ USAGE EXAMPLES:
        param_min = 1e13, param_max = 1e16 (range of magnetar fields)
        num_steps = 100
        t_eval = 1e10 s
+
+    4. Multi-parameter sweep (mass x radius x B-field, menu option 5):
+       grid: M, r, Bs_t with 100 steps each = 10^6 points, split across all cores
+       latin hypercube: same ranges, any number of samples
+
+    5. Tracing (open the JSON in chrome://tracing or ui.perfetto.dev):
+       ./source4_simulator --trace uqff_trace.json
+
+    6. Term profiling (table after each time series, term_profile.json on exit):
+       ./source4_simulator --profile 0.05
+
+    7. Checkpoint / restart of long time series (written in the background):
+       ./source4_simulator --checkpoint run.uqckpt --checkpoint-every 100000
+       ./source4_simulator --resume run.uqckpt
+       Stored runs keep their rows in run.uqckpt.rows next to the checkpoint
+       Same for the 2D quasar jet in source4.cpp:
+       ./source4 --jet-steps 5000 --checkpoint jet.uqckpt --checkpoint-every 500
+       ./source4 --jet-steps 10000 --resume jet.uqckpt
+
+    8. Adaptive time steps (step doubling on total gravity / resonance):
+       ./source4_simulator --adaptive 1e-6
+       dt entered in the menu is only the first step; the step grows where the
+       totals are smooth and shrinks around oscillating terms
+
+    9. Sweep scaling check (serial vs all cores, outputs compared):
+       ./source4_simulator --bench-sweep 40000
+
+    10. Adaptive period cap with profiling wrappers in place:
+       ./source4_simulator --check-adaptive
 */
@@ -7,7 +7,18 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <vector>
 #include <memory>
+#include <span>
+#include <algorithm>
+#include "uqff_param_schema.h"
+#include "uqff_simd.h"
+
+// Period of the cos(PI*tn) factor: tn falls back to t when not supplied, giving a 2 s cycle
+inline double tnCyclePeriod(const ParamVector &params, const ParamSlot &tn)
+{
+    return params.has(tn.index) ? 0.0 : 2.0;
+}
 
 // ============================================================================
 // UNIVERSAL GRAVITY COMPONENTS (Ug1-Ug4)
@@ -20,19 +31,54 @@ private:
     double alpha = 0.001;
     double delta_def = 0.01;
 
+    ParamSlot mu_s_in{"mu_s", 1e20};
+    ParamSlot grad_Ms_r_in{"grad_Ms_r", 1e-5};
+    ParamSlot tn_in{"tn", 0.0}; // Missing tn falls back to t
+
+    double evaluate(double t, double mu_s, double grad_Ms_r, double tn) const
+    {
+        double defect = 1.0 + delta_def * std::sin(0.001 * t);
+        return k1 * mu_s * grad_Ms_r * std::exp(-alpha * t) * std::cos(M_PI * tn) * defect;
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(mu_s_in, grad_Ms_r_in, tn_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_mu_s = params.find("mu_s");
-        auto it_grad = params.find("grad_Ms_r");
-        auto it_tn = params.find("tn");
+        return evaluate(t, mu_s_in.from(params), grad_Ms_r_in.from(params), tn_in.from(params, t));
+    }
 
-        double mu_s = (it_mu_s != params.end()) ? it_mu_s->second : 1e20;
-        double grad_Ms_r = (it_grad != params.end()) ? it_grad->second : 1e-5;
-        double tn = (it_tn != params.end()) ? it_tn->second : t;
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, params.get(mu_s_in), params.get(grad_Ms_r_in), params.get(tn_in, t));
+    }
 
-        double defect = 1.0 + delta_def * std::sin(0.001 * t);
-        return k1 * mu_s * grad_Ms_r * std::exp(-alpha * t) * std::cos(M_PI * tn) * defect;
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        const double scale = k1 * block.get(mu_s_in) * block.get(grad_Ms_r_in);
+        if (block.has(tn_in))
+        {
+            const double cycle = std::cos(M_PI * block.get(tn_in));
+            uqff_simd::forEachLane(t, out, [&](auto tv)
+                                   { return scale * uqff_simd::exp(-alpha * tv) * cycle *
+                                            (1.0 + delta_def * uqff_simd::sin(0.001 * tv)); });
+        }
+        else
+        {
+            uqff_simd::forEachLane(t, out, [&](auto tv)
+                                   { return scale * uqff_simd::exp(-alpha * tv) * uqff_simd::cos(M_PI * tv) *
+                                            (1.0 + delta_def * uqff_simd::sin(0.001 * tv)); });
+        }
+    }
+
+    std::vector<std::string> consumes() const override { return {"mu_s", "grad_Ms_r"}; }
+
+    // Without tn the 2 s cos(PI*t) cycle; otherwise the slow sin(0.001*t) defect
+    double oscillationPeriod(const ParamVector &params) const override
+    {
+        const double cycle = tnCyclePeriod(params, tn_in);
+        return cycle > 0.0 ? cycle : 2.0 * M_PI / 0.001;
     }
 
     std::string getName() const override { return "UniversalGravity1"; }
@@ -43,6 +89,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class UniversalGravity2Term : public PhysicsTerm
@@ -54,23 +101,37 @@ private:
     double v_sw = 5e5;
     double HSCm = 1.0;
 
+    ParamSlot QUA_in{"QUA", 1e-11};
+    ParamSlot M_in{"mass", 1e30};
+    ParamSlot r_in{"radius", 1e13};
+    ParamSlot Ereact_in{"Ereact", 1.0};
+    ParamSlot S_in{"step_function", 1.0};
+
+    double evaluate(double QUA, double M, double r, double Ereact, double S) const
+    {
+        double wind_mod = 1.0 + delta_sw * v_sw;
+        return k2 * (QA + QUA) * M / (r * r) * S * wind_mod * HSCm * Ereact;
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(QUA_in, M_in, r_in, Ereact_in, S_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_QUA = params.find("QUA");
-        auto it_M = params.find("mass");
-        auto it_r = params.find("radius");
-        auto it_Ereact = params.find("Ereact");
-        auto it_S = params.find("step_function");
+        return evaluate(QUA_in.from(params), M_in.from(params), r_in.from(params),
+                        Ereact_in.from(params), S_in.from(params));
+    }
 
-        double QUA = (it_QUA != params.end()) ? it_QUA->second : 1e-11;
-        double M = (it_M != params.end()) ? it_M->second : 1e30;
-        double r = (it_r != params.end()) ? it_r->second : 1e13;
-        double Ereact = (it_Ereact != params.end()) ? it_Ereact->second : 1.0;
-        double S = (it_S != params.end()) ? it_S->second : 1.0;
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(params.get(QUA_in), params.get(M_in), params.get(r_in),
+                        params.get(Ereact_in), params.get(S_in));
+    }
 
-        double wind_mod = 1.0 + delta_sw * v_sw;
-        return k2 * (QA + QUA) * M / (r * r) * S * wind_mod * HSCm * Ereact;
+    // No time dependence: one evaluation per block
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), compute(0.0, block.params));
     }
 
     std::string getName() const override { return "UniversalGravity2"; }
@@ -81,6 +142,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class UniversalGravity3Term : public PhysicsTerm
@@ -88,20 +150,44 @@ class UniversalGravity3Term : public PhysicsTerm
 private:
     double k3 = 1.8;
 
+    ParamSlot Bj_in{"Bj", 1e-3};
+    ParamSlot omega_s_t_in{"omega_s_t", 1e-6};
+    ParamSlot Pcore_in{"Pcore", 1e-3};
+    ParamSlot Ereact_in{"Ereact", 1.0};
+
+    double evaluate(double t, double Bj, double omega_s_t, double Pcore, double Ereact) const
+    {
+        return k3 * Bj * std::cos(omega_s_t * t * M_PI) * Pcore * Ereact;
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(Bj_in, omega_s_t_in, Pcore_in, Ereact_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_Bj = params.find("Bj");
-        auto it_omega_s_t = params.find("omega_s_t");
-        auto it_Pcore = params.find("Pcore");
-        auto it_Ereact = params.find("Ereact");
+        return evaluate(t, Bj_in.from(params), omega_s_t_in.from(params), Pcore_in.from(params), Ereact_in.from(params));
+    }
 
-        double Bj = (it_Bj != params.end()) ? it_Bj->second : 1e-3;
-        double omega_s_t = (it_omega_s_t != params.end()) ? it_omega_s_t->second : 1e-6;
-        double Pcore = (it_Pcore != params.end()) ? it_Pcore->second : 1e-3;
-        double Ereact = (it_Ereact != params.end()) ? it_Ereact->second : 1.0;
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, params.get(Bj_in), params.get(omega_s_t_in), params.get(Pcore_in), params.get(Ereact_in));
+    }
 
-        return k3 * Bj * std::cos(omega_s_t * t * M_PI) * Pcore * Ereact;
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        const double scale = k3 * block.get(Bj_in) * block.get(Pcore_in) * block.get(Ereact_in);
+        const double omega_s_t = block.get(omega_s_t_in);
+        uqff_simd::forEachLane(t, out, [&](auto tv)
+                               { return scale * uqff_simd::cos(omega_s_t * tv * M_PI); });
+    }
+
+    std::vector<std::string> consumes() const override { return {"Bj", "omega_s_t"}; }
+
+    // cos(omega_s_t * PI * t)
+    double oscillationPeriod(const ParamVector &params) const override
+    {
+        const double omega = std::abs(params.get(omega_s_t_in));
+        return omega > 0.0 ? 2.0 / omega : 0.0;
     }
 
     std::string getName() const override { return "UniversalGravity3"; }
@@ -112,6 +198,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class UniversalGravity4Term : public PhysicsTerm
@@ -123,22 +210,48 @@ private:
     double alpha = 0.001;
     double f_feedback = 0.1;
 
+    ParamSlot Mbh_in{"Mbh", 8.15e36};
+    ParamSlot dg_in{"dg", 2.55e20};
+    ParamSlot tn_in{"tn", 0.0}; // Missing tn falls back to t
+
+    double evaluate(double t, double Mbh, double dg, double tn) const
+    {
+        double decay = std::exp(-alpha * t);
+        double cycle = std::cos(M_PI * tn);
+        return k4 * rho_v * C_concentration * Mbh / dg * decay * cycle * (1 + f_feedback);
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(Mbh_in, dg_in, tn_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_Mbh = params.find("Mbh");
-        auto it_dg = params.find("dg");
-        auto it_tn = params.find("tn");
+        return evaluate(t, Mbh_in.from(params), dg_in.from(params), tn_in.from(params, t));
+    }
 
-        double Mbh = (it_Mbh != params.end()) ? it_Mbh->second : 8.15e36;
-        double dg = (it_dg != params.end()) ? it_dg->second : 2.55e20;
-        double tn = (it_tn != params.end()) ? it_tn->second : t;
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, params.get(Mbh_in), params.get(dg_in), params.get(tn_in, t));
+    }
 
-        double decay = std::exp(-alpha * t);
-        double cycle = std::cos(M_PI * tn);
-        return k4 * rho_v * C_concentration * Mbh / dg * decay * cycle * (1 + f_feedback);
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        const double scale = k4 * rho_v * C_concentration * block.get(Mbh_in) / block.get(dg_in) * (1 + f_feedback);
+        if (block.has(tn_in))
+        {
+            const double cycle = std::cos(M_PI * block.get(tn_in));
+            uqff_simd::forEachLane(t, out, [&](auto tv)
+                                   { return scale * cycle * uqff_simd::exp(-alpha * tv); });
+        }
+        else
+        {
+            uqff_simd::forEachLane(t, out, [&](auto tv)
+                                   { return scale * uqff_simd::exp(-alpha * tv) * uqff_simd::cos(M_PI * tv); });
+        }
     }
 
+    double oscillationPeriod(const ParamVector &params) const override { return tnCyclePeriod(params, tn_in); }
+
     std::string getName() const override { return "UniversalGravity4"; }
 
     std::string getDescription() const override
@@ -147,6 +260,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 // ============================================================================
@@ -161,25 +275,35 @@ private:
     double epsilon_sw = 0.001;
     double UUA = 1.0;
 
+    ParamSlot Ugi_in{"Ugi", 1.0};
+    ParamSlot Mbh_in{"Mbh", 8.15e36};
+    ParamSlot dg_in{"dg", 2.55e20};
+    ParamSlot rho_sw_in{"rho_sw", 8e-21};
+    ParamSlot tn_in{"tn", 0.0}; // Missing tn falls back to t
+
+    double evaluate(double Ugi, double Mbh, double dg, double rho_sw, double tn) const
+    {
+        double wind_mod = 1.0 + epsilon_sw * rho_sw;
+        return -beta_i * Ugi * Omega_g * Mbh / dg * wind_mod * UUA * std::cos(M_PI * tn);
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(Ugi_in, Mbh_in, dg_in, rho_sw_in, tn_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_Ugi = params.find("Ugi");
-        auto it_Mbh = params.find("Mbh");
-        auto it_dg = params.find("dg");
-        auto it_rho_sw = params.find("rho_sw");
-        auto it_tn = params.find("tn");
-
-        double Ugi = (it_Ugi != params.end()) ? it_Ugi->second : 1.0;
-        double Mbh = (it_Mbh != params.end()) ? it_Mbh->second : 8.15e36;
-        double dg = (it_dg != params.end()) ? it_dg->second : 2.55e20;
-        double rho_sw = (it_rho_sw != params.end()) ? it_rho_sw->second : 8e-21;
-        double tn = (it_tn != params.end()) ? it_tn->second : t;
+        return evaluate(Ugi_in.from(params), Mbh_in.from(params), dg_in.from(params),
+                        rho_sw_in.from(params), tn_in.from(params, t));
+    }
 
-        double wind_mod = 1.0 + epsilon_sw * rho_sw;
-        return -beta_i * Ugi * Omega_g * Mbh / dg * wind_mod * UUA * std::cos(M_PI * tn);
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(params.get(Ugi_in), params.get(Mbh_in), params.get(dg_in),
+                        params.get(rho_sw_in), params.get(tn_in, t));
     }
 
+    double oscillationPeriod(const ParamVector &params) const override { return tnCyclePeriod(params, tn_in); }
+
     std::string getName() const override { return "UniversalBuoyancy"; }
 
     std::string getDescription() const override
@@ -188,6 +312,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class UniversalMagnetismTerm : public PhysicsTerm
@@ -196,26 +321,38 @@ private:
     double gamma = 0.00005;
     double num_strings = 1e9;
 
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
-    {
-        auto it_mu_j = params.find("mu_j");
-        auto it_rj = params.find("rj");
-        auto it_PSCm = params.find("PSCm");
-        auto it_Ereact = params.find("Ereact");
-        auto it_tn = params.find("tn");
-
-        double mu_j = (it_mu_j != params.end()) ? it_mu_j->second : 1e20;
-        double rj = (it_rj != params.end()) ? it_rj->second : 1e13;
-        double PSCm = (it_PSCm != params.end()) ? it_PSCm->second : 1e-3;
-        double Ereact = (it_Ereact != params.end()) ? it_Ereact->second : 1.0;
-        double tn = (it_tn != params.end()) ? it_tn->second : t;
+    ParamSlot mu_j_in{"mu_j", 1e20};
+    ParamSlot rj_in{"rj", 1e13};
+    ParamSlot PSCm_in{"PSCm", 1e-3};
+    ParamSlot Ereact_in{"Ereact", 1.0};
+    ParamSlot tn_in{"tn", 0.0}; // Missing tn falls back to t
 
+    double evaluate(double t, double mu_j, double rj, double PSCm, double Ereact, double tn) const
+    {
         double decay = 1.0 - std::exp(-gamma * t * std::cos(M_PI * tn));
         double single = mu_j / rj * decay;
         return single * num_strings * PSCm * Ereact;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(mu_j_in, rj_in, PSCm_in, Ereact_in, tn_in); }
+
+    double compute(double t, const std::map<std::string, double> &params) const override
+    {
+        return evaluate(t, mu_j_in.from(params), rj_in.from(params), PSCm_in.from(params),
+                        Ereact_in.from(params), tn_in.from(params, t));
+    }
+
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, params.get(mu_j_in), params.get(rj_in), params.get(PSCm_in),
+                        params.get(Ereact_in), params.get(tn_in, t));
+    }
+
+    std::vector<std::string> consumes() const override { return {"mu_j"}; }
+
+    double oscillationPeriod(const ParamVector &params) const override { return tnCyclePeriod(params, tn_in); }
+
     std::string getName() const override { return "UniversalMagnetism"; }
 
     std::string getDescription() const override
@@ -224,6 +361,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class UniversalAetherTerm : public PhysicsTerm
@@ -232,17 +370,30 @@ private:
     double eta = 1e-22;
     double Ts00 = 1.27e3 + 1.11e7;
 
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
-    {
-        auto it_tn = params.find("tn");
-        double tn = (it_tn != params.end()) ? it_tn->second : t;
+    ParamSlot tn_in{"tn", 0.0}; // Missing tn falls back to t
 
+    double evaluate(double tn) const
+    {
         double mod = eta * Ts00 * std::cos(M_PI * tn);
         // Return trace of perturbed metric: (1+mod) + (-1+mod) + (-1+mod) + (-1+mod) = -2 + 4*mod
         return -2.0 + 4.0 * mod;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(tn_in); }
+
+    double compute(double t, const std::map<std::string, double> &params) const override
+    {
+        return evaluate(tn_in.from(params, t));
+    }
+
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(params.get(tn_in, t));
+    }
+
+    double oscillationPeriod(const ParamVector &params) const override { return tnCyclePeriod(params, tn_in); }
+
     std::string getName() const override { return "UniversalAether"; }
 
     std::string getDescription() const override
@@ -251,26 +402,30 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class UnifiedFieldTerm : public PhysicsTerm
 {
+private:
+    // This would combine Ug1-4, Ubi1-4, Um, and A_mu_nu
+    // For simplicity, return sum of parameter "sum_Ugi", "sum_Ubi", "Um", "A_scalar"
+    ParamSlot sum_Ugi_in{"sum_Ugi", 0.0};
+    ParamSlot sum_Ubi_in{"sum_Ubi", 0.0};
+    ParamSlot Um_in{"Um", 0.0};
+    ParamSlot A_scalar_in{"A_scalar", 0.0};
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(sum_Ugi_in, sum_Ubi_in, Um_in, A_scalar_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        // This would combine Ug1-4, Ubi1-4, Um, and A_mu_nu
-        // For simplicity, return sum of parameter "sum_Ugi", "sum_Ubi", "Um", "A_scalar"
-        auto it_Ugi = params.find("sum_Ugi");
-        auto it_Ubi = params.find("sum_Ubi");
-        auto it_Um = params.find("Um");
-        auto it_A = params.find("A_scalar");
-
-        double sum_Ugi = (it_Ugi != params.end()) ? it_Ugi->second : 0.0;
-        double sum_Ubi = (it_Ubi != params.end()) ? it_Ubi->second : 0.0;
-        double Um = (it_Um != params.end()) ? it_Um->second : 0.0;
-        double A_scalar = (it_A != params.end()) ? it_A->second : 0.0;
+        return sum_Ugi_in.from(params) + sum_Ubi_in.from(params) + Um_in.from(params) + A_scalar_in.from(params);
+    }
 
-        return sum_Ugi + sum_Ubi + Um + A_scalar;
+    double compute(double t, const ParamVector &params) const override
+    {
+        return params.get(sum_Ugi_in) + params.get(sum_Ubi_in) + params.get(Um_in) + params.get(A_scalar_in);
     }
 
     std::string getName() const override { return "UnifiedField"; }
@@ -281,6 +436,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 // ============================================================================
@@ -296,44 +452,37 @@ private:
     double Lambda = 1.1e-52;
     double hbar = 1.0546e-34;
 
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    ParamSlot M_in{"mass", 1e30};
+    ParamSlot r_in{"radius", 1e4};
+    ParamSlot B_in{"B_field", 1e10};
+    ParamSlot Bcrit_in{"Bcrit", 1e11};
+    ParamSlot rho_fluid_in{"rho_fluid", 1e-15};
+    ParamSlot Vsys_in{"Vsys", 4.189e12};
+    ParamSlot g_local_in{"g_local", 10.0};
+    ParamSlot M_DM_in{"M_DM", 0.0};
+    ParamSlot delta_rho_rho_in{"delta_rho_rho", 1e-5};
+
+    // Time-invariant parts: total = base_static * (1 + H0*t) + rest
+    struct Split
     {
-        auto it_M = params.find("mass");
-        auto it_r = params.find("radius");
-        auto it_B = params.find("B_field");
-        auto it_Bcrit = params.find("Bcrit");
-        auto it_rho_fluid = params.find("rho_fluid");
-        auto it_Vsys = params.find("Vsys");
-        auto it_g_local = params.find("g_local");
-        auto it_M_DM = params.find("M_DM");
-        auto it_delta_rho = params.find("delta_rho_rho");
-
-        double M = (it_M != params.end()) ? it_M->second : 1e30;
-        double r = (it_r != params.end()) ? it_r->second : 1e4;
-        double B = (it_B != params.end()) ? it_B->second : 1e10;
-        double Bcrit = (it_Bcrit != params.end()) ? it_Bcrit->second : 1e11;
-        double rho_fluid = (it_rho_fluid != params.end()) ? it_rho_fluid->second : 1e-15;
-        double Vsys = (it_Vsys != params.end()) ? it_Vsys->second : 4.189e12;
-        double g_local = (it_g_local != params.end()) ? it_g_local->second : 10.0;
-        double M_DM = (it_M_DM != params.end()) ? it_M_DM->second : 0.0;
-        double delta_rho_rho = (it_delta_rho != params.end()) ? it_delta_rho->second : 1e-5;
+        double base_static;
+        double rest;
+    };
 
+    Split split(double M, double r, double B, double Bcrit, double rho_fluid,
+                double Vsys, double g_local, double M_DM, double delta_rho_rho) const
+    {
         // Base Newtonian
         double base = G * M / (r * r);
 
-        // Expansion factor
-        double H_tz = H0 * t;
-        double expansion = 1 + H_tz;
-
         // Superconductive adjustment
         double super_adj = 1 - B / Bcrit;
 
         // Environment factor
         double env = 1.0;
 
-        // Adjusted base
-        double adjusted_base = base * expansion * super_adj * env;
+        // Adjusted base (expansion factor applied per timestep)
+        double base_static = base * super_adj * env;
 
         // Cosmological term
         double cosm = Lambda * c * c / 3.0;
@@ -350,7 +499,45 @@ public:
         // Perturbation term
         double perturbation = (M + M_DM) * (delta_rho_rho + 3 * G * M / (r * r * r));
 
-        return adjusted_base + cosm + quantum + fluid + perturbation;
+        return {base_static, cosm + quantum + fluid + perturbation};
+    }
+
+    template <typename Params>
+    Split split(const Params &params) const
+    {
+        return split(readParam(params, M_in), readParam(params, r_in), readParam(params, B_in), readParam(params, Bcrit_in),
+                     readParam(params, rho_fluid_in), readParam(params, Vsys_in), readParam(params, g_local_in),
+                     readParam(params, M_DM_in), readParam(params, delta_rho_rho_in));
+    }
+
+    // Expansion factor 1 + H0*t applied to the adjusted base
+    template <typename T>
+    T evaluate(T t, const Split &s) const
+    {
+        return s.base_static * (1.0 + H0 * t) + s.rest;
+    }
+
+public:
+    void bindParams(ParamSchema &schema) override
+    {
+        schema.bind(M_in, r_in, B_in, Bcrit_in, rho_fluid_in, Vsys_in, g_local_in, M_DM_in, delta_rho_rho_in);
+    }
+
+    double compute(double t, const std::map<std::string, double> &params) const override
+    {
+        return evaluate(t, split(params));
+    }
+
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, split(params));
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        const Split s = split(block);
+        uqff_simd::forEachLane(t, out, [&](auto tv)
+                               { return evaluate(tv, s); });
     }
 
     std::string getName() const override { return "CompressedMUGE"; }
@@ -361,6 +548,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 // ============================================================================
@@ -386,25 +574,41 @@ private:
     double c_res = 3e8;
 
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    // Per-system inputs of the resonance equation (defaults are the SGR1745 values)
+    struct Inputs
+    {
+        double I = 1e21;
+        double A = 3.142e8;
+        double omega1 = 1e-3;
+        double omega2 = -1e-3;
+        double Vsys = 4.189e12;
+        double vexp = 1e3;
+        double ffluid = 1.269e-14;
+        double r = 1e4;
+    };
+
+private:
+    ParamSlot I_in{"I", Inputs{}.I};
+    ParamSlot A_in{"A", Inputs{}.A};
+    ParamSlot omega1_in{"omega1", Inputs{}.omega1};
+    ParamSlot omega2_in{"omega2", Inputs{}.omega2};
+    ParamSlot Vsys_in{"Vsys", Inputs{}.Vsys};
+    ParamSlot vexp_in{"vexp", Inputs{}.vexp};
+    ParamSlot ffluid_in{"ffluid", Inputs{}.ffluid};
+    ParamSlot r_in{"radius", Inputs{}.r};
+
+    // Time-invariant parts: total = constant + ug4_scale * exp(-0.0005*t) + exp_slope * t
+    struct Split
+    {
+        double constant;
+        double ug4_scale;
+        double exp_slope;
+    };
+
+    Split split(const Inputs &in) const
     {
-        auto it_I = params.find("I");
-        auto it_A = params.find("A");
-        auto it_omega1 = params.find("omega1");
-        auto it_omega2 = params.find("omega2");
-        auto it_Vsys = params.find("Vsys");
-        auto it_vexp = params.find("vexp");
-        auto it_ffluid = params.find("ffluid");
-        auto it_r = params.find("radius");
-
-        double I = (it_I != params.end()) ? it_I->second : 1e21;
-        double A = (it_A != params.end()) ? it_A->second : 3.142e8;
-        double omega1 = (it_omega1 != params.end()) ? it_omega1->second : 1e-3;
-        double omega2 = (it_omega2 != params.end()) ? it_omega2->second : -1e-3;
-        double Vsys = (it_Vsys != params.end()) ? it_Vsys->second : 4.189e12;
-        double vexp = (it_vexp != params.end()) ? it_vexp->second : 1e3;
-        double ffluid = (it_ffluid != params.end()) ? it_ffluid->second : 1.269e-14;
-        double r = (it_r != params.end()) ? it_r->second : 1e4;
+        const double I = in.I, A = in.A, omega1 = in.omega1, omega2 = in.omega2;
+        const double Vsys = in.Vsys, vexp = in.vexp, ffluid = in.ffluid, r = in.r;
 
         // 1. aDPM
         double FDPM = I * A * (omega1 - omega2);
@@ -422,9 +626,8 @@ public:
         // 5. aaether_res
         double aaether_res = UA_SCM * omega_i * fTHz * aDPM * (1 + fTRZ);
 
-        // 6. Ug4i
-        double Ereact = 1046 * std::exp(-0.0005 * t);
-        double Ug4i = k4_res * Ereact * freact * aDPM / Evac_neb * c_res;
+        // 6. Ug4i (Ereact = 1046 * exp(-0.0005 * t) applied per timestep)
+        double Ug4i_scale = k4_res * 1046 * freact * aDPM / Evac_neb * c_res;
 
         // 7. aquantum_freq
         double aquantum_freq = fquantum * Evac_neb * aDPM / Evac_ISM / c_res;
@@ -438,10 +641,9 @@ public:
         // 10. Osc_term
         double Osc_term = 0.0;
 
-        // 11. aexp_freq
+        // 11. aexp_freq (fexp = 2 * PI * H_z * t applied per timestep)
         double H_z = 2.270e-18;
-        double fexp = 2 * M_PI * H_z * t;
-        double aexp_freq = fexp * Evac_neb * aDPM / Evac_ISM / c_res;
+        double aexp_slope = 2 * M_PI * H_z * Evac_neb * aDPM / Evac_ISM / c_res;
 
         // 12. fTRZ
         double fTRZ_term = fTRZ;
@@ -451,9 +653,65 @@ public:
         double f_worm = 1.0;
         double a_wormhole = f_worm * Evac_neb / (b * b + r * r);
 
-        return aDPM + aTHz + avac_diff + asuper_freq + aaether_res + Ug4i +
-               aquantum_freq + aAether_freq + afluid_freq + Osc_term +
-               aexp_freq + fTRZ_term + a_wormhole;
+        return {aDPM + aTHz + avac_diff + asuper_freq + aaether_res +
+                    aquantum_freq + aAether_freq + afluid_freq + Osc_term +
+                    fTRZ_term + a_wormhole,
+                Ug4i_scale, aexp_slope};
+    }
+
+    template <typename T>
+    T evaluate(T t, const Split &s) const
+    {
+        return s.constant + s.ug4_scale * uqff_simd::exp(-0.0005 * t) + s.exp_slope * t;
+    }
+
+    template <typename Params>
+    Inputs readInputs(const Params &params) const
+    {
+        Inputs in;
+        in.I = readParam(params, I_in);
+        in.A = readParam(params, A_in);
+        in.omega1 = readParam(params, omega1_in);
+        in.omega2 = readParam(params, omega2_in);
+        in.Vsys = readParam(params, Vsys_in);
+        in.vexp = readParam(params, vexp_in);
+        in.ffluid = readParam(params, ffluid_in);
+        in.r = readParam(params, r_in);
+        return in;
+    }
+
+public:
+    // Closed-form evaluation shared by both compute() paths and the astrophysical system terms
+    double evaluate(double t, const Inputs &in) const
+    {
+        return evaluate(t, split(in));
+    }
+
+    void evaluateBatch(std::span<const double> t, const Inputs &in, std::span<double> out) const
+    {
+        const Split s = split(in);
+        uqff_simd::forEachLane(t, out, [&](auto tv)
+                               { return evaluate(tv, s); });
+    }
+
+    void bindParams(ParamSchema &schema) override
+    {
+        schema.bind(I_in, A_in, omega1_in, omega2_in, Vsys_in, vexp_in, ffluid_in, r_in);
+    }
+
+    double compute(double t, const std::map<std::string, double> &params) const override
+    {
+        return evaluate(t, readInputs(params));
+    }
+
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, readInputs(params));
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        evaluateBatch(t, readInputs(block), out);
     }
 
     std::string getName() const override { return "ResonanceMUGE"; }
@@ -464,6 +722,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 // ============================================================================
@@ -479,21 +738,33 @@ private:
     double B = 1e10;
     double z = 0.0009;
 
+    // Use ResonanceMUGE logic with SGR1745 parameters (fixed, so resolved once)
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    SGR1745MagnetarTerm()
+    {
+        inputs.I = I;
+        inputs.A = A;
+        inputs.r = 1e4;
+        inputs.Vsys = 4.189e12;
+        inputs.vexp = 1e3;
+    }
+
+    double compute(double t, const std::map<std::string, double> &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    double compute(double t, const ParamVector &) const override
     {
-        // Use ResonanceMUGE or CompressedMUGE logic with SGR1745 parameters
-        std::map<std::string, double> sgr_params;
-        sgr_params["I"] = I;
-        sgr_params["A"] = A;
-        sgr_params["mass"] = M;
-        sgr_params["B_field"] = B;
-        sgr_params["radius"] = 1e4;
-        sgr_params["Vsys"] = 4.189e12;
-        sgr_params["vexp"] = 1e3;
+        return resonance.evaluate(t, inputs);
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, sgr_params);
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "SGR1745Magnetar"; }
@@ -504,6 +775,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class SagittariusAStarTerm : public PhysicsTerm
@@ -513,20 +785,32 @@ private:
     double M_DM = 1e37;
     double Vsys = 3.552e45;
 
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    SagittariusAStarTerm()
+    {
+        inputs.Vsys = Vsys;
+        inputs.r = 1e12;
+        inputs.vexp = 5e6;
+        inputs.I = 1e23;
+        inputs.A = 2.813e30;
+    }
+
+    double compute(double t, const std::map<std::string, double> &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    double compute(double t, const ParamVector &) const override
     {
-        std::map<std::string, double> sagA_params;
-        sagA_params["mass"] = M;
-        sagA_params["M_DM"] = M_DM;
-        sagA_params["Vsys"] = Vsys;
-        sagA_params["radius"] = 1e12;
-        sagA_params["vexp"] = 5e6;
-        sagA_params["I"] = 1e23;
-        sagA_params["A"] = 2.813e30;
+        return resonance.evaluate(t, inputs);
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, sagA_params);
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "SagittariusAStar"; }
@@ -537,6 +821,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class TapestryStarbirthTerm : public PhysicsTerm
@@ -545,18 +830,31 @@ private:
     double M = 1.989e35;
     double Vsys = 1e53;
 
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    TapestryStarbirthTerm()
     {
-        std::map<std::string, double> tapestry_params;
-        tapestry_params["mass"] = M;
-        tapestry_params["Vsys"] = Vsys;
-        tapestry_params["radius"] = 3.086e17;
-        tapestry_params["I"] = 1e22;
-        tapestry_params["A"] = 1e35;
+        inputs.Vsys = Vsys;
+        inputs.r = 3.086e17;
+        inputs.I = 1e22;
+        inputs.A = 1e35;
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, tapestry_params);
+    double compute(double t, const std::map<std::string, double> &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    double compute(double t, const ParamVector &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "TapestryStarbirth"; }
@@ -567,22 +865,37 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class Westerlund2ClusterTerm : public PhysicsTerm
 {
+private:
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    Westerlund2ClusterTerm()
     {
-        std::map<std::string, double> west_params;
-        west_params["mass"] = 1.989e35;
-        west_params["Vsys"] = 1e53;
-        west_params["radius"] = 3.086e17;
-        west_params["I"] = 1e22;
-        west_params["A"] = 1e35;
+        inputs.Vsys = 1e53;
+        inputs.r = 3.086e17;
+        inputs.I = 1e22;
+        inputs.A = 1e35;
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, west_params);
+    double compute(double t, const std::map<std::string, double> &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    double compute(double t, const ParamVector &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "Westerlund2Cluster"; }
@@ -593,6 +906,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class PillarsCreationTerm : public PhysicsTerm
@@ -601,18 +915,31 @@ private:
     double M = 1.989e32;
     double r = 9.46e15;
 
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    PillarsCreationTerm()
+    {
+        inputs.r = r;
+        inputs.Vsys = 3.552e48;
+        inputs.I = 1e21;
+        inputs.A = 2.813e32;
+    }
+
+    double compute(double t, const std::map<std::string, double> &) const override
     {
-        std::map<std::string, double> pillars_params;
-        pillars_params["mass"] = M;
-        pillars_params["radius"] = r;
-        pillars_params["Vsys"] = 3.552e48;
-        pillars_params["I"] = 1e21;
-        pillars_params["A"] = 2.813e32;
+        return resonance.evaluate(t, inputs);
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, pillars_params);
+    double compute(double t, const ParamVector &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "PillarsCreation"; }
@@ -623,6 +950,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class RingsRelativityTerm : public PhysicsTerm
@@ -631,18 +959,31 @@ private:
     double M = 1.989e36;
     double z = 0.01;
 
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    RingsRelativityTerm()
+    {
+        inputs.r = 3.086e17;
+        inputs.Vsys = 1e54;
+        inputs.vexp = 1e5;
+        inputs.I = 1e22;
+    }
+
+    double compute(double t, const std::map<std::string, double> &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    double compute(double t, const ParamVector &) const override
     {
-        std::map<std::string, double> rings_params;
-        rings_params["mass"] = M;
-        rings_params["radius"] = 3.086e17;
-        rings_params["Vsys"] = 1e54;
-        rings_params["vexp"] = 1e5;
-        rings_params["I"] = 1e22;
+        return resonance.evaluate(t, inputs);
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, rings_params);
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "RingsRelativity"; }
@@ -653,6 +994,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class StudentGuideUniverseTerm : public PhysicsTerm
@@ -662,19 +1004,32 @@ private:
     double r = 1e26;
     double t_Hubble = 4.35e17;
 
+    ResonanceMUGETerm resonance;
+    ResonanceMUGETerm::Inputs inputs;
+
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    StudentGuideUniverseTerm()
     {
-        std::map<std::string, double> universe_params;
-        universe_params["mass"] = M;
-        universe_params["radius"] = r;
-        universe_params["Vsys"] = 1e80;
-        universe_params["vexp"] = 3e8;
-        universe_params["I"] = 1e24;
-        universe_params["A"] = 1e52;
+        inputs.r = r;
+        inputs.Vsys = 1e80;
+        inputs.vexp = 3e8;
+        inputs.I = 1e24;
+        inputs.A = 1e52;
+    }
 
-        ResonanceMUGETerm resonance;
-        return resonance.compute(t, universe_params);
+    double compute(double t, const std::map<std::string, double> &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    double compute(double t, const ParamVector &) const override
+    {
+        return resonance.evaluate(t, inputs);
+    }
+
+    void computeBatch(std::span<const double> t, const ParamBlock &, std::span<double> out) const override
+    {
+        resonance.evaluateBatch(t, inputs, out);
     }
 
     std::string getName() const override { return "StudentGuideUniverse"; }
@@ -685,6 +1040,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 // ============================================================================
@@ -704,12 +1060,18 @@ public:
     MuSTerm(double Bs_val = 1e-4, double omega_c_val = 2.7e-6, double Rs_val = 6.96e8, double SCm_val = 1e3)
         : Bs(Bs_val), omega_c(omega_c_val), Rs(Rs_val), SCm_contrib(SCm_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         double Bs_t = Bs + 0.4 * std::sin(omega_c * t) + SCm_contrib;
         return Bs_t * std::pow(Rs, 3); // A·m²
     }
 
+    std::vector<std::string> produces() const override { return {"mu_s"}; }
+    double oscillationPeriod(const ParamVector &) const override { return omega_c > 0.0 ? 2.0 * M_PI / omega_c : 0.0; }
+
     std::string getName() const override { return "MagneticDipoleMoment"; }
 
     std::string getDescription() const override
@@ -721,6 +1083,11 @@ public:
     {
         return (Rs > 0 && Bs >= 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (Rs > 0 && Bs >= 0);
+    }
 };
 
 // CLASS 3: GradMsRTerm - Surface gravity gradient
@@ -734,13 +1101,18 @@ private:
 public:
     GradMsRTerm(double Ms_val = 1.989e30, double Rs_val = 6.96e8) : Ms(Ms_val), Rs(Rs_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(); }
+    double compute(double t, const ParamVector &) const override { return evaluate(); }
+
+    double evaluate() const
     {
         if (Rs == 0.0)
             throw std::runtime_error("Division by zero in Rs");
         return G * Ms / (Rs * Rs); // Surface gravity (m/s²)
     }
 
+    std::vector<std::string> produces() const override { return {"grad_Ms_r"}; }
+
     std::string getName() const override { return "SurfaceGravityGradient"; }
 
     std::string getDescription() const override
@@ -752,6 +1124,11 @@ public:
     {
         return (Ms > 0 && Rs > 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (Ms > 0 && Rs > 0);
+    }
 };
 
 // CLASS 4: BjTerm - Magnetic string field
@@ -765,11 +1142,17 @@ public:
     BjTerm(double omega_c_val = 2.7e-6, double SCm_val = 1e3)
         : omega_c(omega_c_val), SCm_contrib(SCm_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         return 1e-3 + 0.4 * std::sin(omega_c * t) + SCm_contrib; // Tesla
     }
 
+    std::vector<std::string> produces() const override { return {"Bj"}; }
+    double oscillationPeriod(const ParamVector &) const override { return omega_c > 0.0 ? 2.0 * M_PI / omega_c : 0.0; }
+
     std::string getName() const override { return "MagneticStringField"; }
 
     std::string getDescription() const override
@@ -781,6 +1164,11 @@ public:
     {
         return true;
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // CLASS 5: OmegaSTTerm - Time-varying rotation frequency
@@ -794,11 +1182,17 @@ public:
     OmegaSTTerm(double omega_s_val = 2.7e-6, double omega_c_val = 2.7e-6)
         : omega_s(omega_s_val), omega_c(omega_c_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         return omega_s - 0.4e-6 * std::sin(omega_c * t); // rad/s
     }
 
+    std::vector<std::string> produces() const override { return {"omega_s_t"}; }
+    double oscillationPeriod(const ParamVector &) const override { return omega_c > 0.0 ? 2.0 * M_PI / omega_c : 0.0; }
+
     std::string getName() const override { return "TimeVaryingRotationFrequency"; }
 
     std::string getDescription() const override
@@ -810,6 +1204,11 @@ public:
     {
         return true;
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // CLASS 6: MuJTerm - Magnetic string dipole moment
@@ -824,13 +1223,18 @@ public:
     MuJTerm(double omega_c_val = 2.7e-6, double Rs_val = 6.96e8, double SCm_val = 1e3)
         : omega_c(omega_c_val), Rs(Rs_val), SCm_contrib(SCm_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         // Call Bj computation inline
         double Bj = 1e-3 + 0.4 * std::sin(omega_c * t) + SCm_contrib;
         return Bj * std::pow(Rs, 3); // A·m²
     }
 
+    std::vector<std::string> produces() const override { return {"mu_j"}; }
+
     std::string getName() const override { return "StringDipoleMoment"; }
 
     std::string getDescription() const override
@@ -842,6 +1246,11 @@ public:
     {
         return (Rs > 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (Rs > 0);
+    }
 };
 
 // CLASS 1: ReactorEfficiencyTerm (already exists)
@@ -850,18 +1259,26 @@ class ReactorEfficiencyTerm : public PhysicsTerm
 private:
     double kappa = 0.0005;
 
+    ParamSlot rho_SCm_in{"rho_SCm", 1e15};
+    ParamSlot v_SCm_in{"v_SCm", 0.99 * 3e8};
+    ParamSlot rho_A_in{"rho_A", 1e-23};
+
+    double evaluate(double t, double rho_SCm, double v_SCm, double rho_A) const
+    {
+        return (rho_SCm * v_SCm * v_SCm / rho_A) * std::exp(-kappa * t);
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(rho_SCm_in, v_SCm_in, rho_A_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_rho_SCm = params.find("rho_SCm");
-        auto it_v_SCm = params.find("v_SCm");
-        auto it_rho_A = params.find("rho_A");
-
-        double rho_SCm = (it_rho_SCm != params.end()) ? it_rho_SCm->second : 1e15;
-        double v_SCm = (it_v_SCm != params.end()) ? it_v_SCm->second : 0.99 * 3e8;
-        double rho_A = (it_rho_A != params.end()) ? it_rho_A->second : 1e-23;
+        return evaluate(t, rho_SCm_in.from(params), v_SCm_in.from(params), rho_A_in.from(params));
+    }
 
-        return (rho_SCm * v_SCm * v_SCm / rho_A) * std::exp(-kappa * t);
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(t, params.get(rho_SCm_in), params.get(v_SCm_in), params.get(rho_A_in));
     }
 
     std::string getName() const override { return "ReactorEfficiency"; }
@@ -872,6 +1289,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 class NavierStokesQuasarJetTerm : public PhysicsTerm
@@ -880,17 +1298,26 @@ private:
     double visc = 0.0001;
     double dt_ns = 0.1;
 
+    ParamSlot uqff_g_in{"uqff_g", 0.0};
+    ParamSlot v_jet_in{"v_jet", 0.99 * 3e8};
+
+    double evaluate(double uqff_g, double v_jet) const
+    {
+        // Simplified: return velocity change from UQFF body force
+        return dt_ns * uqff_g + v_jet / 1e10;
+    }
+
 public:
+    void bindParams(ParamSchema &schema) override { schema.bind(uqff_g_in, v_jet_in); }
+
     double compute(double t, const std::map<std::string, double> &params) const override
     {
-        auto it_uqff_g = params.find("uqff_g");
-        auto it_v_jet = params.find("v_jet");
-
-        double uqff_g = (it_uqff_g != params.end()) ? it_uqff_g->second : 0.0;
-        double v_jet = (it_v_jet != params.end()) ? it_v_jet->second : 0.99 * 3e8;
+        return evaluate(uqff_g_in.from(params), v_jet_in.from(params));
+    }
 
-        // Simplified: return velocity change from UQFF body force
-        return dt_ns * uqff_g + v_jet / 1e10;
+    double compute(double t, const ParamVector &params) const override
+    {
+        return evaluate(params.get(uqff_g_in), params.get(v_jet_in));
     }
 
     std::string getName() const override { return "NavierStokesQuasarJet"; }
@@ -901,6 +1328,7 @@ public:
     }
 
     bool validate(const std::map<std::string, double> &) const override { return true; }
+    bool validate(const ParamVector &) const override { return true; }
 };
 
 // ============================================================================
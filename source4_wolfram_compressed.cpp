@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include "uqff_param_schema.h"
 
 // ============================================================================
 // MUGE COMPRESSED COMPONENT CLASSES (9 Classes)
@@ -27,7 +28,10 @@ public:
     MUGECompressedBaseTerm(double M_val = 2.984e30, double r_val = 1e4)
         : M(M_val), r(r_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         if (r == 0.0)
             throw std::runtime_error("Division by zero in r");
@@ -45,6 +49,11 @@ public:
     {
         return (M > 0 && r > 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (M > 0 && r > 0);
+    }
 };
 
 // CLASS 16: MUGEExpansionTerm - Hubble expansion modulation
@@ -57,7 +66,10 @@ private:
 public:
     MUGEExpansionTerm(double t_val = 3.799e10) : t_sys(t_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         double H_tz = H0 * t_sys;
         return 1.0 + H_tz; // Dimensionless expansion factor
@@ -74,6 +86,11 @@ public:
     {
         return (t_sys >= 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (t_sys >= 0);
+    }
 };
 
 // CLASS 17: MUGESuperAdjustmentTerm - Superconductive magnetic field adjustment
@@ -87,7 +104,10 @@ public:
     MUGESuperAdjustmentTerm(double B_val = 1e10, double Bcrit_val = 1e11)
         : B(B_val), Bcrit(Bcrit_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         if (Bcrit == 0.0)
             throw std::runtime_error("Division by zero in Bcrit");
@@ -105,13 +125,21 @@ public:
     {
         return (Bcrit > 0 && B >= 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (Bcrit > 0 && B >= 0);
+    }
 };
 
 // CLASS 18: MUGEEnvelopeTerm - Envelope modulation (placeholder)
 class MUGEEnvelopeTerm : public PhysicsTerm
 {
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         return 1.0; // Neutral envelope (future extension point)
     }
@@ -127,13 +155,21 @@ public:
     {
         return true;
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // CLASS 19: MUGEUgSumTerm - Sum of Ug1-4 components (placeholder)
 class MUGEUgSumTerm : public PhysicsTerm
 {
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         return 0.0; // Simplified (could sum Ug1-4 if needed)
     }
@@ -149,6 +185,11 @@ public:
     {
         return true;
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // CLASS 20: MUGECosmologicalTerm - Cosmological constant contribution
@@ -159,7 +200,10 @@ private:
     static constexpr double c = 2.998e8;      // Speed of light (m/s)
 
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         return Lambda * c * c / 3.0; // m/s²
     }
@@ -175,6 +219,11 @@ public:
     {
         return true;
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // CLASS 21: MUGEQuantumTerm - Quantum uncertainty contribution
@@ -188,7 +237,10 @@ private:
     static constexpr double PI = 3.14159265358979323846;
 
 public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         if (Delta_x_p == 0.0)
             throw std::runtime_error("Division by zero in Delta_x_p");
@@ -206,6 +258,11 @@ public:
     {
         return true;
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // CLASS 22: MUGEFluidTerm - Fluid dynamics contribution (Navier-Stokes coupling)
@@ -220,7 +277,10 @@ public:
     MUGEFluidTerm(double rho_val = 1e-15, double V_val = 4.189e12, double g_val = 10.0)
         : rho_fluid(rho_val), Vsys(V_val), g_local(g_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         return rho_fluid * Vsys * g_local; // kg·m/s² (force)
     }
@@ -236,6 +296,11 @@ public:
     {
         return (rho_fluid >= 0 && Vsys > 0 && g_local >= 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (rho_fluid >= 0 && Vsys > 0 && g_local >= 0);
+    }
 };
 
 // CLASS 23: MUGEPerturbationTerm - Dark matter + density perturbation
@@ -253,7 +318,10 @@ public:
                          double delta_val = 1e-5, double r_val = 1e4)
         : M(M_val), M_DM(M_DM_val), delta_rho_rho(delta_val), r(r_val) {}
 
-    double compute(double t, const std::map<std::string, double> &params) const override
+    double compute(double t, const std::map<std::string, double> &) const override { return evaluate(t); }
+    double compute(double t, const ParamVector &) const override { return evaluate(t); }
+
+    double evaluate(double t) const
     {
         if (r == 0.0)
             throw std::runtime_error("Division by zero in r^3");
@@ -271,6 +339,11 @@ public:
     {
         return (M >= 0 && M_DM >= 0 && r > 0);
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return (M >= 0 && M_DM >= 0 && r > 0);
+    }
 };
 
 // ============================================================================
@@ -7,7 +7,12 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <vector>
 #include <memory>
+#include <span>
+#include <algorithm>
+#include "uqff_param_schema.h"
+#include "uqff_simd.h"
 
 // Constants
 const double PI = 3.141592653589793;
@@ -22,6 +27,31 @@ public:
     virtual std::string getName() const = 0;
     virtual std::string getDescription() const = 0;
     virtual bool validate(const std::map<std::string, double> &params) const = 0;
+
+    // Slot-bound interface; defaults fall back to the std::map path
+    virtual void bindParams(ParamSchema &) {}
+    virtual double compute(double t, const ParamVector &params) const { return compute(t, params.toMap()); }
+    virtual bool validate(const ParamVector &params) const { return validate(params.toMap()); }
+
+    // Batched evaluation over a block of timesteps; default loops over compute()
+    virtual void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const
+    {
+        ParamVector params = block.params;
+        for (size_t i = 0; i < t.size(); ++i)
+        {
+            if (block.t_slot != ParamSlot::UNBOUND)
+                params.set(block.t_slot, t[i]);
+            out[i] = compute(t[i], params);
+        }
+    }
+
+    // Term graph: parameter keys this term publishes its value under / reads from other terms
+    virtual std::vector<std::string> produces() const { return {}; }
+    virtual std::vector<std::string> consumes() const { return {}; }
+
+    // Shortest period (s) this term oscillates with in t at these parameters, 0 if none;
+    // adaptive time stepping keeps several samples per period
+    virtual double oscillationPeriod(const ParamVector &) const { return 0.0; }
 };
 
 // ============================================================================
@@ -30,18 +60,28 @@ public:
 
 class MUGEResonanceADPMTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot I_in{"I", 1e45};
+    ParamSlot A_in{"A", 7e22};
+    ParamSlot omega1_in{"omega1", 1e-8};
+    ParamSlot omega2_in{"omega2", 5e-9};
+    ParamSlot fDPM_in{"fDPM", 1e12};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot c_res_in{"c_res", 3e8};
+    ParamSlot Vsys_in{"Vsys", 1e56};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters with defaults from SGR1745
-        double I = params.count("I") ? params.at("I") : 1e45;
-        double A = params.count("A") ? params.at("A") : 7e22;
-        double omega1 = params.count("omega1") ? params.at("omega1") : 1e-8;
-        double omega2 = params.count("omega2") ? params.at("omega2") : 5e-9;
-        double fDPM = params.count("fDPM") ? params.at("fDPM") : 1e12;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
-        double Vsys = params.count("Vsys") ? params.at("Vsys") : 1e56;
+        double I = readParam(params, I_in);
+        double A = readParam(params, A_in);
+        double omega1 = readParam(params, omega1_in);
+        double omega2 = readParam(params, omega2_in);
+        double fDPM = readParam(params, fDPM_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double c_res = readParam(params, c_res_in);
+        double Vsys = readParam(params, Vsys_in);
 
         // Compute FDPM = I * A * (omega1 - omega2)
         double FDPM = I * A * (omega1 - omega2);
@@ -52,6 +92,21 @@ public:
         return aDPM;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(I_in, A_in, omega1_in, omega2_in, fDPM_in, Evac_neb_in, c_res_in, Vsys_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    // Published for the other resonance terms (computed once per step by the term graph)
+    std::vector<std::string> produces() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceADPM";
@@ -62,10 +117,15 @@ public:
         return "Base DPM acceleration: aDPM = FDPM * fDPM * Evac_neb * c_res * Vsys, where FDPM = I * A * (omega1 - omega2)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
     {
         return true; // All parameters have defaults
     }
+
+    bool validate(const ParamVector &) const override
+    {
+        return true;
+    }
 };
 
 // ============================================================================
@@ -74,16 +134,24 @@ public:
 
 class MUGEResonanceATHzTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot fTHz_in{"fTHz", 1e12};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot vexp_in{"vexp", 1e6};
+    ParamSlot Evac_ISM_in{"Evac_ISM", 7.09e-37};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double fTHz = params.count("fTHz") ? params.at("fTHz") : 1e12;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double vexp = params.count("vexp") ? params.at("vexp") : 1e6;
-        double Evac_ISM = params.count("Evac_ISM") ? params.at("Evac_ISM") : 7.09e-37;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double aDPM = readParam(params, aDPM_in);
+        double fTHz = readParam(params, fTHz_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double vexp = readParam(params, vexp_in);
+        double Evac_ISM = readParam(params, Evac_ISM_in);
+        double c_res = readParam(params, c_res_in);
 
         // aTHz = fTHz * Evac_neb * vexp * aDPM / (Evac_ISM * c_res)
         double aTHz = (Evac_ISM * c_res != 0.0) ? (fTHz * Evac_neb * vexp * aDPM) / (Evac_ISM * c_res) : 0.0;
@@ -91,6 +159,20 @@ public:
         return aTHz;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, fTHz_in, Evac_neb_in, vexp_in, Evac_ISM_in, c_res_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceATHz";
@@ -101,7 +183,12 @@ public:
         return "THz frequency contribution: aTHz = fTHz * Evac_neb * vexp * aDPM / (Evac_ISM * c_res)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -113,15 +200,22 @@ public:
 
 class MUGEResonanceAvacDiffTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot Delta_Evac_in{"Delta_Evac", 6.381e-36};
+    ParamSlot vexp_in{"vexp", 1e6};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double Delta_Evac = params.count("Delta_Evac") ? params.at("Delta_Evac") : 6.381e-36;
-        double vexp = params.count("vexp") ? params.at("vexp") : 1e6;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double aDPM = readParam(params, aDPM_in);
+        double Delta_Evac = readParam(params, Delta_Evac_in);
+        double vexp = readParam(params, vexp_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double c_res = readParam(params, c_res_in);
 
         // avac_diff = Delta_Evac * vexp^2 * aDPM / (Evac_neb * c_res^2)
         double avac_diff = (Evac_neb * c_res * c_res != 0.0) ? (Delta_Evac * vexp * vexp * aDPM) / (Evac_neb * c_res * c_res) : 0.0;
@@ -129,6 +223,20 @@ public:
         return avac_diff;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, Delta_Evac_in, vexp_in, Evac_neb_in, c_res_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceAvacDiff";
@@ -139,7 +247,12 @@ public:
         return "Vacuum energy differential: avac_diff = Delta_Evac * vexp^2 * aDPM / (Evac_neb * c_res^2)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -151,15 +264,22 @@ public:
 
 class MUGEResonanceASuperFreqTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot Fsuper_in{"Fsuper", 6.287e-19};
+    ParamSlot fTHz_in{"fTHz", 1e12};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double Fsuper = params.count("Fsuper") ? params.at("Fsuper") : 6.287e-19;
-        double fTHz = params.count("fTHz") ? params.at("fTHz") : 1e12;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double aDPM = readParam(params, aDPM_in);
+        double Fsuper = readParam(params, Fsuper_in);
+        double fTHz = readParam(params, fTHz_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double c_res = readParam(params, c_res_in);
 
         // asuper_freq = Fsuper * fTHz * aDPM / (Evac_neb * c_res)
         double asuper_freq = (Evac_neb * c_res != 0.0) ? (Fsuper * fTHz * aDPM) / (Evac_neb * c_res) : 0.0;
@@ -167,6 +287,20 @@ public:
         return asuper_freq;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, Fsuper_in, fTHz_in, Evac_neb_in, c_res_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceASuperFreq";
@@ -177,7 +311,12 @@ public:
         return "Superconductive frequency resonance: asuper_freq = Fsuper * fTHz * aDPM / (Evac_neb * c_res)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -189,15 +328,22 @@ public:
 
 class MUGEResonanceAAetherResTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot UA_SCM_in{"UA_SCM", 10.0};
+    ParamSlot omega_i_in{"omega_i", 1e-8};
+    ParamSlot fTHz_in{"fTHz", 1e12};
+    ParamSlot fTRZ_in{"fTRZ", 0.1};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double UA_SCM = params.count("UA_SCM") ? params.at("UA_SCM") : 10.0;
-        double omega_i = params.count("omega_i") ? params.at("omega_i") : 1e-8;
-        double fTHz = params.count("fTHz") ? params.at("fTHz") : 1e12;
-        double fTRZ = params.count("fTRZ") ? params.at("fTRZ") : 0.1;
+        double aDPM = readParam(params, aDPM_in);
+        double UA_SCM = readParam(params, UA_SCM_in);
+        double omega_i = readParam(params, omega_i_in);
+        double fTHz = readParam(params, fTHz_in);
+        double fTRZ = readParam(params, fTRZ_in);
 
         // aaether_res = UA_SCM * omega_i * fTHz * aDPM * (1 + fTRZ)
         double aaether_res = UA_SCM * omega_i * fTHz * aDPM * (1.0 + fTRZ);
@@ -205,6 +351,20 @@ public:
         return aaether_res;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, UA_SCM_in, omega_i_in, fTHz_in, fTRZ_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceAAetherRes";
@@ -215,7 +375,12 @@ public:
         return "Aether resonance coupling: aaether_res = UA_SCM * omega_i * fTHz * aDPM * (1 + fTRZ)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -227,15 +392,22 @@ public:
 
 class MUGEResonanceUg4iTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot k4_res_in{"k4_res", 1.0};
+    ParamSlot freact_in{"freact", 1e10};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(double t, const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double k4_res = params.count("k4_res") ? params.at("k4_res") : 1.0;
-        double freact = params.count("freact") ? params.at("freact") : 1e10;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double aDPM = readParam(params, aDPM_in);
+        double k4_res = readParam(params, k4_res_in);
+        double freact = readParam(params, freact_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double c_res = readParam(params, c_res_in);
 
         // Compute Ereact = 1046.0 * exp(-0.0005 * t)
         double Ereact = 1046.0 * std::exp(-0.0005 * t);
@@ -246,6 +418,22 @@ public:
         return Ug4i;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, k4_res_in, freact_in, Evac_neb_in, c_res_in); }
+
+    double compute(double t, const std::map<std::string, double> &params) const override { return evaluate(t, params); }
+    double compute(double t, const ParamVector &params) const override { return evaluate(t, params); }
+
+    // Ug4i scales with Ereact = 1046 * exp(-0.0005 * t): evaluate at t = 0, then vectorize the decay
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        const double Ug4i_0 = evaluate(0.0, block);
+        uqff_simd::forEachLane(t, out, [&](auto tv)
+                               { return Ug4i_0 * uqff_simd::exp(-0.0005 * tv); });
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceUg4i";
@@ -256,7 +444,12 @@ public:
         return "Reactor gravity component: Ug4i = k4_res * Ereact * freact * aDPM / (Evac_neb * c_res), Ereact = 1046 * exp(-0.0005*t)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -268,15 +461,22 @@ public:
 
 class MUGEResonanceAQuantumFreqTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot fquantum_in{"fquantum", 1.445e-17};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot Evac_ISM_in{"Evac_ISM", 7.09e-37};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double fquantum = params.count("fquantum") ? params.at("fquantum") : 1.445e-17;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double Evac_ISM = params.count("Evac_ISM") ? params.at("Evac_ISM") : 7.09e-37;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double aDPM = readParam(params, aDPM_in);
+        double fquantum = readParam(params, fquantum_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double Evac_ISM = readParam(params, Evac_ISM_in);
+        double c_res = readParam(params, c_res_in);
 
         // aquantum_freq = fquantum * Evac_neb * aDPM / (Evac_ISM * c_res)
         double aquantum_freq = (Evac_ISM * c_res != 0.0) ? (fquantum * Evac_neb * aDPM) / (Evac_ISM * c_res) : 0.0;
@@ -284,6 +484,20 @@ public:
         return aquantum_freq;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, fquantum_in, Evac_neb_in, Evac_ISM_in, c_res_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceAQuantumFreq";
@@ -294,7 +508,12 @@ public:
         return "Quantum frequency contribution: aquantum_freq = fquantum * Evac_neb * aDPM / (Evac_ISM * c_res)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -306,15 +525,22 @@ public:
 
 class MUGEResonanceAAetherFreqTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot fAether_in{"fAether", 1.576e-35};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot Evac_ISM_in{"Evac_ISM", 7.09e-37};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double fAether = params.count("fAether") ? params.at("fAether") : 1.576e-35;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double Evac_ISM = params.count("Evac_ISM") ? params.at("Evac_ISM") : 7.09e-37;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double aDPM = readParam(params, aDPM_in);
+        double fAether = readParam(params, fAether_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double Evac_ISM = readParam(params, Evac_ISM_in);
+        double c_res = readParam(params, c_res_in);
 
         // aAether_freq = fAether * Evac_neb * aDPM / (Evac_ISM * c_res)
         double aAether_freq = (Evac_ISM * c_res != 0.0) ? (fAether * Evac_neb * aDPM) / (Evac_ISM * c_res) : 0.0;
@@ -322,6 +548,20 @@ public:
         return aAether_freq;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, fAether_in, Evac_neb_in, Evac_ISM_in, c_res_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceAAetherFreq";
@@ -332,7 +572,12 @@ public:
         return "Aether frequency component: aAether_freq = fAether * Evac_neb * aDPM / (Evac_ISM * c_res)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -344,15 +589,22 @@ public:
 
 class MUGEResonanceAFluidFreqTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot ffluid_in{"ffluid", 1e6};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot Vsys_in{"Vsys", 1e56};
+    ParamSlot Evac_ISM_in{"Evac_ISM", 7.09e-37};
+    ParamSlot c_res_in{"c_res", 3e8};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double ffluid = params.count("ffluid") ? params.at("ffluid") : 1e6;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double Vsys = params.count("Vsys") ? params.at("Vsys") : 1e56;
-        double Evac_ISM = params.count("Evac_ISM") ? params.at("Evac_ISM") : 7.09e-37;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
+        double ffluid = readParam(params, ffluid_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double Vsys = readParam(params, Vsys_in);
+        double Evac_ISM = readParam(params, Evac_ISM_in);
+        double c_res = readParam(params, c_res_in);
 
         // afluid_freq = ffluid * Evac_neb * Vsys / (Evac_ISM * c_res)
         double afluid_freq = (Evac_ISM * c_res != 0.0) ? (ffluid * Evac_neb * Vsys) / (Evac_ISM * c_res) : 0.0;
@@ -360,6 +612,18 @@ public:
         return afluid_freq;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(ffluid_in, Evac_neb_in, Vsys_in, Evac_ISM_in, c_res_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
     std::string getName() const override
     {
         return "MUGEResonanceAFluidFreq";
@@ -370,7 +634,12 @@ public:
         return "Fluid dynamics frequency: afluid_freq = ffluid * Evac_neb * Vsys / (Evac_ISM * c_res)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -382,13 +651,24 @@ public:
 
 class MUGEResonanceOscTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    template <typename Params>
+    double evaluate(const Params &) const
     {
         // Simplified to zero (as per source4.cpp line 1174)
         return 0.0;
     }
 
+public:
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
     std::string getName() const override
     {
         return "MUGEResonanceOsc";
@@ -399,7 +679,12 @@ public:
         return "Oscillatory term (simplified to zero in current implementation)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -411,15 +696,22 @@ public:
 
 class MUGEResonanceAExpFreqTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot aDPM_in{"aDPM", 0.0};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+    ParamSlot Evac_ISM_in{"Evac_ISM", 7.09e-37};
+    ParamSlot c_res_in{"c_res", 3e8};
+    ParamSlot H_z_in{"H_z", 2.270e-18};
+
+    template <typename Params>
+    double evaluate(double t, const Params &params) const
     {
         // Extract parameters
-        double aDPM = params.count("aDPM") ? params.at("aDPM") : 0.0;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
-        double Evac_ISM = params.count("Evac_ISM") ? params.at("Evac_ISM") : 7.09e-37;
-        double c_res = params.count("c_res") ? params.at("c_res") : 3e8;
-        double H_z = params.count("H_z") ? params.at("H_z") : 2.270e-18;
+        double aDPM = readParam(params, aDPM_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
+        double Evac_ISM = readParam(params, Evac_ISM_in);
+        double c_res = readParam(params, c_res_in);
+        double H_z = readParam(params, H_z_in);
 
         // Compute fexp = 2 * PI * H_z * t
         double fexp = 2.0 * PI * H_z * t;
@@ -430,6 +722,22 @@ public:
         return aexp_freq;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(aDPM_in, Evac_neb_in, Evac_ISM_in, c_res_in, H_z_in); }
+
+    double compute(double t, const std::map<std::string, double> &params) const override { return evaluate(t, params); }
+    double compute(double t, const ParamVector &params) const override { return evaluate(t, params); }
+
+    // aexp_freq is linear in t (fexp = 2 * PI * H_z * t): evaluate the slope once per block
+    void computeBatch(std::span<const double> t, const ParamBlock &block, std::span<double> out) const override
+    {
+        const double slope = evaluate(1.0, block);
+        uqff_simd::forEachLane(t, out, [&](auto tv)
+                               { return slope * tv; });
+    }
+
+    std::vector<std::string> consumes() const override { return {"aDPM"}; }
+
     std::string getName() const override
     {
         return "MUGEResonanceAExpFreq";
@@ -440,7 +748,12 @@ public:
         return "Expansion frequency (Hubble): aexp_freq = fexp * Evac_neb * aDPM / (Evac_ISM * c_res), fexp = 2*PI*H_z*t";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -452,15 +765,30 @@ public:
 
 class MUGEResonanceFTRZTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot fTRZ_in{"fTRZ", 0.1};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameter (pass-through)
-        double fTRZ = params.count("fTRZ") ? params.at("fTRZ") : 0.1;
+        double fTRZ = readParam(params, fTRZ_in);
 
         return fTRZ;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(fTRZ_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
     std::string getName() const override
     {
         return "MUGEResonanceFTRZ";
@@ -471,7 +799,12 @@ public:
         return "TRZ factor component (pass-through): returns fTRZ parameter directly";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -483,14 +816,20 @@ public:
 
 class MUGEResonanceWormholeTerm : public PhysicsTerm
 {
-public:
-    double compute(double t, const std::map<std::string, double> &params) const override
+private:
+    ParamSlot r_in{"r", 1.0};
+    ParamSlot b_in{"b", 1.0};
+    ParamSlot f_worm_in{"f_worm", 1.0};
+    ParamSlot Evac_neb_in{"Evac_neb", 7.09e-36};
+
+    template <typename Params>
+    double evaluate(const Params &params) const
     {
         // Extract parameters
-        double r = params.count("r") ? params.at("r") : 1.0;
-        double b = params.count("b") ? params.at("b") : 1.0;
-        double f_worm = params.count("f_worm") ? params.at("f_worm") : 1.0;
-        double Evac_neb = params.count("Evac_neb") ? params.at("Evac_neb") : 7.09e-36;
+        double r = readParam(params, r_in);
+        double b = readParam(params, b_in);
+        double f_worm = readParam(params, f_worm_in);
+        double Evac_neb = readParam(params, Evac_neb_in);
 
         // a_wormhole = f_worm * Evac_neb / (b^2 + r^2)
         double denom = b * b + r * r;
@@ -499,6 +838,18 @@ public:
         return a_wormhole;
     }
 
+public:
+    void bindParams(ParamSchema &schema) override { schema.bind(r_in, b_in, f_worm_in, Evac_neb_in); }
+
+    double compute(double, const std::map<std::string, double> &params) const override { return evaluate(params); }
+    double compute(double, const ParamVector &params) const override { return evaluate(params); }
+
+    // Time-invariant: evaluate once per block
+    void computeBatch(std::span<const double>, const ParamBlock &block, std::span<double> out) const override
+    {
+        std::fill(out.begin(), out.end(), evaluate(block));
+    }
+
     std::string getName() const override
     {
         return "MUGEResonanceWormhole";
@@ -509,7 +860,12 @@ public:
         return "Wormhole metric contribution: a_wormhole = f_worm * Evac_neb / (b^2 + r^2)";
     }
 
-    bool validate(const std::map<std::string, double> &params) const override
+    bool validate(const std::map<std::string, double> &) const override
+    {
+        return true;
+    }
+
+    bool validate(const ParamVector &) const override
     {
         return true;
     }
@@ -0,0 +1,387 @@
+#ifndef UQFF_CATALOG_H
+#define UQFF_CATALOG_H
+
+// Bulk CSV loader for system catalogues (CelestialBody, MUGESystem, ...)
+// Rows are "name,v1,v2,...,vN": one text column followed by N numeric columns.
+// The file is memory-mapped, cut into ~1 MiB chunks at line boundaries, and the
+// chunks are parsed in parallel (OpenMP) straight into column arrays:
+//   pass 1  count lines and rows per chunk (memchr)
+//   pass 2  parse each chunk into its slice of the preallocated columns (from_chars)
+// Blank lines and lines starting with '#' are skipped; a first row whose second
+// field is not a number is taken as a header. Fields may be padded with spaces,
+// lines may end in CRLF. Any malformed row throws CatalogError naming the file and
+// the 1-based line (the earliest one if several chunks fail).
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace uqff_catalog
+{
+    constexpr size_t CHUNK_BYTES = 1 << 20;
+
+    class CatalogError : public std::runtime_error
+    {
+    public:
+        size_t line; // 1-based, 0 if not tied to a line
+
+        CatalogError(const std::string &source, size_t line_number, const std::string &what)
+            : std::runtime_error(source + (line_number ? ":" + std::to_string(line_number) : std::string()) + ": " + what),
+              line(line_number)
+        {
+        }
+    };
+
+    // ========================================================================
+    // MAPPED FILE (read-only; falls back to reading into memory)
+    // ========================================================================
+
+    class MappedFile
+    {
+    private:
+        const char *base = nullptr;
+        size_t file_size = 0;
+        bool mapped = false;
+        std::vector<char> loaded;
+#ifdef _WIN32
+        HANDLE file_handle = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int fd = -1;
+#endif
+
+        bool mapFile(const std::string &path)
+        {
+#ifdef _WIN32
+            file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_handle == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file_handle, &size) || size.QuadPart == 0)
+                return false;
+            file_size = static_cast<size_t>(size.QuadPart);
+            mapping = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping)
+                return false;
+            base = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size == 0)
+                return false;
+            file_size = static_cast<size_t>(st.st_size);
+            void *p = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            base = (p == MAP_FAILED) ? nullptr : static_cast<const char *>(p);
+            if (base)
+                ::madvise(p, file_size, MADV_SEQUENTIAL);
+#endif
+            mapped = base != nullptr;
+            return mapped;
+        }
+
+        void loadFile(const std::string &path)
+        {
+            std::FILE *f = std::fopen(path.c_str(), "rb");
+            if (!f)
+                throw CatalogError(path, 0, "cannot open file");
+            char buffer[1 << 16];
+            for (size_t got; (got = std::fread(buffer, 1, sizeof(buffer), f)) > 0;)
+                loaded.insert(loaded.end(), buffer, buffer + got);
+            std::fclose(f);
+            base = loaded.data();
+            file_size = loaded.size();
+        }
+
+        void release()
+        {
+#ifdef _WIN32
+            if (mapped)
+                UnmapViewOfFile(base);
+            if (mapping)
+                CloseHandle(mapping);
+            if (file_handle != INVALID_HANDLE_VALUE)
+                CloseHandle(file_handle);
+            mapping = nullptr;
+            file_handle = INVALID_HANDLE_VALUE;
+#else
+            if (mapped)
+                ::munmap(const_cast<char *>(base), file_size);
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+#endif
+            mapped = false;
+            base = nullptr;
+            file_size = 0;
+        }
+
+    public:
+        explicit MappedFile(const std::string &path, bool use_mmap = true)
+        {
+            try
+            {
+                if (!use_mmap || !mapFile(path))
+                {
+                    release();
+                    loadFile(path); // also covers empty files, which cannot be mapped
+                }
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+        ~MappedFile() { release(); }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        std::string_view text() const { return {base ? base : "", file_size}; }
+        bool isMapped() const { return mapped; }
+    };
+
+    // ========================================================================
+    // TABLE (SoA result)
+    // ========================================================================
+
+    struct Table
+    {
+        std::vector<std::string> header;          // empty if the file had none
+        std::vector<std::string> names;           // text column, one per row
+        std::vector<std::vector<double>> columns; // numeric columns, each one per row
+        std::vector<size_t> lines;                // source line of each row (1-based)
+
+        size_t rows() const { return names.size(); }
+    };
+
+    namespace detail
+    {
+        inline bool isBlank(char ch) { return ch == ' ' || ch == '\t'; }
+
+        // [begin, end) of one line without the newline or a trailing '\r'
+        inline const char *lineEnd(const char *p, const char *end)
+        {
+            const void *nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+            return nl ? static_cast<const char *>(nl) : end;
+        }
+
+        inline bool skipLine(const char *p, const char *e)
+        {
+            while (p < e && (isBlank(*p) || *p == '\r'))
+                ++p;
+            return p == e || *p == '#';
+        }
+
+        inline std::string_view trim(const char *p, const char *e)
+        {
+            while (p < e && isBlank(*p))
+                ++p;
+            while (e > p && (isBlank(e[-1]) || e[-1] == '\r'))
+                --e;
+            return {p, static_cast<size_t>(e - p)};
+        }
+
+        inline bool parseDouble(std::string_view field, double &value)
+        {
+            const char *p = field.data(), *e = p + field.size();
+            if (p < e && *p == '+')
+                ++p; // from_chars does not take a leading '+', stod does
+            auto [ptr, ec] = std::from_chars(p, e, value);
+            return ec == std::errc() && ptr == e && p < e;
+        }
+
+        // Second comma-separated field of a line, for header detection
+        inline bool secondFieldIsNumber(const char *p, const char *e)
+        {
+            const char *comma = static_cast<const char *>(std::memchr(p, ',', static_cast<size_t>(e - p)));
+            if (!comma)
+                return false;
+            const char *next = static_cast<const char *>(std::memchr(comma + 1, ',', static_cast<size_t>(e - comma - 1)));
+            double v;
+            return parseDouble(trim(comma + 1, next ? next : e), v);
+        }
+
+        struct Chunk
+        {
+            const char *begin;
+            const char *end;
+            size_t first_line = 0; // 1-based line number of `begin`
+            size_t lines = 0;
+            size_t rows = 0;
+            size_t first_row = 0;
+            size_t error_line = 0;
+            std::string error;
+        };
+    }
+
+    // Parse CSV text with `numeric_columns` numbers after the name on every row.
+    // `source` is only used in error messages.
+    inline Table parse(std::string_view text, size_t numeric_columns, const std::string &source = "catalog")
+    {
+        using namespace detail;
+        const char *const data = text.data();
+        const char *const end = data + text.size();
+
+        Table table;
+        const char *body = data;
+        size_t body_line = 1;
+
+        // Header: the first non-comment line, if its second field is not numeric
+        for (const char *p = data; p < end;)
+        {
+            const char *e = lineEnd(p, end);
+            if (!skipLine(p, e))
+            {
+                if (!secondFieldIsNumber(p, e))
+                {
+                    for (const char *f = p; f <= e;)
+                    {
+                        const char *comma = static_cast<const char *>(std::memchr(f, ',', static_cast<size_t>(e - f)));
+                        const char *fe = comma ? comma : e;
+                        table.header.emplace_back(trim(f, fe));
+                        f = fe + 1;
+                    }
+                    if (table.header.size() != numeric_columns + 1)
+                        throw CatalogError(source, body_line, "header has " + std::to_string(table.header.size()) +
+                                                                  " columns, expected " + std::to_string(numeric_columns + 1));
+                    body = e < end ? e + 1 : end;
+                    ++body_line;
+                }
+                break;
+            }
+            p = e < end ? e + 1 : end;
+            ++body_line;
+        }
+
+        // Chunks of ~CHUNK_BYTES, each ending just after a newline
+        std::vector<Chunk> chunks;
+        for (const char *p = body; p < end;)
+        {
+            const char *stop = static_cast<size_t>(end - p) > CHUNK_BYTES ? p + CHUNK_BYTES : end;
+            if (stop < end)
+                stop = lineEnd(stop, end) + (lineEnd(stop, end) < end ? 1 : 0);
+            Chunk chunk;
+            chunk.begin = p;
+            chunk.end = stop;
+            chunks.push_back(std::move(chunk));
+            p = stop;
+        }
+        const long chunk_count = static_cast<long>(chunks.size());
+
+        // Pass 1: lines and data rows per chunk
+#pragma omp parallel for schedule(dynamic)
+        for (long k = 0; k < chunk_count; ++k)
+        {
+            Chunk &c = chunks[k];
+            for (const char *p = c.begin; p < c.end;)
+            {
+                const char *e = lineEnd(p, c.end);
+                ++c.lines;
+                if (!skipLine(p, e))
+                    ++c.rows;
+                p = e < c.end ? e + 1 : c.end;
+            }
+        }
+
+        size_t rows = 0, line = body_line;
+        for (Chunk &c : chunks)
+        {
+            c.first_row = rows;
+            c.first_line = line;
+            rows += c.rows;
+            line += c.lines;
+        }
+        table.names.resize(rows);
+        table.lines.resize(rows);
+        table.columns.assign(numeric_columns, std::vector<double>(rows));
+
+        // Pass 2: parse straight into the columns
+#pragma omp parallel for schedule(dynamic)
+        for (long k = 0; k < chunk_count; ++k)
+        {
+            Chunk &c = chunks[k];
+            size_t row = c.first_row, line_no = c.first_line;
+            for (const char *p = c.begin; p < c.end; ++line_no)
+            {
+                const char *e = lineEnd(p, c.end);
+                const char *next = e < c.end ? e + 1 : c.end;
+                if (skipLine(p, e))
+                {
+                    p = next;
+                    continue;
+                }
+
+                const char *f = p;
+                size_t fields = 0;
+                for (;; ++fields)
+                {
+                    const char *comma = static_cast<const char *>(std::memchr(f, ',', static_cast<size_t>(e - f)));
+                    const char *fe = comma ? comma : e;
+                    if (fields == 0)
+                    {
+                        table.names[row] = std::string(trim(f, fe));
+                    }
+                    else if (fields <= numeric_columns &&
+                             !parseDouble(trim(f, fe), table.columns[fields - 1][row]))
+                    {
+                        c.error_line = line_no;
+                        c.error = "column " + std::to_string(fields + 1) + ": '" + std::string(trim(f, fe)) +
+                                  "' is not a number";
+                        break;
+                    }
+                    if (!comma)
+                        break;
+                    f = comma + 1;
+                }
+                if (c.error_line)
+                    break;
+                if (fields != numeric_columns)
+                {
+                    c.error_line = line_no;
+                    c.error = "expected " + std::to_string(numeric_columns + 1) + " columns, found " +
+                              std::to_string(fields + 1);
+                    break;
+                }
+                table.lines[row++] = line_no;
+                p = next;
+            }
+        }
+
+        for (const Chunk &c : chunks)
+            if (c.error_line)
+                throw CatalogError(source, c.error_line, c.error); // chunks are in file order
+        return table;
+    }
+
+    inline Table load(const std::string &path, size_t numeric_columns)
+    {
+        MappedFile file(path);
+        return parse(file.text(), numeric_columns, path);
+    }
+}
+
+#endif // UQFF_CATALOG_H
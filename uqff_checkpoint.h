@@ -0,0 +1,594 @@
+#ifndef UQFF_CHECKPOINT_H
+#define UQFF_CHECKPOINT_H
+
+// Versioned binary checkpoints (.uqckpt) for long FluidSolver / SimulationEngine runs
+// A checkpoint is a list of named sections (float64 arrays, uint64 arrays, byte
+// strings). The caller snapshots its state into a Checkpoint (a plain copy, so the
+// solver can carry on immediately) and hands it to AsyncWriter, whose background
+// thread does the checksumming and file I/O.
+//
+// Layout (all integers little-endian, native double):
+//   Header, 64 bytes
+//     char[8]  magic "UQFFCKP1"
+//     uint32   format version (VERSION)
+//     uint32   byte-order tag 0x01020304
+//     uint32   section count S
+//     uint32   CRC-32 of the 64 header bytes with this field zeroed
+//     char[40] kind (what wrote it, e.g. "FluidSolver"), zero padded
+//   Section, repeated S times
+//     uint32   name length, uint32 type (1 = float64, 2 = uint64, 3 = bytes)
+//     uint64   element count
+//     uint32   CRC-32 of the data, uint32 CRC-32 of the name
+//     name bytes, zero padding to 64
+//     data, zero padding to 64     (arrays start 64-byte aligned in the file)
+// Files are written to "<path>.tmp" and renamed over <path>, so a crash mid-write
+// leaves the previous checkpoint intact.
+// Data that only grows (stored time-series rows) can go to a separate log instead
+// (AsyncWriter::submitRange): each checkpoint then copies and writes just the new
+// tail, and records the log length and a running CRC-32 to validate it on resume.
+
+#include <string>
+#include <vector>
+#include <span>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+#include <fstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <algorithm>
+#include <utility>
+
+namespace uqff_checkpoint
+{
+    constexpr char MAGIC[8] = {'U', 'Q', 'F', 'F', 'C', 'K', 'P', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t BYTE_ORDER_TAG = 0x01020304;
+    constexpr size_t ALIGN = 64;
+    constexpr size_t HEADER_BYTES = 64;
+    constexpr size_t KIND_BYTES = 40;
+
+    enum SectionType : uint32_t
+    {
+        FLOAT64 = 1,
+        UINT64 = 2,
+        BYTES = 3
+    };
+
+    inline size_t padTo(size_t bytes) { return (bytes + ALIGN - 1) / ALIGN * ALIGN; }
+
+    // CRC-32 (IEEE 802.3, reflected), table driven
+    inline uint32_t crc32(const void *data, size_t bytes, uint32_t crc = 0)
+    {
+        static const std::array<uint32_t, 256> table = []
+        {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < bytes; ++i)
+            crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    // ========================================================================
+    // CHECKPOINT (in-memory snapshot)
+    // ========================================================================
+
+    class Checkpoint
+    {
+    public:
+        struct Section
+        {
+            std::string name;
+            SectionType type;
+            uint64_t count;
+            std::vector<unsigned char> data;
+        };
+
+    private:
+        std::string kind_name;
+        std::vector<Section> sections;
+
+        Section &add(const std::string &name, SectionType type, uint64_t count, const void *src, size_t bytes)
+        {
+            Section s{name, type, count, std::vector<unsigned char>(bytes)};
+            if (bytes)
+                std::memcpy(s.data.data(), src, bytes);
+            sections.push_back(std::move(s));
+            return sections.back();
+        }
+
+        const Section &find(const std::string &name, SectionType type) const
+        {
+            for (const Section &s : sections)
+            {
+                if (s.name == name)
+                {
+                    if (s.type != type)
+                        throw std::runtime_error("Checkpoint: section '" + name + "' has the wrong type");
+                    return s;
+                }
+            }
+            throw std::runtime_error("Checkpoint: missing section '" + name + "'");
+        }
+
+    public:
+        explicit Checkpoint(const std::string &kind = "") : kind_name(kind.substr(0, KIND_BYTES)) {}
+
+        const std::string &kind() const { return kind_name; }
+        const std::vector<Section> &all() const { return sections; }
+
+        bool has(const std::string &name) const
+        {
+            for (const Section &s : sections)
+                if (s.name == name)
+                    return true;
+            return false;
+        }
+
+        void addDoubles(const std::string &name, std::span<const double> values)
+        {
+            add(name, FLOAT64, values.size(), values.data(), values.size_bytes());
+        }
+        void addDouble(const std::string &name, double value) { addDoubles(name, {&value, 1}); }
+
+        void addU64s(const std::string &name, std::span<const uint64_t> values)
+        {
+            add(name, UINT64, values.size(), values.data(), values.size_bytes());
+        }
+        void addU64(const std::string &name, uint64_t value) { addU64s(name, {&value, 1}); }
+
+        void addString(const std::string &name, const std::string &value)
+        {
+            add(name, BYTES, value.size(), value.data(), value.size());
+        }
+
+        // Several strings in one section, '\0'-separated
+        void addStrings(const std::string &name, const std::vector<std::string> &values)
+        {
+            std::string joined;
+            for (const std::string &v : values)
+            {
+                joined += v;
+                joined.push_back('\0');
+            }
+            addString(name, joined);
+        }
+
+        std::span<const double> doubles(const std::string &name) const
+        {
+            const Section &s = find(name, FLOAT64);
+            return {reinterpret_cast<const double *>(s.data.data()), static_cast<size_t>(s.count)};
+        }
+
+        double getDouble(const std::string &name) const
+        {
+            auto v = doubles(name);
+            if (v.size() != 1)
+                throw std::runtime_error("Checkpoint: section '" + name + "' is not a scalar");
+            return v[0];
+        }
+
+        std::span<const uint64_t> u64s(const std::string &name) const
+        {
+            const Section &s = find(name, UINT64);
+            return {reinterpret_cast<const uint64_t *>(s.data.data()), static_cast<size_t>(s.count)};
+        }
+
+        uint64_t getU64(const std::string &name) const
+        {
+            auto v = u64s(name);
+            if (v.size() != 1)
+                throw std::runtime_error("Checkpoint: section '" + name + "' is not a scalar");
+            return v[0];
+        }
+
+        std::string getString(const std::string &name) const
+        {
+            const Section &s = find(name, BYTES);
+            return std::string(reinterpret_cast<const char *>(s.data.data()), s.data.size());
+        }
+
+        std::vector<std::string> getStrings(const std::string &name) const
+        {
+            std::vector<std::string> out;
+            std::string joined = getString(name);
+            size_t start = 0;
+            for (size_t i = 0; i < joined.size(); ++i)
+            {
+                if (joined[i] == '\0')
+                {
+                    out.push_back(joined.substr(start, i - start));
+                    start = i + 1;
+                }
+            }
+            return out;
+        }
+
+        // Copy a float64 section into dst, which must have exactly the saved length
+        void copyDoubles(const std::string &name, std::span<double> dst) const
+        {
+            auto src = doubles(name);
+            if (src.size() != dst.size())
+                throw std::runtime_error("Checkpoint: section '" + name + "' has " + std::to_string(src.size()) +
+                                         " values, expected " + std::to_string(dst.size()));
+            std::memcpy(dst.data(), src.data(), src.size_bytes());
+        }
+
+        // ====================================================================
+        // FILE I/O
+        // ====================================================================
+
+        void write(const std::string &path) const
+        {
+            const std::string tmp = path + ".tmp";
+            std::FILE *file = std::fopen(tmp.c_str(), "wb");
+            if (!file)
+                throw std::runtime_error("Checkpoint: cannot open " + tmp);
+
+            static const unsigned char zeros[ALIGN] = {};
+            bool ok = true;
+            auto put = [&](const void *data, size_t bytes)
+            {
+                if (ok && bytes)
+                    ok = std::fwrite(data, 1, bytes, file) == bytes;
+            };
+            auto pad = [&](size_t bytes)
+            { put(zeros, padTo(bytes) - bytes); };
+
+            unsigned char header[HEADER_BYTES] = {};
+            const uint32_t count = static_cast<uint32_t>(sections.size());
+            std::memcpy(header, MAGIC, 8);
+            std::memcpy(header + 8, &VERSION, 4);
+            std::memcpy(header + 12, &BYTE_ORDER_TAG, 4);
+            std::memcpy(header + 16, &count, 4);
+            std::memcpy(header + 24, kind_name.data(), kind_name.size());
+            const uint32_t header_crc = crc32(header, HEADER_BYTES);
+            std::memcpy(header + 20, &header_crc, 4);
+            put(header, HEADER_BYTES);
+
+            for (const Section &s : sections)
+            {
+                const uint32_t name_len = static_cast<uint32_t>(s.name.size());
+                const uint32_t type = s.type;
+                const uint32_t data_crc = crc32(s.data.data(), s.data.size());
+                const uint32_t name_crc = crc32(s.name.data(), s.name.size());
+                put(&name_len, 4);
+                put(&type, 4);
+                put(&s.count, 8);
+                put(&data_crc, 4);
+                put(&name_crc, 4);
+                put(s.name.data(), s.name.size());
+                pad(24 + s.name.size());
+                put(s.data.data(), s.data.size());
+                pad(s.data.size());
+            }
+
+            ok = std::fflush(file) == 0 && ok;
+            ok = std::fclose(file) == 0 && ok;
+            if (!ok)
+            {
+                std::remove(tmp.c_str());
+                throw std::runtime_error("Checkpoint: write failed for " + tmp);
+            }
+
+            std::error_code ec;
+            std::filesystem::rename(tmp, path, ec);
+            if (ec)
+                throw std::runtime_error("Checkpoint: cannot replace " + path + ": " + ec.message());
+        }
+
+        // Loads and verifies every checksum; throws std::runtime_error on any mismatch
+        static Checkpoint read(const std::string &path)
+        {
+            std::FILE *file = std::fopen(path.c_str(), "rb");
+            if (!file)
+                throw std::runtime_error("Checkpoint: cannot open " + path);
+            std::vector<unsigned char> bytes;
+            unsigned char buffer[1 << 16];
+            for (size_t got; (got = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+                bytes.insert(bytes.end(), buffer, buffer + got);
+            std::fclose(file);
+
+            auto fail = [&](const std::string &why)
+            { return std::runtime_error("Checkpoint " + path + ": " + why); };
+
+            if (bytes.size() < HEADER_BYTES || std::memcmp(bytes.data(), MAGIC, 8) != 0)
+                throw fail("not a checkpoint file");
+
+            uint32_t version, order, count, header_crc;
+            std::memcpy(&version, &bytes[8], 4);
+            std::memcpy(&order, &bytes[12], 4);
+            std::memcpy(&count, &bytes[16], 4);
+            std::memcpy(&header_crc, &bytes[20], 4);
+            if (order != BYTE_ORDER_TAG)
+                throw fail("written on a machine with different byte order");
+            if (version > VERSION)
+                throw fail("format version " + std::to_string(version) + " is newer than this build (" +
+                           std::to_string(VERSION) + ")");
+
+            unsigned char header[HEADER_BYTES];
+            std::memcpy(header, bytes.data(), HEADER_BYTES);
+            std::memset(header + 20, 0, 4);
+            if (crc32(header, HEADER_BYTES) != header_crc)
+                throw fail("header checksum mismatch");
+
+            const char *kind_bytes = reinterpret_cast<const char *>(&bytes[24]);
+            Checkpoint ckpt(std::string(kind_bytes, std::find(kind_bytes, kind_bytes + KIND_BYTES, '\0')));
+
+            size_t pos = HEADER_BYTES;
+            for (uint32_t k = 0; k < count; ++k)
+            {
+                if (bytes.size() - pos < 24)
+                    throw fail("truncated section table");
+                uint32_t name_len, type, data_crc, name_crc;
+                uint64_t elements;
+                std::memcpy(&name_len, &bytes[pos], 4);
+                std::memcpy(&type, &bytes[pos + 4], 4);
+                std::memcpy(&elements, &bytes[pos + 8], 8);
+                std::memcpy(&data_crc, &bytes[pos + 16], 4);
+                std::memcpy(&name_crc, &bytes[pos + 20], 4);
+
+                if (type < FLOAT64 || type > BYTES)
+                    throw fail("unknown section type " + std::to_string(type));
+                const uint64_t width = type == BYTES ? 1 : 8;
+                if (elements > (bytes.size() / width))
+                    throw fail("section size out of range");
+                const size_t data_bytes = static_cast<size_t>(elements * width);
+
+                const size_t name_at = pos + 24;
+                const size_t data_at = pos + padTo(24 + static_cast<size_t>(name_len));
+                if (name_len > bytes.size() || data_at > bytes.size() || bytes.size() - data_at < data_bytes)
+                    throw fail("truncated section " + std::to_string(k));
+
+                std::string name(reinterpret_cast<const char *>(&bytes[name_at]), name_len);
+                if (crc32(name.data(), name.size()) != name_crc)
+                    throw fail("checksum mismatch in name of section " + std::to_string(k));
+                if (crc32(&bytes[data_at], data_bytes) != data_crc)
+                    throw fail("checksum mismatch in section '" + name + "'");
+
+                ckpt.add(name, static_cast<SectionType>(type), elements, &bytes[data_at], data_bytes);
+                pos = data_at + padTo(data_bytes);
+            }
+            return ckpt;
+        }
+    };
+
+    // ========================================================================
+    // INTERVAL (when to take the next snapshot)
+    // ========================================================================
+
+    // Due every `every_steps` steps and/or every `every_seconds` of wall time (0 = off)
+    class Interval
+    {
+    private:
+        uint64_t every_steps;
+        double every_seconds;
+        uint64_t last_step = 0;
+        std::chrono::steady_clock::time_point last_time = std::chrono::steady_clock::now();
+
+    public:
+        explicit Interval(uint64_t steps = 0, double seconds = 0.0) : every_steps(steps), every_seconds(seconds) {}
+
+        bool enabled() const { return every_steps > 0 || every_seconds > 0.0; }
+
+        // Resume point: count steps from here
+        void restart(uint64_t step)
+        {
+            last_step = step;
+            last_time = std::chrono::steady_clock::now();
+        }
+
+        bool due(uint64_t step)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const bool by_steps = every_steps > 0 && step - last_step >= every_steps;
+            const bool by_time = every_seconds > 0.0 &&
+                                 std::chrono::duration<double>(now - last_time).count() >= every_seconds;
+            if (!by_steps && !by_time)
+                return false;
+            last_step = step;
+            last_time = now;
+            return true;
+        }
+    };
+
+    // Write `bytes` at `offset` of `path`, cutting the file to `offset` first, so
+    // anything past the last checkpointed length (an interrupted run) is dropped
+    inline void writeRange(const std::string &path, uint64_t offset, std::span<const unsigned char> bytes)
+    {
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec))
+        {
+            std::filesystem::resize_file(path, offset, ec);
+            if (ec)
+                throw std::runtime_error("Checkpoint: cannot resize " + path + ": " + ec.message());
+        }
+        else if (offset != 0)
+        {
+            throw std::runtime_error("Checkpoint: " + path + " is missing its first " + std::to_string(offset) + " bytes");
+        }
+        else
+        {
+            std::ofstream create(path, std::ios::binary);
+        }
+
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file)
+            throw std::runtime_error("Checkpoint: write failed for " + path);
+    }
+
+    // ========================================================================
+    // ASYNC WRITER
+    // ========================================================================
+
+    // One background thread, one pending slot: if a newer snapshot arrives while the
+    // previous one is still queued, the older one is dropped (only the latest matters).
+    // Range writes are queued in order and never dropped; each one runs before any
+    // snapshot submitted after it.
+    class AsyncWriter
+    {
+    private:
+        struct Job
+        {
+            Checkpoint data;
+            std::string path;
+        };
+
+        struct RangeJob
+        {
+            std::string path;
+            uint64_t offset;
+            std::vector<unsigned char> bytes;
+        };
+
+        std::mutex mtx;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::optional<Job> pending;
+        std::deque<RangeJob> ranges;
+        bool busy = false;
+        bool stopping = false;
+        size_t written_count = 0;
+        size_t superseded_count = 0;
+        std::string last_error;
+        std::thread worker;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            for (;;)
+            {
+                wake.wait(lock, [&]
+                          { return stopping || pending.has_value() || !ranges.empty(); });
+                if (!pending && ranges.empty())
+                    return;
+                std::optional<RangeJob> range;
+                std::optional<Job> job;
+                if (!ranges.empty())
+                {
+                    range = std::move(ranges.front());
+                    ranges.pop_front();
+                }
+                else
+                {
+                    job = std::move(pending);
+                    pending.reset();
+                }
+                busy = true;
+                lock.unlock();
+
+                std::string error;
+                try
+                {
+                    if (range)
+                        writeRange(range->path, range->offset, range->bytes);
+                    else
+                        job->data.write(job->path);
+                }
+                catch (const std::exception &e)
+                {
+                    error = e.what();
+                }
+
+                lock.lock();
+                busy = false;
+                if (!error.empty())
+                    last_error = error;
+                else if (job)
+                    ++written_count;
+                idle.notify_all();
+            }
+        }
+
+    public:
+        AsyncWriter() : worker([this]
+                               { run(); }) {}
+
+        ~AsyncWriter()
+        {
+            flush();
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stopping = true;
+            }
+            wake.notify_all();
+            worker.join();
+        }
+
+        AsyncWriter(const AsyncWriter &) = delete;
+        AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+        // Never blocks on I/O
+        void submit(Checkpoint data, const std::string &path)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (pending)
+                    ++superseded_count;
+                pending = Job{std::move(data), path};
+            }
+            wake.notify_one();
+        }
+
+        // Queue writeRange(path, offset, bytes); never blocks on I/O
+        void submitRange(const std::string &path, uint64_t offset, std::vector<unsigned char> bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                ranges.push_back(RangeJob{path, offset, std::move(bytes)});
+            }
+            wake.notify_one();
+        }
+
+        // Wait until everything submitted so far is on disk (or failed)
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            idle.wait(lock, [&]
+                      { return !pending && ranges.empty() && !busy; });
+        }
+
+        size_t written()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            return written_count;
+        }
+
+        size_t superseded()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            return superseded_count;
+        }
+
+        // Most recent write error ("" if none); cleared by the call
+        std::string takeError()
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            return std::exchange(last_error, std::string());
+        }
+    };
+
+} // namespace uqff_checkpoint
+
+#endif // UQFF_CHECKPOINT_H
@@ -0,0 +1,449 @@
+#ifndef UQFF_COLUMNAR_H
+#define UQFF_COLUMNAR_H
+
+// Binary columnar result files (.uqcol)
+// A self-describing, chunked float64 format for simulation time series. Values are
+// stored bit-exact (no text formatting), written in large blocks, and every column
+// of every chunk starts on a 64-byte boundary so a memory-mapped reader can hand
+// out std::span<const double> views straight into the file.
+//
+// Layout (all integers little-endian, native double):
+//   Header, padded with zeros to a multiple of 64 bytes
+//     char[8]  magic "UQFFCOL1"
+//     uint32   byte-order tag 0x01020304
+//     uint32   column count C
+//     uint64   total rows          (patched on close; 0 if the writer never closed)
+//     uint64   chunk count         (patched on close)
+//     uint64   header size in bytes
+//     C x { uint32 name length, name bytes, uint8 type (1 = float64) }
+//   Chunk, repeated
+//     uint64   rows R in this chunk, then zero padding to 64 bytes
+//     C x { R doubles, zero padding to 64 bytes }
+// Readers walk the chunks to EOF, so a file from an interrupted run is still readable
+// up to its last complete chunk.
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+#include <memory>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace uqff_columnar
+{
+    constexpr char MAGIC[8] = {'U', 'Q', 'F', 'F', 'C', 'O', 'L', '1'};
+    constexpr uint32_t BYTE_ORDER_TAG = 0x01020304;
+    constexpr uint8_t TYPE_FLOAT64 = 1;
+    constexpr size_t ALIGN = 64;
+    constexpr size_t DEFAULT_CHUNK_ROWS = 65536;   // 512 KiB per column per chunk
+    constexpr size_t DEFAULT_BUFFER_BYTES = 4 << 20; // stdio buffer for header/padding writes
+
+    // Offset of the header fields patched on close (total rows, then chunk count)
+    constexpr size_t ROWS_OFFSET = 16;
+
+    inline size_t padTo(size_t bytes) { return (bytes + ALIGN - 1) / ALIGN * ALIGN; }
+
+    // ========================================================================
+    // WRITER
+    // ========================================================================
+
+    class Writer
+    {
+    private:
+        std::FILE *file = nullptr;
+        std::unique_ptr<char[]> io_buffer;
+        size_t column_count;
+        size_t chunk_rows;
+        uint64_t total_rows = 0;
+        uint64_t chunk_count = 0;
+        std::vector<std::vector<double>> staging; // Partial chunk, one vector per column
+        size_t staged = 0;
+
+        void put(const void *data, size_t bytes)
+        {
+            if (bytes && std::fwrite(data, 1, bytes, file) != bytes)
+                throw std::runtime_error("Columnar writer: write failed");
+        }
+
+        void pad(size_t bytes)
+        {
+            static const char zeros[ALIGN] = {};
+            put(zeros, padTo(bytes) - bytes);
+        }
+
+        void writeChunk(const std::vector<const double *> &columns, size_t rows)
+        {
+            uint64_t r = rows;
+            put(&r, sizeof(r));
+            pad(sizeof(r));
+            for (const double *col : columns)
+            {
+                put(col, rows * sizeof(double));
+                pad(rows * sizeof(double));
+            }
+            total_rows += rows;
+            ++chunk_count;
+        }
+
+        void flushStaging()
+        {
+            if (staged == 0)
+                return;
+            std::vector<const double *> columns;
+            for (const auto &col : staging)
+            {
+                columns.push_back(col.data());
+            }
+            writeChunk(columns, staged);
+            staged = 0;
+        }
+
+    public:
+        Writer(const std::string &path, const std::vector<std::string> &names,
+               size_t rows_per_chunk = DEFAULT_CHUNK_ROWS, size_t buffer_bytes = DEFAULT_BUFFER_BYTES)
+            : column_count(names.size()), chunk_rows(std::max<size_t>(rows_per_chunk, 1))
+        {
+            file = std::fopen(path.c_str(), "wb");
+            if (!file)
+                throw std::runtime_error("Columnar writer: cannot open " + path);
+            io_buffer.reset(new char[buffer_bytes]);
+            std::setvbuf(file, io_buffer.get(), _IOFBF, buffer_bytes);
+
+            size_t header_bytes = sizeof(MAGIC) + 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+            for (const auto &name : names)
+            {
+                header_bytes += sizeof(uint32_t) + name.size() + 1;
+            }
+            const uint64_t header_size = padTo(header_bytes);
+            const uint32_t tag = BYTE_ORDER_TAG;
+            const uint32_t count = static_cast<uint32_t>(column_count);
+            const uint64_t zero = 0;
+
+            put(MAGIC, sizeof(MAGIC));
+            put(&tag, sizeof(tag));
+            put(&count, sizeof(count));
+            put(&zero, sizeof(zero)); // total rows
+            put(&zero, sizeof(zero)); // chunk count
+            put(&header_size, sizeof(header_size));
+            for (const auto &name : names)
+            {
+                uint32_t len = static_cast<uint32_t>(name.size());
+                put(&len, sizeof(len));
+                put(name.data(), name.size());
+                put(&TYPE_FLOAT64, 1);
+            }
+            pad(header_bytes);
+
+            staging.assign(column_count, std::vector<double>(chunk_rows));
+        }
+
+        ~Writer()
+        {
+            try
+            {
+                close();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        // Append rows given as one span per column (all the same length).
+        // Whole chunks are written straight from the caller's columns without copying.
+        void append(const std::vector<std::span<const double>> &columns)
+        {
+            if (columns.size() != column_count)
+                throw std::invalid_argument("Columnar writer: column count mismatch");
+            const size_t rows = column_count ? columns[0].size() : 0;
+            for (const auto &col : columns)
+            {
+                if (col.size() != rows)
+                    throw std::invalid_argument("Columnar writer: ragged columns");
+            }
+
+            size_t done = 0;
+            std::vector<const double *> direct(column_count);
+            while (done < rows)
+            {
+                if (staged == 0 && rows - done >= chunk_rows)
+                {
+                    for (size_t c = 0; c < column_count; ++c)
+                    {
+                        direct[c] = columns[c].data() + done;
+                    }
+                    writeChunk(direct, chunk_rows);
+                    done += chunk_rows;
+                    continue;
+                }
+
+                size_t n = std::min(chunk_rows - staged, rows - done);
+                for (size_t c = 0; c < column_count; ++c)
+                {
+                    std::copy_n(columns[c].data() + done, n, staging[c].data() + staged);
+                }
+                staged += n;
+                done += n;
+                if (staged == chunk_rows)
+                    flushStaging();
+            }
+        }
+
+        // Write the final partial chunk and the row/chunk totals
+        void close()
+        {
+            if (!file)
+                return;
+            std::FILE *f = file;
+            try
+            {
+                flushStaging();
+                if (std::fseek(f, ROWS_OFFSET, SEEK_SET) != 0)
+                    throw std::runtime_error("Columnar writer: seek failed");
+                put(&total_rows, sizeof(total_rows));
+                put(&chunk_count, sizeof(chunk_count));
+            }
+            catch (...)
+            {
+                file = nullptr;
+                std::fclose(f);
+                throw;
+            }
+            file = nullptr;
+            if (std::fclose(f) != 0)
+                throw std::runtime_error("Columnar writer: close failed");
+        }
+
+        uint64_t rows() const { return total_rows + staged; }
+    };
+
+    // ========================================================================
+    // READER
+    // ========================================================================
+
+    class Reader
+    {
+    private:
+        const unsigned char *base = nullptr;
+        size_t file_size = 0;
+        std::vector<double> loaded; // Backing store when not memory-mapped
+#ifdef _WIN32
+        HANDLE file_handle = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int fd = -1;
+#endif
+        bool mapped = false;
+
+        std::vector<std::string> names;
+        struct Chunk
+        {
+            size_t rows;
+            size_t offset; // First column's data
+            size_t stride; // Bytes between columns
+        };
+        std::vector<Chunk> chunks;
+        uint64_t total_rows = 0;
+
+        template <typename T>
+        T read(size_t &pos) const
+        {
+            if (pos + sizeof(T) > file_size)
+                throw std::runtime_error("Columnar reader: truncated header");
+            T v;
+            std::memcpy(&v, base + pos, sizeof(T));
+            pos += sizeof(T);
+            return v;
+        }
+
+        bool mapFile(const std::string &path)
+        {
+#ifdef _WIN32
+            file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_handle == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file_handle, &size) || size.QuadPart == 0)
+                return false;
+            file_size = static_cast<size_t>(size.QuadPart);
+            mapping = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping)
+                return false;
+            base = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || st.st_size == 0)
+                return false;
+            file_size = static_cast<size_t>(st.st_size);
+            void *p = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            base = (p == MAP_FAILED) ? nullptr : static_cast<const unsigned char *>(p);
+#endif
+            mapped = base != nullptr;
+            return mapped;
+        }
+
+        void loadFile(const std::string &path)
+        {
+            std::FILE *f = std::fopen(path.c_str(), "rb");
+            if (!f)
+                throw std::runtime_error("Columnar reader: cannot open " + path);
+            std::fseek(f, 0, SEEK_END);
+            long size = std::ftell(f);
+            std::fseek(f, 0, SEEK_SET);
+            file_size = size > 0 ? static_cast<size_t>(size) : 0;
+            loaded.resize((file_size + sizeof(double) - 1) / sizeof(double));
+            size_t got = std::fread(loaded.data(), 1, file_size, f);
+            std::fclose(f);
+            if (got != file_size)
+                throw std::runtime_error("Columnar reader: short read on " + path);
+            base = reinterpret_cast<const unsigned char *>(loaded.data());
+        }
+
+        void release()
+        {
+#ifdef _WIN32
+            if (mapped)
+                UnmapViewOfFile(base);
+            if (mapping)
+                CloseHandle(mapping);
+            if (file_handle != INVALID_HANDLE_VALUE)
+                CloseHandle(file_handle);
+            mapping = nullptr;
+            file_handle = INVALID_HANDLE_VALUE;
+#else
+            if (mapped)
+                ::munmap(const_cast<unsigned char *>(base), file_size);
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+#endif
+            mapped = false;
+            base = nullptr;
+        }
+
+        void parse()
+        {
+            size_t pos = 0;
+            if (file_size < sizeof(MAGIC) || std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0)
+                throw std::runtime_error("Columnar reader: not a UQFFCOL1 file");
+            pos += sizeof(MAGIC);
+            if (read<uint32_t>(pos) != BYTE_ORDER_TAG)
+                throw std::runtime_error("Columnar reader: byte order mismatch");
+            const uint32_t count = read<uint32_t>(pos);
+            const uint64_t header_rows = read<uint64_t>(pos);
+            read<uint64_t>(pos); // chunk count (recomputed below)
+            const uint64_t header_size = read<uint64_t>(pos);
+
+            for (uint32_t c = 0; c < count; ++c)
+            {
+                uint32_t len = read<uint32_t>(pos);
+                if (pos + len + 1 > file_size)
+                    throw std::runtime_error("Columnar reader: truncated header");
+                names.emplace_back(reinterpret_cast<const char *>(base + pos), len);
+                pos += len;
+                if (read<uint8_t>(pos) != TYPE_FLOAT64)
+                    throw std::runtime_error("Columnar reader: unsupported column type in " + names.back());
+            }
+            if (header_size < pos || header_size % ALIGN != 0)
+                throw std::runtime_error("Columnar reader: bad header size");
+
+            for (pos = header_size; pos + sizeof(uint64_t) <= file_size;)
+            {
+                size_t p = pos;
+                const uint64_t rows = read<uint64_t>(p);
+                const size_t stride = padTo(rows * sizeof(double));
+                const size_t end = pos + ALIGN + stride * count;
+                if (rows == 0 || end > file_size || end < pos)
+                    break; // Incomplete trailing chunk from an interrupted writer
+                chunks.push_back({static_cast<size_t>(rows), pos + ALIGN, stride});
+                total_rows += rows;
+                pos = end;
+            }
+            if (header_rows != 0 && header_rows != total_rows)
+                throw std::runtime_error("Columnar reader: row count does not match chunks");
+        }
+
+    public:
+        // use_mmap = false reads the whole file into memory instead of mapping it
+        explicit Reader(const std::string &path, bool use_mmap = true)
+        {
+            try
+            {
+                if (!use_mmap || !mapFile(path))
+                {
+                    release();
+                    loadFile(path);
+                }
+                parse();
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+        ~Reader() { release(); }
+
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        size_t columnCount() const { return names.size(); }
+        size_t rowCount() const { return static_cast<size_t>(total_rows); }
+        size_t chunkCount() const { return chunks.size(); }
+        bool isMapped() const { return mapped; }
+        const std::string &columnName(size_t c) const { return names.at(c); }
+
+        // Column index by name (columnCount() if absent)
+        size_t find(const std::string &name) const
+        {
+            return static_cast<size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+        }
+
+        // Zero-copy view of column c within chunk j (valid while the reader lives)
+        std::span<const double> chunk(size_t j, size_t c) const
+        {
+            const Chunk &ch = chunks.at(j);
+            if (c >= names.size())
+                throw std::out_of_range("Columnar reader: column index");
+            return {reinterpret_cast<const double *>(base + ch.offset + c * ch.stride), ch.rows};
+        }
+
+        // Whole column gathered across chunks into one vector (copies)
+        std::vector<double> column(size_t c) const
+        {
+            std::vector<double> out;
+            out.reserve(rowCount());
+            for (size_t j = 0; j < chunks.size(); ++j)
+            {
+                auto view = chunk(j, c);
+                out.insert(out.end(), view.begin(), view.end());
+            }
+            return out;
+        }
+    };
+
+} // namespace uqff_columnar
+
+#endif // UQFF_COLUMNAR_H
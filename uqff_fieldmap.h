@@ -0,0 +1,594 @@
+#ifndef UQFF_FIELDMAP_H
+#define UQFF_FIELDMAP_H
+
+// Dense field maps over (t, theta, r) grids, e.g. FU and its components around a body
+// The generator is independent of the physics: it calls an evaluator for one row of
+// radii at a fixed (t, theta) and stores every channel it returns.
+//
+//   eval(t, theta, r, n, out)   write channel c at radius r[k] to out[c][k], k < n
+//
+// Each time slice is cut into tiles of tile_theta x tile_r points and the tiles are
+// evaluated in parallel (OpenMP, dynamic schedule). Coarse-to-fine mode first samples
+// every coarse_stride-th point of the slice; a tile is evaluated point by point only
+// if some channel changes by more than refine_threshold (relative) between
+// neighbouring coarse samples covering it, otherwise it is filled by bilinear
+// interpolation in grid-index space (linear in log r on a log axis).
+//
+// Finished tiles can be streamed to a .uqmap file as they complete, in whatever
+// order the threads finish them; keep_dense = false then avoids holding the map.
+//
+// Layout (all integers little-endian, native double):
+//   Header, padded with zeros to a multiple of 64 bytes
+//     char[8]  magic "UQFFMAP1"
+//     uint32   format version, uint32 byte-order tag 0x01020304
+//     uint32   channel count C, uint32 tile_r, uint32 tile_theta, uint32 0
+//     3 x { double lo, double hi, uint32 n, uint32 log }   axes r, theta, t
+//     uint64   header size in bytes
+//     C x { uint32 name length, name bytes }
+//   Tile, repeated until EOF
+//     uint32   t index, theta0, r0, theta count, r count, flags (1 = evaluated)
+//     uint32   CRC-32 of the data, uint32 0
+//     C x { theta count x r count doubles, r fastest }
+// A file from an interrupted run is readable up to its last complete tile.
+
+#include <string>
+#include <vector>
+#include <span>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <mutex>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include "uqff_checkpoint.h" // crc32
+
+namespace uqff_fieldmap
+{
+    constexpr char MAGIC[8] = {'U', 'Q', 'F', 'F', 'M', 'A', 'P', '1'};
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t BYTE_ORDER_TAG = 0x01020304;
+    constexpr uint32_t TILE_EVALUATED = 1;
+
+    // n points from lo to hi inclusive, evenly spaced in value or in log(value)
+    struct Axis
+    {
+        double lo = 0.0;
+        double hi = 0.0;
+        int n = 1;
+        bool log = false;
+
+        static Axis linear(double lo, double hi, int n) { return {lo, hi, n, false}; }
+        static Axis logarithmic(double lo, double hi, int n)
+        {
+            if (!(lo > 0.0) || !(hi > 0.0))
+                throw std::invalid_argument("FieldMap: log axis needs positive bounds");
+            return {lo, hi, n, true};
+        }
+
+        double at(int i) const
+        {
+            if (n <= 1 || i <= 0)
+                return lo;
+            if (i >= n - 1)
+                return hi;
+            const double f = static_cast<double>(i) / (n - 1);
+            return log ? std::exp(std::log(lo) + f * (std::log(hi) - std::log(lo))) : lo + f * (hi - lo);
+        }
+
+        std::vector<double> values() const
+        {
+            std::vector<double> v(static_cast<size_t>(std::max(n, 0)));
+            for (int i = 0; i < n; ++i)
+                v[i] = at(i);
+            return v;
+        }
+    };
+
+    struct Options
+    {
+        int tile_r = 256;
+        int tile_theta = 8;
+        double refine_threshold = 0.0; // 0 = evaluate every point
+        int coarse_stride = 8;         // coarse sample spacing in grid points (refine mode)
+        bool keep_dense = true;        // false: only stream tiles to the writer
+    };
+
+    struct Stats
+    {
+        size_t tiles = 0;
+        size_t tiles_evaluated = 0;    // point by point
+        size_t tiles_interpolated = 0; // from coarse samples
+        size_t points_evaluated = 0;   // evaluator calls x row length, coarse pass included
+        double seconds = 0.0;
+    };
+
+    // One rectangular block of a time slice
+    struct Tile
+    {
+        int t = 0;
+        int theta0 = 0;
+        int r0 = 0;
+        int n_theta = 0;
+        int n_r = 0;
+        bool evaluated = true;
+    };
+
+    // ========================================================================
+    // FIELD MAP (dense channels, index ((t * n_theta) + theta) * n_r + r)
+    // ========================================================================
+
+    class FieldMap
+    {
+    private:
+        Axis r_axis, theta_axis, t_axis;
+        std::vector<std::string> names;
+        std::vector<std::vector<double>> data;
+
+    public:
+        FieldMap() = default;
+        FieldMap(Axis r, Axis theta, Axis t, std::vector<std::string> channel_names)
+            : r_axis(r), theta_axis(theta), t_axis(t), names(std::move(channel_names)), data(names.size())
+        {
+            if (r.n < 1 || theta.n < 1 || t.n < 1)
+                throw std::invalid_argument("FieldMap: every axis needs at least one point");
+            if (names.empty())
+                throw std::invalid_argument("FieldMap: no channels");
+        }
+
+        const Axis &r() const { return r_axis; }
+        const Axis &theta() const { return theta_axis; }
+        const Axis &t() const { return t_axis; }
+        const std::vector<std::string> &channelNames() const { return names; }
+        int channels() const { return static_cast<int>(names.size()); }
+        size_t points() const { return static_cast<size_t>(r_axis.n) * theta_axis.n * t_axis.n; }
+        bool dense() const { return !data.empty() && data[0].size() == points(); }
+
+        int channelIndex(const std::string &name) const
+        {
+            for (size_t c = 0; c < names.size(); ++c)
+                if (names[c] == name)
+                    return static_cast<int>(c);
+            throw std::out_of_range("FieldMap: no channel '" + name + "'");
+        }
+
+        size_t index(int it, int ith, int ir) const
+        {
+            return (static_cast<size_t>(it) * theta_axis.n + ith) * r_axis.n + ir;
+        }
+
+        void allocate()
+        {
+            for (auto &channel : data)
+                channel.assign(points(), 0.0);
+        }
+
+        std::span<double> channel(int c) { return data[c]; }
+        std::span<const double> channel(int c) const { return data[c]; }
+        double value(int c, int it, int ith, int ir) const { return data[c][index(it, ith, ir)]; }
+
+        // Copy a tile laid out as C x n_theta x n_r (r fastest) into the dense arrays
+        void storeTile(const Tile &tile, const double *values)
+        {
+            const size_t row = static_cast<size_t>(tile.n_r);
+            const size_t plane = row * tile.n_theta;
+            for (size_t c = 0; c < data.size(); ++c)
+                for (int j = 0; j < tile.n_theta; ++j)
+                    std::memcpy(&data[c][index(tile.t, tile.theta0 + j, tile.r0)], values + c * plane + j * row,
+                                row * sizeof(double));
+        }
+    };
+
+    // ========================================================================
+    // WRITER (.uqmap tile stream)
+    // ========================================================================
+
+    class Writer
+    {
+    private:
+        std::FILE *file = nullptr;
+        std::string file_path;
+        size_t channel_count = 0;
+        std::mutex lock;
+        bool ok = true;
+
+        void put(const void *data, size_t bytes)
+        {
+            if (ok && bytes)
+                ok = std::fwrite(data, 1, bytes, file) == bytes;
+        }
+
+    public:
+        Writer(const std::string &path, const FieldMap &layout, const Options &opts) : file_path(path)
+        {
+            file = std::fopen(path.c_str(), "wb");
+            if (!file)
+                throw std::runtime_error("FieldMap: cannot open " + path);
+            channel_count = layout.channelNames().size();
+
+            std::vector<unsigned char> header(8 + 6 * 4 + 3 * 24 + 8);
+            unsigned char *p = header.data();
+            auto u32 = [&](uint32_t v)
+            { std::memcpy(p, &v, 4); p += 4; };
+            auto f64 = [&](double v)
+            { std::memcpy(p, &v, 8); p += 8; };
+
+            std::memcpy(p, MAGIC, 8);
+            p += 8;
+            u32(VERSION);
+            u32(BYTE_ORDER_TAG);
+            u32(static_cast<uint32_t>(channel_count));
+            u32(static_cast<uint32_t>(opts.tile_r));
+            u32(static_cast<uint32_t>(opts.tile_theta));
+            u32(0);
+            for (const Axis *a : {&layout.r(), &layout.theta(), &layout.t()})
+            {
+                f64(a->lo);
+                f64(a->hi);
+                u32(static_cast<uint32_t>(a->n));
+                u32(a->log ? 1u : 0u);
+            }
+            const size_t size_at = header.size() - 8;
+            for (const std::string &name : layout.channelNames())
+            {
+                const uint32_t len = static_cast<uint32_t>(name.size());
+                header.insert(header.end(), reinterpret_cast<const unsigned char *>(&len),
+                              reinterpret_cast<const unsigned char *>(&len) + 4);
+                header.insert(header.end(), name.begin(), name.end());
+            }
+            header.resize(uqff_checkpoint::padTo(header.size()), 0);
+            const uint64_t header_bytes = header.size();
+            std::memcpy(&header[size_at], &header_bytes, 8);
+            put(header.data(), header.size());
+        }
+
+        ~Writer()
+        {
+            if (file)
+                std::fclose(file);
+        }
+
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        // Thread-safe; values laid out as in FieldMap::storeTile
+        void writeTile(const Tile &tile, const double *values)
+        {
+            const size_t bytes = channel_count * tile.n_theta * tile.n_r * sizeof(double);
+            const uint32_t record[8] = {static_cast<uint32_t>(tile.t), static_cast<uint32_t>(tile.theta0),
+                                        static_cast<uint32_t>(tile.r0), static_cast<uint32_t>(tile.n_theta),
+                                        static_cast<uint32_t>(tile.n_r), tile.evaluated ? TILE_EVALUATED : 0u,
+                                        uqff_checkpoint::crc32(values, bytes), 0};
+            std::lock_guard<std::mutex> guard(lock);
+            put(record, sizeof(record));
+            put(values, bytes);
+        }
+
+        void close()
+        {
+            if (!file)
+                return;
+            ok = std::fflush(file) == 0 && ok;
+            ok = std::fclose(file) == 0 && ok;
+            file = nullptr;
+            if (!ok)
+                throw std::runtime_error("FieldMap: write failed for " + file_path);
+        }
+    };
+
+    // Reassemble a .uqmap file into a dense map; throws on checksum or layout errors.
+    // Points of tiles missing from a truncated file are NaN.
+    inline FieldMap read(const std::string &path, Stats *stats = nullptr)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            throw std::runtime_error("FieldMap: cannot open " + path);
+        std::vector<unsigned char> bytes;
+        unsigned char buffer[1 << 16];
+        for (size_t got; (got = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+            bytes.insert(bytes.end(), buffer, buffer + got);
+        std::fclose(file);
+
+        auto fail = [&](const std::string &why)
+        { return std::runtime_error("FieldMap " + path + ": " + why); };
+
+        const size_t fixed = 8 + 6 * 4 + 3 * 24 + 8;
+        if (bytes.size() < fixed || std::memcmp(bytes.data(), MAGIC, 8) != 0)
+            throw fail("not a field map file");
+        const unsigned char *p = bytes.data() + 8;
+        auto u32 = [&]
+        { uint32_t v; std::memcpy(&v, p, 4); p += 4; return v; };
+        auto f64 = [&]
+        { double v; std::memcpy(&v, p, 8); p += 8; return v; };
+
+        const uint32_t version = u32();
+        if (u32() != BYTE_ORDER_TAG)
+            throw fail("written on a machine with different byte order");
+        if (version > VERSION)
+            throw fail("format version " + std::to_string(version) + " is newer than this build");
+        const uint32_t channels = u32();
+        p += 12; // tile sizes, reserved
+        Axis axes[3];
+        for (Axis &a : axes)
+        {
+            a.lo = f64();
+            a.hi = f64();
+            a.n = static_cast<int>(u32());
+            a.log = u32() != 0;
+        }
+        uint64_t header_bytes;
+        std::memcpy(&header_bytes, p, 8);
+        p += 8;
+        if (header_bytes > bytes.size())
+            throw fail("truncated header");
+
+        std::vector<std::string> names;
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+            if (static_cast<size_t>(p - bytes.data()) + 4 > header_bytes)
+                throw fail("truncated channel table");
+            const uint32_t len = u32();
+            if (static_cast<size_t>(p - bytes.data()) + len > header_bytes)
+                throw fail("truncated channel table");
+            names.emplace_back(reinterpret_cast<const char *>(p), len);
+            p += len;
+        }
+
+        FieldMap map(axes[0], axes[1], axes[2], names);
+        map.allocate();
+        for (int c = 0; c < map.channels(); ++c)
+            std::fill(map.channel(c).begin(), map.channel(c).end(), std::numeric_limits<double>::quiet_NaN());
+
+        Stats local;
+        std::vector<double> values;
+        size_t pos = static_cast<size_t>(header_bytes);
+        while (bytes.size() - pos >= 32)
+        {
+            uint32_t record[8];
+            std::memcpy(record, &bytes[pos], 32);
+            Tile tile{static_cast<int>(record[0]), static_cast<int>(record[1]), static_cast<int>(record[2]),
+                      static_cast<int>(record[3]), static_cast<int>(record[4]), (record[5] & TILE_EVALUATED) != 0};
+            if (tile.t >= axes[2].n || tile.n_theta < 1 || tile.n_r < 1 ||
+                tile.theta0 + tile.n_theta > axes[1].n || tile.r0 + tile.n_r > axes[0].n)
+                throw fail("tile out of range at byte " + std::to_string(pos));
+            const size_t count = static_cast<size_t>(channels) * tile.n_theta * tile.n_r;
+            if ((bytes.size() - pos - 32) / sizeof(double) < count)
+                break; // interrupted mid-tile
+            values.resize(count);
+            std::memcpy(values.data(), &bytes[pos + 32], count * sizeof(double));
+            if (uqff_checkpoint::crc32(values.data(), count * sizeof(double)) != record[6])
+                throw fail("checksum mismatch in tile at byte " + std::to_string(pos));
+            map.storeTile(tile, values.data());
+            ++local.tiles;
+            ++(tile.evaluated ? local.tiles_evaluated : local.tiles_interpolated);
+            pos += 32 + count * sizeof(double);
+        }
+        if (stats)
+            *stats = local;
+        return map;
+    }
+
+    // ========================================================================
+    // GENERATOR
+    // ========================================================================
+
+    namespace detail
+    {
+        // Grid indices sampled in the coarse pass: every stride-th point plus the last
+        inline std::vector<int> coarseIndices(int n, int stride)
+        {
+            std::vector<int> idx;
+            for (int i = 0; i < n; i += stride)
+                idx.push_back(i);
+            if (idx.back() != n - 1)
+                idx.push_back(n - 1);
+            return idx;
+        }
+
+        // Position of fine index i between coarse samples: lower sample k and weight w
+        inline void bracket(const std::vector<int> &idx, int i, size_t &k, double &w)
+        {
+            k = static_cast<size_t>(std::upper_bound(idx.begin(), idx.end(), i) - idx.begin());
+            k = k == 0 ? 0 : k - 1;
+            if (k + 1 >= idx.size())
+            {
+                k = idx.size() >= 2 ? idx.size() - 2 : 0;
+                w = idx.size() >= 2 ? 1.0 : 0.0;
+                return;
+            }
+            w = static_cast<double>(i - idx[k]) / (idx[k + 1] - idx[k]);
+        }
+
+        inline bool exceeds(double a, double b, double threshold)
+        {
+            if (!std::isfinite(a) || !std::isfinite(b))
+                return true;
+            const double scale = std::max(std::abs(a), std::abs(b));
+            return scale > 0.0 && std::abs(a - b) > threshold * scale;
+        }
+    }
+
+    // Fill `map` (allocated here if opts.keep_dense) and/or stream it to `writer`.
+    // Exceptions thrown by the evaluator or the writer are rethrown after the
+    // parallel region; the first one wins.
+    template <typename Eval>
+    Stats generate(FieldMap &map, Eval &&eval, const Options &opts, Writer *writer = nullptr)
+    {
+        if (opts.tile_r < 1 || opts.tile_theta < 1 || opts.coarse_stride < 1)
+            throw std::invalid_argument("FieldMap: tile sizes and coarse_stride must be positive");
+        if (!opts.keep_dense && !writer)
+            throw std::invalid_argument("FieldMap: keep_dense = false needs a writer");
+
+        const auto start = std::chrono::steady_clock::now();
+        const Axis &ra = map.r(), &tha = map.theta(), &ta = map.t();
+        const int C = map.channels();
+        if (opts.keep_dense)
+            map.allocate();
+
+        const std::vector<double> r_values = ra.values();
+        const std::vector<double> theta_values = tha.values();
+        const bool refine = opts.refine_threshold > 0.0;
+        const std::vector<int> coarse_r = refine ? detail::coarseIndices(ra.n, opts.coarse_stride) : std::vector<int>();
+        const std::vector<int> coarse_th = refine ? detail::coarseIndices(tha.n, opts.coarse_stride) : std::vector<int>();
+        const size_t ncr = coarse_r.size(), ncth = coarse_th.size();
+
+        std::vector<Tile> tiles;
+        for (int j = 0; j < tha.n; j += opts.tile_theta)
+            for (int i = 0; i < ra.n; i += opts.tile_r)
+                tiles.push_back({0, j, i, std::min(opts.tile_theta, tha.n - j), std::min(opts.tile_r, ra.n - i), true});
+
+        Stats stats;
+        std::exception_ptr error;
+        std::mutex error_lock;
+        auto record = [&](std::exception_ptr e)
+        {
+            std::lock_guard<std::mutex> guard(error_lock);
+            if (!error)
+                error = e;
+        };
+
+        // C x ncth x ncr coarse samples of the current slice
+        std::vector<double> coarse(static_cast<size_t>(C) * ncth * ncr);
+        std::vector<double> coarse_r_values(ncr);
+        for (size_t a = 0; a < ncr; ++a)
+            coarse_r_values[a] = r_values[coarse_r[a]];
+
+        for (int it = 0; it < ta.n && !error; ++it)
+        {
+            const double t = ta.at(it);
+
+            if (refine)
+            {
+#pragma omp parallel
+                {
+                    std::vector<double> row(static_cast<size_t>(C) * ncr);
+                    std::vector<double *> out(C);
+#pragma omp for schedule(dynamic)
+                    for (long b = 0; b < static_cast<long>(ncth); ++b)
+                    {
+                        try
+                        {
+                            for (int c = 0; c < C; ++c)
+                                out[c] = row.data() + c * ncr;
+                            eval(t, theta_values[coarse_th[b]], coarse_r_values.data(), ncr, out.data());
+                            for (int c = 0; c < C; ++c)
+                                std::copy(out[c], out[c] + ncr, coarse.begin() + (c * ncth + b) * ncr);
+                        }
+                        catch (...)
+                        {
+                            record(std::current_exception());
+                        }
+                    }
+                }
+                stats.points_evaluated += ncth * ncr;
+                if (error)
+                    break;
+            }
+
+            size_t evaluated = 0, interpolated = 0, points = 0;
+#pragma omp parallel reduction(+ : evaluated, interpolated, points)
+            {
+                std::vector<double> values(static_cast<size_t>(C) * opts.tile_theta * opts.tile_r);
+                std::vector<double *> out(C);
+#pragma omp for schedule(dynamic)
+                for (long k = 0; k < static_cast<long>(tiles.size()); ++k)
+                {
+                    try
+                    {
+                        Tile tile = tiles[k];
+                        tile.t = it;
+                        const size_t plane = static_cast<size_t>(tile.n_theta) * tile.n_r;
+
+                        // Coarse cells covering the tile, including the samples that bracket it
+                        size_t a0 = 0, a1 = 0, b0 = 0, b1 = 0;
+                        double w;
+                        if (refine)
+                        {
+                            detail::bracket(coarse_r, tile.r0, a0, w);
+                            detail::bracket(coarse_r, tile.r0 + tile.n_r - 1, a1, w);
+                            detail::bracket(coarse_th, tile.theta0, b0, w);
+                            detail::bracket(coarse_th, tile.theta0 + tile.n_theta - 1, b1, w);
+                            a1 = std::min(a1 + 1, ncr - 1);
+                            b1 = std::min(b1 + 1, ncth - 1);
+                            tile.evaluated = false;
+                            for (int c = 0; c < C && !tile.evaluated; ++c)
+                            {
+                                const double *g = coarse.data() + c * ncth * ncr;
+                                for (size_t b = b0; b <= b1 && !tile.evaluated; ++b)
+                                    for (size_t a = a0; a <= a1 && !tile.evaluated; ++a)
+                                    {
+                                        const double v = g[b * ncr + a];
+                                        if ((a < a1 && detail::exceeds(v, g[b * ncr + a + 1], opts.refine_threshold)) ||
+                                            (b < b1 && detail::exceeds(v, g[(b + 1) * ncr + a], opts.refine_threshold)) ||
+                                            (a0 == a1 && b0 == b1 && !std::isfinite(v)))
+                                            tile.evaluated = true;
+                                    }
+                            }
+                        }
+
+                        if (tile.evaluated)
+                        {
+                            for (int j = 0; j < tile.n_theta; ++j)
+                            {
+                                for (int c = 0; c < C; ++c)
+                                    out[c] = values.data() + c * plane + static_cast<size_t>(j) * tile.n_r;
+                                eval(t, theta_values[tile.theta0 + j], r_values.data() + tile.r0,
+                                     static_cast<size_t>(tile.n_r), out.data());
+                            }
+                            ++evaluated;
+                            points += plane;
+                        }
+                        else
+                        {
+                            for (int j = 0; j < tile.n_theta; ++j)
+                            {
+                                size_t b;
+                                double wb;
+                                detail::bracket(coarse_th, tile.theta0 + j, b, wb);
+                                const size_t b2 = std::min(b + 1, ncth - 1);
+                                for (int i = 0; i < tile.n_r; ++i)
+                                {
+                                    size_t a;
+                                    double wa;
+                                    detail::bracket(coarse_r, tile.r0 + i, a, wa);
+                                    const size_t a2 = std::min(a + 1, ncr - 1);
+                                    for (int c = 0; c < C; ++c)
+                                    {
+                                        const double *g = coarse.data() + c * ncth * ncr;
+                                        const double lo = g[b * ncr + a] + wa * (g[b * ncr + a2] - g[b * ncr + a]);
+                                        const double hi = g[b2 * ncr + a] + wa * (g[b2 * ncr + a2] - g[b2 * ncr + a]);
+                                        values[c * plane + static_cast<size_t>(j) * tile.n_r + i] = lo + wb * (hi - lo);
+                                    }
+                                }
+                            }
+                            ++interpolated;
+                        }
+
+                        if (opts.keep_dense)
+                            map.storeTile(tile, values.data());
+                        if (writer)
+                            writer->writeTile(tile, values.data());
+                    }
+                    catch (...)
+                    {
+                        record(std::current_exception());
+                    }
+                }
+            }
+            stats.tiles += tiles.size();
+            stats.tiles_evaluated += evaluated;
+            stats.tiles_interpolated += interpolated;
+            stats.points_evaluated += points;
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+}
+
+#endif // UQFF_FIELDMAP_H
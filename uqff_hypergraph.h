@@ -0,0 +1,282 @@
+#ifndef UQFF_HYPERGRAPH_H
+#define UQFF_HYPERGRAPH_H
+
+// Hypergraph store for rule evolution (WolframFieldUnityEngine)
+// Edges:      CSR (edge_offsets / edge_nodes), appending an edge is a push_back.
+//             Removed edges keep their id and are only marked dead (rewriting
+//             rules consume their left-hand side).
+// Incidence:  node -> edges containing it, kept current on every append:
+//   - a CSR part covering the edges up to the last compaction, and
+//   - a delta of later incidences, one linked list per node in flat arrays.
+//   When the delta (or the dead entries) outgrow the CSR part, everything is merged
+//   with a counting sort, so updates are amortized O(edge size) and lookups stay
+//   mostly contiguous. After compact() every list is one sorted CSR range.
+// Ball queries (BFS to a radius) touch only the incidences of nodes in the ball;
+// visited marks are epoch stamps, so nothing is cleared between queries.
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+
+namespace uqff_hypergraph
+{
+    class HypergraphStore
+    {
+    public:
+        using Node = int;
+        using EdgeId = uint32_t;
+
+        HypergraphStore() = default;
+
+        explicit HypergraphStore(const std::vector<std::vector<Node>> &edges)
+        {
+            size_t total = 0;
+            for (const auto &e : edges)
+                total += e.size();
+            edge_nodes.reserve(total);
+            edge_offsets.reserve(edges.size() + 1);
+            for (const auto &e : edges)
+                addEdge(e);
+        }
+
+        size_t edgeCount() const { return edge_offsets.size() - 1; } // edge ids issued, dead included
+        size_t liveEdgeCount() const { return edgeCount() - dead_edges; }
+        bool isLive(EdgeId e) const { return alive[e] != 0; }
+        size_t incidenceCount() const { return csr_edges.size() + delta_edge.size() - dead_incidences; }
+        size_t nodeSlots() const { return degrees.size(); } // max node + 1
+        Node maxNode() const { return static_cast<Node>(degrees.size()) - 1; }
+
+        std::span<const Node> edge(EdgeId e) const
+        {
+            return {edge_nodes.data() + edge_offsets[e], edge_offsets[e + 1] - edge_offsets[e]};
+        }
+
+        // Number of distinct edges containing n
+        size_t degree(Node n) const { return n >= 0 && static_cast<size_t>(n) < degrees.size() ? degrees[n] : 0; }
+
+        EdgeId addEdge(std::span<const Node> nodes)
+        {
+            if (edgeCount() >= std::numeric_limits<EdgeId>::max())
+                throw std::length_error("HypergraphStore: edge id overflow");
+            for (Node n : nodes)
+            {
+                if (n < 0)
+                    throw std::invalid_argument("HypergraphStore: negative node id");
+            }
+            const EdgeId id = static_cast<EdgeId>(edgeCount());
+            const size_t start = edge_nodes.size();
+            alive.push_back(1);
+            for (Node n : nodes)
+            {
+                if (static_cast<size_t>(n) >= degrees.size())
+                    growNodes(static_cast<size_t>(n) + 1);
+                // Index each distinct node once (edges are small, a linear check is cheapest)
+                if (std::find(edge_nodes.begin() + start, edge_nodes.end(), n) == edge_nodes.end())
+                {
+                    appendIncidence(n, id);
+                    ++degrees[n];
+                }
+                edge_nodes.push_back(n);
+            }
+            edge_offsets.push_back(edge_nodes.size());
+            compactIfWorthwhile();
+            return id;
+        }
+
+        // Mark an edge dead; its id is not reused and edge(e) stays readable
+        void removeEdge(EdgeId e)
+        {
+            if (!alive[e])
+                return;
+            alive[e] = 0;
+            ++dead_edges;
+            auto nodes = edge(e);
+            for (size_t i = 0; i < nodes.size(); ++i)
+            {
+                if (std::find(nodes.begin(), nodes.begin() + i, nodes[i]) == nodes.begin() + i)
+                {
+                    --degrees[nodes[i]];
+                    ++dead_incidences;
+                }
+            }
+            compactIfWorthwhile();
+        }
+
+        EdgeId addEdge(std::initializer_list<Node> nodes) { return addEdge(std::span<const Node>(nodes.begin(), nodes.size())); }
+
+        // f(EdgeId) for every live edge containing n, in increasing edge order
+        template <typename F>
+        void forEachIncidentEdge(Node n, F &&f) const
+        {
+            if (n < 0 || static_cast<size_t>(n) >= degrees.size())
+                return;
+            if (static_cast<size_t>(n) + 1 < csr_offsets.size())
+            {
+                for (size_t k = csr_offsets[n]; k < csr_offsets[n + 1]; ++k)
+                    if (alive[csr_edges[k]])
+                        f(csr_edges[k]);
+            }
+            for (uint32_t k = delta_head[n]; k != NONE; k = delta_next[k])
+                if (alive[delta_edge[k]])
+                    f(delta_edge[k]);
+        }
+
+        // No delta and no dead entries: every incidence list is one sorted CSR range
+        bool isCompacted() const { return delta_edge.empty() && dead_incidences == 0; }
+
+        // Live edges containing n, ascending; only valid while isCompacted()
+        std::span<const EdgeId> incidentEdges(Node n) const
+        {
+            if (n < 0 || static_cast<size_t>(n) + 1 >= csr_offsets.size())
+                return {};
+            return {csr_edges.data() + csr_offsets[n], csr_offsets[n + 1] - csr_offsets[n]};
+        }
+
+        // Number of nodes within `radius` hops of `center` (a hop = sharing an edge).
+        // Cost is proportional to the incidences of the ball, not to the graph.
+        // Uses per-store scratch: do not query one store from several threads at once.
+        size_t ballSize(Node center, int radius) const
+        {
+            nextEpoch();
+            frontier.clear();
+            frontier.push_back(center);
+            markNode(center);
+            size_t visited = 1;
+            for (int dist = 0; dist < radius && !frontier.empty(); ++dist)
+            {
+                next_frontier.clear();
+                for (Node node : frontier)
+                {
+                    forEachIncidentEdge(node, [&](EdgeId e)
+                                        {
+                        if (edge_stamp[e] == epoch)
+                            return; // every node of an expanded edge is already visited
+                        edge_stamp[e] = epoch;
+                        for (Node n : edge(e))
+                        {
+                            if (node_stamp[n] != epoch)
+                            {
+                                node_stamp[n] = epoch;
+                                next_frontier.push_back(n);
+                                ++visited;
+                            }
+                        } });
+                }
+                frontier.swap(next_frontier);
+            }
+            return visited;
+        }
+
+        // Live edges in id order
+        std::vector<std::vector<Node>> toVectors() const
+        {
+            std::vector<std::vector<Node>> out;
+            out.reserve(liveEdgeCount());
+            for (size_t e = 0; e < edgeCount(); ++e)
+            {
+                if (!alive[e])
+                    continue;
+                auto nodes = edge(static_cast<EdgeId>(e));
+                out.emplace_back(nodes.begin(), nodes.end());
+            }
+            return out;
+        }
+
+        // Merge the delta into the CSR incidence part and drop dead edges (counting sort by node)
+        void compact()
+        {
+            const size_t slots = degrees.size();
+            std::vector<size_t> offsets(slots + 1, 0);
+            for (size_t n = 0; n < slots; ++n)
+                offsets[n + 1] = offsets[n] + degrees[n];
+            std::vector<EdgeId> merged(offsets[slots]);
+            for (size_t n = 0; n < slots; ++n)
+            {
+                size_t out = offsets[n];
+                forEachIncidentEdge(static_cast<Node>(n), [&](EdgeId e)
+                                    { merged[out++] = e; });
+            }
+            csr_offsets.swap(offsets);
+            csr_edges.swap(merged);
+            dead_incidences = 0;
+            delta_edge.clear();
+            delta_next.clear();
+            std::fill(delta_head.begin(), delta_head.end(), NONE);
+            std::fill(delta_tail.begin(), delta_tail.end(), NONE);
+        }
+
+    private:
+        static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+        static constexpr size_t COMPACT_MIN = 4096;
+
+        std::vector<size_t> edge_offsets{0};
+        std::vector<Node> edge_nodes;
+        std::vector<uint8_t> alive; // per edge
+        size_t dead_edges = 0;
+        size_t dead_incidences = 0; // dead entries still in the incidence lists
+
+        std::vector<uint32_t> degrees;   // per node
+        std::vector<size_t> csr_offsets; // per node + 1, covers nodes known at the last compaction
+        std::vector<EdgeId> csr_edges;
+        std::vector<EdgeId> delta_edge; // incidences appended since, linked per node in edge order
+        std::vector<uint32_t> delta_next;
+        std::vector<uint32_t> delta_head, delta_tail;
+
+        // BFS scratch (epoch-stamped visited marks)
+        mutable uint32_t epoch = 0;
+        mutable std::vector<uint32_t> node_stamp, edge_stamp;
+        mutable std::vector<Node> frontier, next_frontier;
+
+        void compactIfWorthwhile()
+        {
+            if (delta_edge.size() + dead_incidences > std::max<size_t>(COMPACT_MIN, csr_edges.size()))
+                compact();
+        }
+
+        void growNodes(size_t slots)
+        {
+            degrees.resize(slots, 0);
+            delta_head.resize(slots, NONE);
+            delta_tail.resize(slots, NONE);
+        }
+
+        void appendIncidence(Node n, EdgeId e)
+        {
+            if (delta_edge.size() >= NONE)
+                compact();
+            const uint32_t k = static_cast<uint32_t>(delta_edge.size());
+            delta_edge.push_back(e);
+            delta_next.push_back(NONE);
+            if (delta_tail[n] == NONE)
+                delta_head[n] = k;
+            else
+                delta_next[delta_tail[n]] = k;
+            delta_tail[n] = k;
+        }
+
+        void nextEpoch() const
+        {
+            node_stamp.resize(std::max(node_stamp.size(), degrees.size()), epoch);
+            edge_stamp.resize(std::max(edge_stamp.size(), edgeCount()), epoch);
+            if (++epoch == 0) // wrapped: old stamps could alias the new epoch
+            {
+                std::fill(node_stamp.begin(), node_stamp.end(), 0);
+                std::fill(edge_stamp.begin(), edge_stamp.end(), 0);
+                epoch = 1;
+            }
+        }
+
+        void markNode(Node n) const
+        {
+            if (n >= 0 && static_cast<size_t>(n) < node_stamp.size())
+                node_stamp[n] = epoch;
+        }
+    };
+}
+
+#endif // UQFF_HYPERGRAPH_H
@@ -0,0 +1,245 @@
+#ifndef UQFF_MONTECARLO_H
+#define UQFF_MONTECARLO_H
+
+// Monte-Carlo helpers for uncertainty bands (MUGE, buoyancy, ...)
+// Random numbers come from Philox4x32-10 (Salmon et al., "Parallel random numbers:
+// as easy as 1, 2, 3", SC'11): a counter-based generator, so draw k of stream s is a
+// pure function of (seed, s, k). Any thread can produce any draw without shared
+// state, and a run gives the same samples for any thread count or chunk size.
+// Each input parameter gets its own stream; sample k of every parameter is draw k.
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace uqff_montecarlo
+{
+    // ========================================================================
+    // PHILOX 4x32-10
+    // ========================================================================
+
+    class Philox
+    {
+    public:
+        using Block = std::array<uint32_t, 4>;
+
+        explicit Philox(uint64_t seed = 0)
+            : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}
+        {
+        }
+
+        // 128 random bits for counter (stream, index)
+        Block operator()(uint64_t stream, uint64_t index) const
+        {
+            return generate({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                             static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)});
+        }
+
+        Block generate(Block ctr) const
+        {
+            uint32_t k0 = key[0], k1 = key[1];
+            for (int round = 0; round < 10; ++round)
+            {
+                const uint64_t p0 = uint64_t(0xD2511F53u) * ctr[0];
+                const uint64_t p1 = uint64_t(0xCD9E8D57u) * ctr[2];
+                ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k0, static_cast<uint32_t>(p1),
+                       static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k1, static_cast<uint32_t>(p0)};
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            return ctr;
+        }
+
+        // Uniform in the open interval (0, 1) from 64 bits
+        static double toUniform(uint32_t hi, uint32_t lo)
+        {
+            const uint64_t bits = (uint64_t(hi) << 32 | lo) >> 11;
+            return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+        }
+
+        double uniform(uint64_t stream, uint64_t index) const
+        {
+            const Block b = (*this)(stream, index);
+            return toUniform(b[0], b[1]);
+        }
+
+        // Standard normal (Box-Muller on the two uniforms of one block)
+        double normal(uint64_t stream, uint64_t index) const
+        {
+            const Block b = (*this)(stream, index);
+            const double u1 = toUniform(b[0], b[1]), u2 = toUniform(b[2], b[3]);
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+        }
+
+        std::array<uint32_t, 2> keyWords() const { return key; }
+
+    private:
+        std::array<uint32_t, 2> key;
+    };
+
+    // ========================================================================
+    // INPUT DISTRIBUTIONS
+    // ========================================================================
+
+    struct Distribution
+    {
+        enum class Kind
+        {
+            Fixed,     // a
+            Uniform,   // [a, b)
+            Normal,    // mean a, standard deviation b
+            LogNormal, // median a, standard deviation b of ln(x)
+        };
+
+        Kind kind = Kind::Fixed;
+        double a = 0.0;
+        double b = 0.0;
+
+        static Distribution fixed(double value) { return {Kind::Fixed, value, 0.0}; }
+        static Distribution uniform(double lo, double hi) { return {Kind::Uniform, lo, hi}; }
+        static Distribution normal(double mean, double sd) { return {Kind::Normal, mean, sd}; }
+        static Distribution lognormal(double median, double sigma) { return {Kind::LogNormal, median, sigma}; }
+
+        // Relative spread `rel` around a nominal value: log-normal for positive values
+        // (keeps masses, radii, densities positive), normal otherwise, fixed at zero
+        static Distribution around(double nominal, double rel)
+        {
+            if (nominal > 0.0)
+                return lognormal(nominal, rel);
+            if (nominal < 0.0)
+                return normal(nominal, -rel * nominal);
+            return fixed(0.0);
+        }
+
+        double draw(const Philox &rng, uint64_t stream, uint64_t index) const
+        {
+            switch (kind)
+            {
+            case Kind::Fixed:
+                return a;
+            case Kind::Uniform:
+                return a + (b - a) * rng.uniform(stream, index);
+            case Kind::Normal:
+                return a + b * rng.normal(stream, index);
+            case Kind::LogNormal:
+                return a * std::exp(b * rng.normal(stream, index));
+            }
+            return a;
+        }
+    };
+
+    // out[k] = draw (first + k) of `stream`, in parallel
+    inline void sample(const Distribution &dist, const Philox &rng, uint64_t stream, uint64_t first, std::span<double> out)
+    {
+        const long n = static_cast<long>(out.size());
+        if (dist.kind == Distribution::Kind::Fixed)
+        {
+            std::fill(out.begin(), out.end(), dist.a);
+            return;
+        }
+#pragma omp parallel for schedule(static)
+        for (long k = 0; k < n; ++k)
+            out[k] = dist.draw(rng, stream, first + static_cast<uint64_t>(k));
+    }
+
+    // ========================================================================
+    // SUMMARY (moments, quantiles, histogram)
+    // ========================================================================
+
+    struct Histogram
+    {
+        double lo = 0.0, hi = 0.0; // range of the finite samples
+        std::vector<size_t> counts;
+
+        double binWidth() const { return counts.empty() ? 0.0 : (hi - lo) / static_cast<double>(counts.size()); }
+    };
+
+    struct Summary
+    {
+        size_t count = 0;     // finite samples
+        size_t nonfinite = 0; // NaN / inf samples, left out of everything below
+        double mean = std::numeric_limits<double>::quiet_NaN();
+        double stddev = std::numeric_limits<double>::quiet_NaN();
+        double min = std::numeric_limits<double>::quiet_NaN();
+        double max = std::numeric_limits<double>::quiet_NaN();
+        std::vector<double> probs;     // requested probabilities
+        std::vector<double> quantiles; // one per prob (linear interpolation between order statistics)
+        Histogram histogram;
+    };
+
+    // Standard band: median, 1-sigma and 2-sigma equivalents
+    inline const std::vector<double> &defaultProbs()
+    {
+        static const std::vector<double> probs = {0.025, 0.16, 0.5, 0.84, 0.975};
+        return probs;
+    }
+
+    // Summarize `values`; the span is reordered (finite values sorted to the front)
+    inline Summary summarize(std::span<double> values, std::span<const double> probs = defaultProbs(), size_t bins = 64)
+    {
+        Summary s;
+        auto finite_end = std::partition(values.begin(), values.end(), [](double v)
+                                         { return std::isfinite(v); });
+        const std::span<double> x = values.first(static_cast<size_t>(finite_end - values.begin()));
+        s.count = x.size();
+        s.nonfinite = values.size() - x.size();
+        s.probs.assign(probs.begin(), probs.end());
+        s.quantiles.assign(probs.size(), std::numeric_limits<double>::quiet_NaN());
+        if (x.empty())
+            return s;
+
+        std::sort(x.begin(), x.end());
+        s.min = x.front();
+        s.max = x.back();
+
+        // Two-pass moments on values scaled by max |x|, so squares of huge terms
+        // (resonance MUGE reaches 1e150+) do not overflow
+        const double scale = std::max(std::abs(s.min), std::abs(s.max));
+        const double inv = scale > 0.0 ? 1.0 / scale : 1.0;
+        double sum = 0.0;
+        for (double v : x)
+            sum += v * inv;
+        const double mean = sum / static_cast<double>(x.size());
+        double ss = 0.0, sc = 0.0;
+        for (double v : x)
+        {
+            const double d = v * inv - mean;
+            ss += d * d;
+            sc += d;
+        }
+        s.mean = s.min == s.max ? s.min : mean / inv;
+        s.stddev = x.size() > 1 && s.min != s.max ? std::sqrt((ss - sc * sc / static_cast<double>(x.size())) / static_cast<double>(x.size() - 1)) / inv : 0.0;
+
+        for (size_t q = 0; q < probs.size(); ++q)
+        {
+            if (!(probs[q] >= 0.0 && probs[q] <= 1.0))
+                throw std::invalid_argument("summarize: probability outside [0, 1]");
+            const double pos = probs[q] * static_cast<double>(x.size() - 1);
+            const size_t k = static_cast<size_t>(pos);
+            const double frac = pos - static_cast<double>(k);
+            s.quantiles[q] = k + 1 < x.size() ? x[k] + frac * (x[k + 1] - x[k]) : x[k];
+        }
+
+        s.histogram.lo = s.min;
+        s.histogram.hi = s.max;
+        s.histogram.counts.assign(bins, 0);
+        if (bins > 0)
+        {
+            const double width = s.histogram.binWidth();
+            for (double v : x)
+            {
+                size_t bin = width > 0.0 ? static_cast<size_t>((v - s.min) / width) : 0;
+                ++s.histogram.counts[std::min(bin, bins - 1)];
+            }
+        }
+        return s;
+    }
+}
+
+#endif // UQFF_MONTECARLO_H
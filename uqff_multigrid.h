@@ -0,0 +1,377 @@
+#ifndef UQFF_MULTIGRID_H
+#define UQFF_MULTIGRID_H
+
+// Geometric multigrid solver for the FluidSolver pressure/diffusion systems
+// Solves  diag * x(i,j) - off * (x(i-1,j) + x(i+1,j) + x(i,j-1) + x(i,j+1)) = rhs(i,j)
+// on the Stable Fluids (n+2) x (n+2) cell-centred grid, index i + (n+2)*j, with
+// the same ghost-cell rule as FluidSolver::set_bnd(b):
+//   b == 0  ghost = interior on all sides (pressure, density)
+//   b == 1  ghost = -interior on the x walls (u)
+//   b == 2  ghost = -interior on the y walls (v)
+// project():  diag = 4,       off = 1
+// diffuse():  diag = 1 + 4a,  off = a
+//
+// V-cycle: red-black Gauss-Seidel smoothing, 4-cell average restriction,
+// bilinear prolongation, operator re-discretised on each coarser grid.
+// Cycles run until ||r||_2 <= tolerance * ||rhs||_2 or max_cycles is reached.
+// The grid halves while n is even and above min_size. The coarsest grid is
+// solved with conjugate gradients (the operator is symmetric for all three
+// ghost rules), so sizes that stop halving early (n = 100 stops at 25) still
+// converge; they just spend more of each cycle there.
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+struct MultigridStats
+{
+    int cycles = 0;
+    int levels = 0;
+    double initial_residual = 0.0; // ||rhs - A x0||_2 / ||rhs||_2
+    double residual = 0.0;         // same, after the last cycle
+    bool converged = false;
+};
+
+class MultigridSolver
+{
+public:
+    struct Options
+    {
+        double tolerance = 1e-6;
+        int max_cycles = 30;
+        int pre_smooth = 2;
+        int post_smooth = 2;
+        double coarse_tolerance = 1e-8; // CG on the coarsest grid, relative to its rhs
+        int min_size = 4;       // stop coarsening at or below this many cells per side
+    };
+
+private:
+    struct Level
+    {
+        int n = 0;
+        double diag = 0.0;
+        double off = 0.0;
+        std::vector<double> x;   // unused on level 0 (caller's buffer)
+        std::vector<double> rhs; // level 0: zero-mean copy for the singular case
+        std::vector<double> res;
+        std::vector<double> dir, image; // CG direction and A * direction (coarsest level only)
+    };
+
+    Options opts;
+    std::vector<Level> levels;
+
+    static size_t at(int n, int i, int j) { return static_cast<size_t>(i) + static_cast<size_t>(n + 2) * static_cast<size_t>(j); }
+
+    // Red-black sweep of one colour; cells with (i + j) % 2 == colour are updated
+    static void relaxColour(int n, int b, double *x, const double *rhs, double diag, double off, int colour)
+    {
+        const double inv = 1.0 / diag;
+        const int stride = n + 2;
+#pragma omp parallel for if (n >= 256)
+        for (int j = 1; j <= n; ++j)
+        {
+            double *row = x + at(n, 0, j);
+            const double *r = rhs + at(n, 0, j);
+            for (int i = 1 + ((j + colour + 1) & 1); i <= n; i += 2)
+            {
+                row[i] = (r[i] + off * (row[i - 1] + row[i + 1] + row[i - stride] + row[i + stride])) * inv;
+            }
+        }
+        setBoundary(b, x, n);
+    }
+
+    static void smooth(int n, int b, double *x, const double *rhs, double diag, double off, int sweeps)
+    {
+        for (int s = 0; s < sweeps; ++s)
+        {
+            relaxColour(n, b, x, rhs, diag, off, 0);
+            relaxColour(n, b, x, rhs, diag, off, 1);
+        }
+    }
+
+    // res = rhs - A x; returns sum(res^2)
+    static double residual(int n, const double *x, const double *rhs, double *res, double diag, double off)
+    {
+        const int stride = n + 2;
+        double sq = 0.0;
+#pragma omp parallel for reduction(+ : sq) if (n >= 256)
+        for (int j = 1; j <= n; ++j)
+        {
+            const double *row = x + at(n, 0, j);
+            const double *r = rhs + at(n, 0, j);
+            double *out = res + at(n, 0, j);
+            for (int i = 1; i <= n; ++i)
+            {
+                double v = r[i] - (diag * row[i] - off * (row[i - 1] + row[i + 1] + row[i - stride] + row[i + stride]));
+                out[i] = v;
+                sq += v * v;
+            }
+        }
+        return sq;
+    }
+
+    // Coarse cell (I,J) takes the average of the 2x2 fine cells it covers
+    static void restrictAverage(int nf, const double *fine, int nc, double *coarse)
+    {
+#pragma omp parallel for if (nc >= 128)
+        for (int J = 1; J <= nc; ++J)
+        {
+            const double *f0 = fine + at(nf, 0, 2 * J - 1);
+            const double *f1 = fine + at(nf, 0, 2 * J);
+            double *c = coarse + at(nc, 0, J);
+            for (int I = 1; I <= nc; ++I)
+            {
+                c[I] = 0.25 * (f0[2 * I - 1] + f0[2 * I] + f1[2 * I - 1] + f1[2 * I]);
+            }
+        }
+    }
+
+    // fine += bilinear interpolation of the coarse correction (needs coarse ghosts set)
+    static void prolongAdd(int nc, const double *coarse, int nf, double *fine)
+    {
+#pragma omp parallel for if (nf >= 256)
+        for (int j = 1; j <= nf; ++j)
+        {
+            const int J = (j + 1) / 2;
+            const int Jn = (j & 1) ? J - 1 : J + 1; // nearer coarse neighbour row
+            const double *c0 = coarse + at(nc, 0, J);
+            const double *c1 = coarse + at(nc, 0, Jn);
+            double *f = fine + at(nf, 0, j);
+            for (int i = 1; i <= nf; ++i)
+            {
+                const int I = (i + 1) / 2;
+                const int In = (i & 1) ? I - 1 : I + 1;
+                f[i] += 0.5625 * c0[I] + 0.1875 * (c0[In] + c1[I]) + 0.0625 * c1[In];
+            }
+        }
+    }
+
+    void vcycle(size_t l, int b, double *x, const double *rhs)
+    {
+        Level &L = levels[l];
+        if (l + 1 == levels.size())
+        {
+            coarseSolve(L, b, x, rhs);
+            return;
+        }
+
+        smooth(L.n, b, x, rhs, L.diag, L.off, opts.pre_smooth);
+
+        residual(L.n, x, rhs, L.res.data(), L.diag, L.off);
+
+        Level &C = levels[l + 1];
+        restrictAverage(L.n, L.res.data(), C.n, C.rhs.data());
+        if (singular(b))
+        {
+            // Keep the coarse problem consistent against round-off
+            const double mean = meanInterior(C.n, C.rhs.data());
+            for (int j = 1; j <= C.n; ++j)
+                for (int i = 1; i <= C.n; ++i)
+                    C.rhs[at(C.n, i, j)] -= mean;
+        }
+        std::fill(C.x.begin(), C.x.end(), 0.0);
+        vcycle(l + 1, b, C.x.data(), C.rhs.data());
+        setBoundary(b, C.x.data(), C.n);
+
+        prolongAdd(C.n, C.x.data(), L.n, x);
+        setBoundary(b, x, L.n);
+
+        smooth(L.n, b, x, rhs, L.diag, L.off, opts.post_smooth);
+    }
+
+    // out = A x on the interior (x ghosts must be set); returns x . out
+    static double apply(int n, const double *x, double *out, double diag, double off)
+    {
+        const int stride = n + 2;
+        double dot = 0.0;
+#pragma omp parallel for reduction(+ : dot) if (n >= 256)
+        for (int j = 1; j <= n; ++j)
+        {
+            const double *row = x + at(n, 0, j);
+            double *o = out + at(n, 0, j);
+            for (int i = 1; i <= n; ++i)
+            {
+                o[i] = diag * row[i] - off * (row[i - 1] + row[i + 1] + row[i - stride] + row[i + stride]);
+                dot += row[i] * o[i];
+            }
+        }
+        return dot;
+    }
+
+    // Conjugate gradients to coarse_tolerance; in the singular case the residual is
+    // kept zero-mean, so x converges up to a constant
+    void coarseSolve(Level &L, int b, double *x, const double *rhs)
+    {
+        const int n = L.n;
+        double *r = L.res.data(), *p = L.dir.data(), *q = L.image.data();
+        setBoundary(b, x, n);
+        double rr = residual(n, x, rhs, r, L.diag, L.off);
+        if (singular(b))
+            rr = removeMean(n, r);
+        const double stop = rr * opts.coarse_tolerance * opts.coarse_tolerance;
+        std::copy(L.res.begin(), L.res.end(), L.dir.begin());
+        const int max_iterations = 2 * n * n;
+        for (int it = 0; it < max_iterations && rr > stop && rr > 0.0; ++it)
+        {
+            setBoundary(b, p, n);
+            const double pq = apply(n, p, q, L.diag, L.off);
+            if (!(pq > 0.0))
+                break;
+            const double alpha = rr / pq;
+            for (int j = 1; j <= n; ++j)
+            {
+                for (int i = 1; i <= n; ++i)
+                {
+                    x[at(n, i, j)] += alpha * p[at(n, i, j)];
+                    r[at(n, i, j)] -= alpha * q[at(n, i, j)];
+                }
+            }
+            const double rr_next = singular(b) ? removeMean(n, r) : dot(n, r, r);
+            const double beta = rr_next / rr;
+            rr = rr_next;
+            for (int j = 1; j <= n; ++j)
+                for (int i = 1; i <= n; ++i)
+                    p[at(n, i, j)] = r[at(n, i, j)] + beta * p[at(n, i, j)];
+        }
+        setBoundary(b, x, n);
+    }
+
+    static double dot(int n, const double *a, const double *c)
+    {
+        double s = 0.0;
+        for (int j = 1; j <= n; ++j)
+            for (int i = 1; i <= n; ++i)
+                s += a[at(n, i, j)] * c[at(n, i, j)];
+        return s;
+    }
+
+    // Subtract the interior mean; returns the remaining sum of squares
+    static double removeMean(int n, double *x)
+    {
+        const double mean = meanInterior(n, x);
+        double sq = 0.0;
+        for (int j = 1; j <= n; ++j)
+        {
+            for (int i = 1; i <= n; ++i)
+            {
+                x[at(n, i, j)] -= mean;
+                sq += x[at(n, i, j)] * x[at(n, i, j)];
+            }
+        }
+        return sq;
+    }
+
+    bool singular(int b) const
+    {
+        return b == 0 && std::abs(levels[0].diag - 4.0 * levels[0].off) <= 1e-14 * std::abs(levels[0].diag);
+    }
+
+    static double meanInterior(int n, const double *x)
+    {
+        double s = 0.0;
+        for (int j = 1; j <= n; ++j)
+            for (int i = 1; i <= n; ++i)
+                s += x[at(n, i, j)];
+        return s / (static_cast<double>(n) * n);
+    }
+
+public:
+    explicit MultigridSolver(int n) : MultigridSolver(n, Options()) {}
+
+    MultigridSolver(int n, Options options)
+        : opts(options)
+    {
+        int size = n;
+        for (;;)
+        {
+            Level L;
+            L.n = size;
+            const size_t cells = static_cast<size_t>(size + 2) * (size + 2);
+            L.res.assign(cells, 0.0);
+            if (!levels.empty())
+            {
+                L.x.assign(cells, 0.0);
+                L.rhs.assign(cells, 0.0);
+            }
+            levels.push_back(std::move(L));
+            if (size % 2 != 0 || size <= opts.min_size)
+                break;
+            size /= 2;
+        }
+        Level &coarsest = levels.back();
+        coarsest.dir.assign(coarsest.res.size(), 0.0);
+        coarsest.image.assign(coarsest.res.size(), 0.0);
+    }
+
+    int size() const { return levels[0].n; }
+    int levelCount() const { return static_cast<int>(levels.size()); }
+    const Options &options() const { return opts; }
+    void setOptions(const Options &options) { opts = options; }
+
+    // Same boundary rule as FluidSolver::set_bnd
+    static void setBoundary(int b, double *x, int n)
+    {
+        for (int i = 1; i <= n; ++i)
+        {
+            x[at(n, 0, i)] = (b == 1) ? -x[at(n, 1, i)] : x[at(n, 1, i)];
+            x[at(n, n + 1, i)] = (b == 1) ? -x[at(n, n, i)] : x[at(n, n, i)];
+            x[at(n, i, 0)] = (b == 2) ? -x[at(n, i, 1)] : x[at(n, i, 1)];
+            x[at(n, i, n + 1)] = (b == 2) ? -x[at(n, i, n)] : x[at(n, i, n)];
+        }
+        x[at(n, 0, 0)] = 0.5 * (x[at(n, 1, 0)] + x[at(n, 0, 1)]);
+        x[at(n, 0, n + 1)] = 0.5 * (x[at(n, 1, n + 1)] + x[at(n, 0, n)]);
+        x[at(n, n + 1, 0)] = 0.5 * (x[at(n, n, 0)] + x[at(n, n + 1, 1)]);
+        x[at(n, n + 1, n + 1)] = 0.5 * (x[at(n, n, n + 1)] + x[at(n, n + 1, n)]);
+    }
+
+    // Solve in place; x holds the initial guess. Both arrays are (n+2)^2.
+    MultigridStats solve(int b, double *x, const double *rhs, double diag, double off)
+    {
+        const int n = levels[0].n;
+        for (size_t l = 0; l < levels.size(); ++l)
+        {
+            // Coarse grids see the Laplacian part scaled by (h / H)^2 = 1/4 per level
+            const double scale = std::ldexp(1.0, -2 * static_cast<int>(l));
+            levels[l].off = off * scale;
+            levels[l].diag = (diag - 4.0 * off) + 4.0 * off * scale;
+        }
+
+        MultigridStats stats;
+        stats.levels = levelCount();
+
+        // Pure Neumann Poisson (project) is singular: only the zero-mean part of
+        // rhs is solvable, so solve against that and leave the constant free
+        if (singular(b))
+        {
+            std::vector<double> &projected = levels[0].rhs;
+            projected.assign(rhs, rhs + levels[0].res.size());
+            const double mean = meanInterior(n, rhs);
+            for (int j = 1; j <= n; ++j)
+                for (int i = 1; i <= n; ++i)
+                    projected[at(n, i, j)] -= mean;
+            rhs = projected.data();
+        }
+
+        double rhs_sq = 0.0;
+        for (int j = 1; j <= n; ++j)
+            for (int i = 1; i <= n; ++i)
+                rhs_sq += rhs[at(n, i, j)] * rhs[at(n, i, j)];
+        const double denom = rhs_sq > 0.0 ? std::sqrt(rhs_sq) : 1.0;
+
+        setBoundary(b, x, n);
+        stats.initial_residual = stats.residual =
+            std::sqrt(residual(n, x, rhs, levels[0].res.data(), levels[0].diag, levels[0].off)) / denom;
+
+        while (stats.residual > opts.tolerance && stats.cycles < opts.max_cycles)
+        {
+            vcycle(0, b, x, rhs);
+            ++stats.cycles;
+            stats.residual = std::sqrt(residual(n, x, rhs, levels[0].res.data(), levels[0].diag, levels[0].off)) / denom;
+        }
+        stats.converged = stats.residual <= opts.tolerance;
+        return stats;
+    }
+};
+
+#endif // UQFF_MULTIGRID_H
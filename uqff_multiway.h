@@ -0,0 +1,504 @@
+#ifndef UQFF_MULTIWAY_H
+#define UQFF_MULTIWAY_H
+
+// Multiway evolution over append-only hypergraph rules
+// States form a tree of persistent edge lists: every state points at the Link
+// holding the edges its rule application appended, and that Link points at its
+// parent's. The root graph is shared by all states, so a branch costs only the
+// edges it adds.
+// Expansion goes level by level, EXPAND_BATCH frontier states at a time. A batch
+// is expanded in parallel into per-state candidate lists, which are merged in
+// frontier order. The result does not depend on the thread count as long as the
+// successor function is deterministic.
+// Duplicate states are merged up to renaming of fresh nodes (ids above the root
+// graph's). The canonical key sums per-edge hashes (independent of edge order) in
+// which a fresh node is replaced by a color refined from the edges around it,
+// never by its id, and mixes in max_node. Equal keys are confirmed by searching
+// for a color-preserving bijection of fresh nodes that maps one edge multiset
+// onto the other, so a hash collision never merges two different states. Colors
+// are refined until the classes stop splitting, and the search starts from the
+// smallest class and backtracks as soon as a fully mapped edge is missing.
+// A memory budget caps the estimated bytes held. Every kept state is charged as
+// it is merged; once the next one would overflow, the rest of the level is
+// pruned (its remaining frontier states are not expanded). Unmerged candidates
+// never exceed one batch.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "uqff_hypergraph.h"
+
+namespace uqff_multiway
+{
+    using Node = uqff_hypergraph::HypergraphStore::Node;
+    using Edge = std::vector<Node>;
+
+    inline uint64_t mix64(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Order-sensitive within an edge (hyperedges are ordered tuples)
+    inline uint64_t edgeHash(std::span<const Node> edge)
+    {
+        uint64_t h = mix64(edge.size());
+        for (Node n : edge)
+            h = mix64(h ^ static_cast<uint32_t>(n));
+        return h;
+    }
+
+    // Edges appended by one rule application, chained to the parent's Link
+    struct Link
+    {
+        std::shared_ptr<const Link> parent;
+        std::vector<Edge> edges;
+    };
+
+    struct State
+    {
+        static constexpr uint32_t ROOT = UINT32_MAX;
+
+        std::shared_ptr<const Link> tail; // null for the root state
+        uint64_t edge_hash = 0;           // root edge hashes plus the canonical hash of the appended edges
+        int max_node = 0;
+        uint32_t level = 0;
+        uint32_t parent = ROOT; // index into MultiwaySystem::states()
+
+        uint64_t key() const { return edge_hash + mix64(static_cast<uint64_t>(static_cast<uint32_t>(max_node)) ^ 0x5A17ull); }
+    };
+
+    // One way of applying the rule to a state: edges to append and the new max_node
+    struct Successor
+    {
+        std::vector<Edge> edges;
+        int max_node = 0;
+    };
+
+    // successors(state, out): append every successor of `state` to `out`
+    using SuccessorFunction = std::function<void(const State &, std::vector<Successor> &)>;
+
+    struct Options
+    {
+        size_t memory_budget = size_t(1) << 30; // estimated bytes of all states kept
+    };
+
+    struct LevelStats
+    {
+        size_t candidates = 0; // successors generated
+        size_t merged = 0;     // duplicates of a state already present
+        size_t pruned = 0;     // dropped to stay within the memory budget
+        size_t unexpanded = 0; // frontier states not expanded once the budget was reached
+        size_t states = 0;     // new states kept at this level
+        size_t bytes = 0;      // estimated total after this level
+        double seconds = 0.0;
+    };
+
+    class MultiwaySystem
+    {
+    public:
+        MultiwaySystem() = default;
+
+        MultiwaySystem(std::shared_ptr<const uqff_hypergraph::HypergraphStore> root_graph, int root_max_node)
+        {
+            reset(std::move(root_graph), root_max_node);
+        }
+
+        void reset(std::shared_ptr<const uqff_hypergraph::HypergraphStore> root_graph, int root_max_node)
+        {
+            root = std::move(root_graph);
+            fresh_above = std::max(root_max_node, root ? root->maxNode() : root_max_node);
+            root_hash = 0;
+            all.clear();
+            by_key.clear();
+            level_stats.clear();
+            frontier.clear();
+            is_truncated = false;
+            if (root)
+            {
+                for (uqff_hypergraph::HypergraphStore::EdgeId e = 0; e < root->edgeCount(); ++e)
+                    if (root->isLive(e))
+                        root_hash += edgeHash(root->edge(e));
+            }
+            State s;
+            s.max_node = root_max_node;
+            s.edge_hash = root_hash;
+            all.push_back(s);
+            by_key.emplace(s.key(), 0);
+            frontier.push_back(0);
+            total_bytes = stateBytes(nullptr);
+        }
+
+        const std::vector<State> &states() const { return all; }
+        const std::vector<LevelStats> &levels() const { return level_stats; }
+        const std::vector<uint32_t> &currentFrontier() const { return frontier; }
+        size_t bytes() const { return total_bytes; }
+        bool truncated() const { return is_truncated; } // a level was cut by the budget
+
+        // Expand `depth` more levels from the current frontier
+        void expand(int depth, const SuccessorFunction &successors, const Options &opts = {})
+        {
+            for (int d = 0; d < depth && !frontier.empty(); ++d)
+                expandLevel(successors, opts);
+        }
+
+        // Edges appended after the root, oldest first
+        std::vector<Edge> appendedEdges(uint32_t index) const
+        {
+            std::vector<const Link *> chain;
+            for (const Link *l = all[index].tail.get(); l; l = l->parent.get())
+                chain.push_back(l);
+            std::vector<Edge> edges;
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+                edges.insert(edges.end(), (*it)->edges.begin(), (*it)->edges.end());
+            return edges;
+        }
+
+        // Full edge list of a state (root edges, then appended edges)
+        std::vector<Edge> materialize(uint32_t index) const
+        {
+            std::vector<Edge> edges = root ? root->toVectors() : std::vector<Edge>{};
+            std::vector<Edge> tail = appendedEdges(index);
+            edges.insert(edges.end(), std::make_move_iterator(tail.begin()), std::make_move_iterator(tail.end()));
+            return edges;
+        }
+
+    private:
+        static constexpr size_t EXPAND_BATCH = 1024; // frontier states expanded per parallel pass
+
+        struct Candidate
+        {
+            State state;
+            uint64_t key;
+        };
+
+        // Appended edges of a state, its fresh nodes (sorted ids) and one color per
+        // fresh node. Colors come from the structure around a node, never its id.
+        struct FreshView
+        {
+            std::vector<const Edge *> edges;
+            std::vector<Node> fresh;
+            std::vector<uint64_t> color; // by index into `fresh`
+        };
+
+        std::shared_ptr<const uqff_hypergraph::HypergraphStore> root;
+        Node fresh_above = 0;   // nodes with larger ids were created by rule applications
+        uint64_t root_hash = 0; // sum of edgeHash over the root graph's live edges
+        std::vector<State> all;
+        std::unordered_multimap<uint64_t, uint32_t> by_key;
+        std::vector<uint32_t> frontier;
+        std::vector<LevelStats> level_stats;
+        size_t total_bytes = 0;
+        bool is_truncated = false;
+
+        // Footprint of one kept state: record (with vector slack), key index node and
+        // bucket, Link with its control block, edge buffers; each heap block is charged
+        // ALLOC_OVERHEAD for the allocator header and rounding
+        static size_t stateBytes(const Link *link)
+        {
+            constexpr size_t ALLOC_OVERHEAD = 16;
+            size_t bytes = sizeof(State) * 3 / 2 + 4 * sizeof(void *) + ALLOC_OVERHEAD + sizeof(void *);
+            if (link)
+            {
+                bytes += sizeof(Link) + 2 * sizeof(void *) + ALLOC_OVERHEAD;
+                bytes += link->edges.size() * sizeof(Edge) + ALLOC_OVERHEAD;
+                for (const Edge &e : link->edges)
+                    bytes += std::max(e.size() * sizeof(Node), 2 * sizeof(void *)) + ALLOC_OVERHEAD;
+            }
+            return bytes;
+        }
+
+        bool isFresh(Node n) const { return n > fresh_above; }
+
+        static size_t freshIndex(const FreshView &v, Node n)
+        {
+            return static_cast<size_t>(std::lower_bound(v.fresh.begin(), v.fresh.end(), n) - v.fresh.begin());
+        }
+
+        // edgeHash with fresh nodes replaced by their colors; position `self` (if any)
+        // is tagged so a node's own place in the edge is told apart from its neighbours'
+        uint64_t canonicalEdgeHash(const FreshView &v, const Edge &edge, size_t self = SIZE_MAX) const
+        {
+            uint64_t h = mix64(edge.size());
+            for (size_t i = 0; i < edge.size(); ++i)
+            {
+                const uint64_t x = isFresh(edge[i]) ? mix64(v.color[freshIndex(v, edge[i])] ^ (i == self ? 0x5E1Full : 0xF4E5ull))
+                                                    : static_cast<uint32_t>(edge[i]);
+                h = mix64(h ^ x);
+            }
+            return h;
+        }
+
+        FreshView freshView(const State &s) const
+        {
+            FreshView v;
+            for (const Link *l = s.tail.get(); l; l = l->parent.get())
+                for (const Edge &e : l->edges)
+                    v.edges.push_back(&e);
+            for (const Edge *e : v.edges)
+                for (Node n : *e)
+                    if (isFresh(n))
+                        v.fresh.push_back(n);
+            std::sort(v.fresh.begin(), v.fresh.end());
+            v.fresh.erase(std::unique(v.fresh.begin(), v.fresh.end()), v.fresh.end());
+
+            // Each round, a node's color absorbs the hashes of the edges it lies on; stop
+            // once a round splits no class (a chain needs about half its length)
+            v.color.assign(v.fresh.size(), mix64(0xC0102ull));
+            std::vector<uint64_t> around(v.fresh.size());
+            size_t classes = colorClasses(v.color);
+            for (size_t round = 0; round < v.fresh.size(); ++round)
+            {
+                std::fill(around.begin(), around.end(), 0);
+                for (const Edge *e : v.edges)
+                    for (size_t i = 0; i < e->size(); ++i)
+                        if (isFresh((*e)[i]))
+                            around[freshIndex(v, (*e)[i])] += canonicalEdgeHash(v, *e, i);
+                for (size_t k = 0; k < v.color.size(); ++k)
+                    v.color[k] = mix64(v.color[k] ^ around[k]);
+                const size_t refined = colorClasses(v.color);
+                if (refined == classes)
+                    break;
+                classes = refined;
+            }
+            return v;
+        }
+
+        static size_t colorClasses(std::vector<uint64_t> colors)
+        {
+            std::sort(colors.begin(), colors.end());
+            return static_cast<size_t>(std::unique(colors.begin(), colors.end()) - colors.begin());
+        }
+
+        uint64_t canonicalHash(const State &s) const
+        {
+            const FreshView v = freshView(s);
+            uint64_t h = root_hash;
+            for (const Edge *e : v.edges)
+                h += canonicalEdgeHash(v, *e);
+            return h;
+        }
+
+        // Bijection search for sameState(): a's fresh nodes are assigned in `order`, and
+        // closing[k] lists the edges of a whose fresh nodes are all mapped once order[k] is
+        struct FreshMatch
+        {
+            std::vector<size_t> order;
+            std::vector<std::vector<const Edge *>> closing;
+            std::vector<Node> image; // by index into a.fresh
+            std::vector<char> used;  // by index into b.fresh
+            std::vector<Edge> target; // b's edges, sorted
+        };
+
+        Edge renamed(const FreshView &a, const FreshMatch &m, const Edge &e) const
+        {
+            Edge r = e;
+            for (Node &n : r)
+                if (isFresh(n))
+                    n = m.image[freshIndex(a, n)];
+            return r;
+        }
+
+        // Try the color-preserving images of order[k] (and on); a partial assignment is
+        // dropped as soon as one of its closed edges is not among b's edges
+        bool mapFresh(const FreshView &a, const FreshView &b, FreshMatch &m, size_t k) const
+        {
+            if (k == m.order.size())
+            {
+                std::vector<Edge> all_renamed;
+                all_renamed.reserve(a.edges.size());
+                for (const Edge *e : a.edges)
+                    all_renamed.push_back(renamed(a, m, *e));
+                std::sort(all_renamed.begin(), all_renamed.end());
+                return all_renamed == m.target;
+            }
+            const size_t node = m.order[k];
+            for (size_t j = 0; j < b.fresh.size(); ++j)
+            {
+                if (m.used[j] || b.color[j] != a.color[node])
+                    continue;
+                m.image[node] = b.fresh[j];
+                const bool consistent = std::all_of(m.closing[k].begin(), m.closing[k].end(), [&](const Edge *e)
+                                                    { return std::binary_search(m.target.begin(), m.target.end(), renamed(a, m, *e)); });
+                if (!consistent)
+                    continue;
+                m.used[j] = 1;
+                if (mapFresh(a, b, m, k + 1))
+                    return true;
+                m.used[j] = 0;
+            }
+            return false;
+        }
+
+        // Same graph up to renaming fresh nodes: all states share the root, so look for a
+        // bijection of fresh nodes that maps the appended edge multisets onto each other
+        bool sameState(const State &a, const State &b) const
+        {
+            if (a.max_node != b.max_node || a.edge_hash != b.edge_hash)
+                return false;
+            const FreshView va = freshView(a), vb = freshView(b);
+            if (va.edges.size() != vb.edges.size() || va.fresh.size() != vb.fresh.size())
+                return false;
+            FreshMatch m;
+            m.target.reserve(vb.edges.size());
+            for (const Edge *e : vb.edges)
+                m.target.push_back(*e);
+            std::sort(m.target.begin(), m.target.end());
+
+            // Smallest color classes first, so forced choices come before free ones
+            const size_t n = va.fresh.size();
+            std::vector<uint64_t> sorted_colors = va.color;
+            std::sort(sorted_colors.begin(), sorted_colors.end());
+            auto classSize = [&](size_t i)
+            {
+                auto [lo, hi] = std::equal_range(sorted_colors.begin(), sorted_colors.end(), va.color[i]);
+                return hi - lo;
+            };
+            m.order.resize(n);
+            std::iota(m.order.begin(), m.order.end(), size_t(0));
+            std::sort(m.order.begin(), m.order.end(), [&](size_t x, size_t y)
+                      { return std::make_tuple(classSize(x), va.color[x], x) < std::make_tuple(classSize(y), va.color[y], y); });
+
+            std::vector<size_t> step(n);
+            for (size_t k = 0; k < n; ++k)
+                step[m.order[k]] = k;
+            m.closing.resize(n);
+            for (const Edge *e : va.edges)
+            {
+                size_t last = SIZE_MAX;
+                for (Node x : *e)
+                    if (isFresh(x))
+                        last = last == SIZE_MAX ? step[freshIndex(va, x)] : std::max(last, step[freshIndex(va, x)]);
+                if (last == SIZE_MAX)
+                {
+                    if (!std::binary_search(m.target.begin(), m.target.end(), *e))
+                        return false;
+                }
+                else
+                    m.closing[last].push_back(e);
+            }
+            m.image.resize(n);
+            m.used.assign(vb.fresh.size(), 0);
+            return mapFresh(va, vb, m, 0);
+        }
+
+        bool known(const Candidate &c) const
+        {
+            auto [lo, hi] = by_key.equal_range(c.key);
+            for (auto it = lo; it != hi; ++it)
+                if (sameState(all[it->second], c.state))
+                    return true;
+            return false;
+        }
+
+        void expandLevel(const SuccessorFunction &successors, const Options &opts)
+        {
+            auto start = std::chrono::steady_clock::now();
+            LevelStats stats;
+            const uint32_t level = all[frontier.front()].level + 1;
+            std::vector<uint32_t> next_frontier;
+            bool full = false;
+            size_t expanded = 0;
+
+            for (size_t first = 0; first < frontier.size() && !full; first += EXPAND_BATCH)
+            {
+                // Parallel: successors of a batch of frontier states, in per-state slots
+                const size_t batch = std::min(EXPAND_BATCH, frontier.size() - first);
+                std::vector<std::vector<Candidate>> slots(batch);
+                std::exception_ptr error;
+                const long count = static_cast<long>(batch);
+#pragma omp parallel for schedule(dynamic, 16)
+                for (long k = 0; k < count; ++k)
+                {
+                    try
+                    {
+                        const uint32_t parent = frontier[first + static_cast<size_t>(k)];
+                        const State &from = all[parent];
+                        std::vector<Successor> next;
+                        successors(from, next);
+                        slots[k].reserve(next.size());
+                        for (Successor &s : next)
+                        {
+                            State st;
+                            st.max_node = s.max_node;
+                            st.level = level;
+                            st.parent = parent;
+                            if (!s.edges.empty())
+                                st.tail = std::make_shared<const Link>(Link{from.tail, std::move(s.edges)});
+                            else
+                                st.tail = from.tail;
+                            st.edge_hash = canonicalHash(st);
+                            slots[k].push_back({std::move(st), 0});
+                            slots[k].back().key = slots[k].back().state.key();
+                        }
+                    }
+                    catch (...)
+                    {
+#pragma omp critical(uqff_multiway_error)
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+                if (error)
+                    std::rethrow_exception(error);
+                expanded += batch;
+
+                // Sequential merge in frontier order: drop states seen at any level, and
+                // charge each kept one to the budget
+                for (auto &slot : slots)
+                {
+                    for (Candidate &c : slot)
+                    {
+                        ++stats.candidates;
+                        if (full)
+                        {
+                            ++stats.pruned;
+                            continue;
+                        }
+                        if (known(c))
+                        {
+                            ++stats.merged;
+                            continue;
+                        }
+                        const size_t bytes = stateBytes(c.state.tail.get());
+                        if (total_bytes + bytes > opts.memory_budget)
+                        {
+                            full = true;
+                            ++stats.pruned;
+                            continue;
+                        }
+                        const uint32_t index = static_cast<uint32_t>(all.size());
+                        by_key.emplace(c.key, index);
+                        all.push_back(std::move(c.state));
+                        next_frontier.push_back(index);
+                        total_bytes += bytes;
+                    }
+                    slot.clear();
+                    slot.shrink_to_fit();
+                }
+            }
+
+            if (full)
+                is_truncated = true;
+            stats.unexpanded = frontier.size() - expanded;
+            frontier = std::move(next_frontier);
+            stats.states = frontier.size();
+            stats.bytes = total_bytes;
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            level_stats.push_back(stats);
+        }
+    };
+}
+
+#endif // UQFF_MULTIWAY_H
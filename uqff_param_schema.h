@@ -0,0 +1,182 @@
+#ifndef UQFF_PARAM_SCHEMA_H
+#define UQFF_PARAM_SCHEMA_H
+
+// Compiled parameter binding for PhysicsTerm evaluation
+// Terms declare their named inputs once (at registration) through ParamSchema::bind(),
+// which resolves every name to an integer slot. The hot path then reads a flat
+// ParamVector by slot index instead of doing std::map<std::string,double> lookups.
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstddef>
+#include <stdexcept>
+
+// ============================================================================
+// PARAM SLOT - One declared input of a PhysicsTerm
+// ============================================================================
+
+struct ParamSlot
+{
+    static constexpr size_t UNBOUND = static_cast<size_t>(-1);
+
+    std::string name;       // Parameter key (same key used by the std::map interface)
+    double fallback;        // Value used when the parameter is not supplied
+    size_t index = UNBOUND; // Resolved slot (set by ParamSchema::bind)
+
+    ParamSlot(const std::string &key, double default_value) : name(key), fallback(default_value) {}
+
+    // Compatibility path: resolve against a std::map parameter set
+    double from(const std::map<std::string, double> &params) const
+    {
+        auto it = params.find(name);
+        return (it != params.end()) ? it->second : fallback;
+    }
+
+    // Same, with a call-site default (e.g. tn falls back to the current t)
+    double from(const std::map<std::string, double> &params, double value_if_missing) const
+    {
+        auto it = params.find(name);
+        return (it != params.end()) ? it->second : value_if_missing;
+    }
+};
+
+// ============================================================================
+// PARAM SCHEMA - Name -> slot interning table shared by a registry
+// ============================================================================
+
+class ParamSchema
+{
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, size_t> index;
+
+public:
+    // Intern a parameter name and return its slot
+    size_t slot(const std::string &name)
+    {
+        auto it = index.find(name);
+        if (it != index.end())
+            return it->second;
+        size_t id = names.size();
+        names.push_back(name);
+        index.emplace(name, id);
+        return id;
+    }
+
+    // Look up an existing slot without interning (UNBOUND if unknown)
+    size_t find(const std::string &name) const
+    {
+        auto it = index.find(name);
+        return (it != index.end()) ? it->second : ParamSlot::UNBOUND;
+    }
+
+    // Resolve one or more declared inputs of a term
+    template <typename... Slots>
+    void bind(Slots &...slots)
+    {
+        ((slots.index = slot(slots.name)), ...);
+    }
+
+    const std::string &name(size_t id) const { return names.at(id); }
+    size_t size() const { return names.size(); }
+};
+
+// ============================================================================
+// PARAM VECTOR - Flat, contiguous parameter values indexed by slot
+// ============================================================================
+
+class ParamVector
+{
+private:
+    const ParamSchema *schema = nullptr;
+    std::vector<double> values;
+    std::vector<unsigned char> present; // 1 if the slot was explicitly set
+
+public:
+    ParamVector() = default;
+    explicit ParamVector(const ParamSchema &s) : schema(&s), values(s.size(), 0.0), present(s.size(), 0) {}
+
+    // Grow to cover slots interned after construction
+    void resize(const ParamSchema &s)
+    {
+        schema = &s;
+        values.resize(s.size(), 0.0);
+        present.resize(s.size(), 0);
+    }
+
+    void set(size_t slot, double value)
+    {
+        if (slot >= values.size())
+            throw std::out_of_range("ParamVector slot not in schema");
+        values[slot] = value;
+        present[slot] = 1;
+    }
+
+    void unset(size_t slot)
+    {
+        if (slot < present.size())
+            present[slot] = 0;
+    }
+
+    bool has(size_t slot) const { return slot < present.size() && present[slot]; }
+
+    // Hot path: one bounds check and one load, no hashing or string compares
+    double get(const ParamSlot &p) const
+    {
+        return has(p.index) ? values[p.index] : p.fallback;
+    }
+
+    double get(const ParamSlot &p, double value_if_missing) const
+    {
+        return has(p.index) ? values[p.index] : value_if_missing;
+    }
+
+    // Set by name; only slots already interned by some term are stored
+    bool set(const std::string &name, double value)
+    {
+        size_t id = schema ? schema->find(name) : ParamSlot::UNBOUND;
+        if (id == ParamSlot::UNBOUND)
+            return false;
+        set(id, value);
+        return true;
+    }
+
+    // Compatibility shim for terms that only implement the std::map interface
+    std::map<std::string, double> toMap() const
+    {
+        std::map<std::string, double> params;
+        if (!schema)
+            return params;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (present[i])
+                params[schema->name(i)] = values[i];
+        }
+        return params;
+    }
+
+    const double *data() const { return values.data(); }
+    size_t size() const { return values.size(); }
+};
+
+// ============================================================================
+// PARAM BLOCK - Parameters held fixed across a block of timesteps
+// ============================================================================
+
+struct ParamBlock
+{
+    const ParamVector &params;
+    size_t t_slot = ParamSlot::UNBOUND; // Slot mirroring t (rewritten per step on the scalar path)
+
+    double get(const ParamSlot &p) const { return params.get(p); }
+    bool has(const ParamSlot &p) const { return params.has(p.index); }
+};
+
+// Uniform accessor so a term body can be written once for both interfaces
+inline double readParam(const std::map<std::string, double> &params, const ParamSlot &p) { return p.from(params); }
+inline double readParam(const ParamVector &params, const ParamSlot &p) { return params.get(p); }
+inline double readParam(const ParamBlock &block, const ParamSlot &p) { return block.get(p); }
+
+#endif // UQFF_PARAM_SCHEMA_H
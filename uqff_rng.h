@@ -0,0 +1,273 @@
+#ifndef UQFF_RNG_H
+#define UQFF_RNG_H
+
+// Central random-number service
+// One global seed per run; every consumer draws from its own Philox stream
+// (uqff_montecarlo.h), identified by a domain name and an entity number:
+//   uqff_rng::stream("cosmic_egg.sphere", i)   one stream per sphere, reproducible
+//   uqff_rng::threadStream("wolfram.rules")    one stream per thread, no sharing
+// Streams are counter-based, so creating one is a few integer ops (no
+// random_device, no 5 KB mt19937 state) and jumping ahead is free.
+// The seed comes from setGlobalSeed(), else the UQFF_SEED environment variable,
+// else std::random_device once per process. Set it before creating streams.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <span>
+#include <string_view>
+#include "uqff_montecarlo.h"
+
+namespace uqff_rng
+{
+    using uqff_montecarlo::Philox;
+
+    // ========================================================================
+    // GLOBAL SEED
+    // ========================================================================
+
+    namespace detail
+    {
+        inline std::atomic<uint64_t> global_seed{0};
+        inline std::once_flag seed_once;
+
+        inline void initSeed(bool explicit_seed)
+        {
+            std::call_once(seed_once, [explicit_seed]
+                           {
+                if (explicit_seed)
+                    return;
+                if (const char *env = std::getenv("UQFF_SEED"))
+                {
+                    global_seed = std::strtoull(env, nullptr, 0);
+                    return;
+                }
+                std::random_device rd;
+                global_seed = (uint64_t(rd()) << 32) | rd(); });
+        }
+
+        inline uint64_t splitmix64(uint64_t x)
+        {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        }
+
+        constexpr uint64_t fnv1a(std::string_view s)
+        {
+            uint64_t h = 0xCBF29CE484222325ull;
+            for (char ch : s)
+                h = (h ^ static_cast<unsigned char>(ch)) * 0x100000001B3ull;
+            return h;
+        }
+    }
+
+    inline void setGlobalSeed(uint64_t seed)
+    {
+        detail::initSeed(true);
+        detail::global_seed = seed;
+    }
+
+    inline uint64_t globalSeed()
+    {
+        detail::initSeed(false);
+        return detail::global_seed;
+    }
+
+    // Stream id for (domain, entity); distinct domains never need coordinating
+    inline uint64_t streamId(std::string_view domain, uint64_t entity = 0)
+    {
+        return detail::splitmix64(detail::fnv1a(domain) ^ detail::splitmix64(entity));
+    }
+
+    // ========================================================================
+    // STREAM
+    // ========================================================================
+
+    // A UniformRandomBitGenerator, so it also drives <random> distributions.
+    // Draw order: 128-bit block `counter` of stream `id`, four 32-bit words per block.
+    class Stream
+    {
+    public:
+        using result_type = uint32_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT32_MAX; }
+
+        Stream() : Stream(0, 0) {}
+        Stream(uint64_t seed, uint64_t id) : philox(seed), id(id) {}
+
+        result_type operator()()
+        {
+            if (word == 4)
+            {
+                block = philox(id, counter++);
+                word = 0;
+            }
+            return block[word++];
+        }
+
+        uint64_t bits64()
+        {
+            const uint64_t hi = (*this)();
+            return hi << 32 | (*this)();
+        }
+
+        // (0, 1), 53 random bits
+        double uniform()
+        {
+            const uint32_t hi = (*this)();
+            return Philox::toUniform(hi, (*this)());
+        }
+
+        double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+
+        // Integer in [lo, hi]
+        int64_t uniformInt(int64_t lo, int64_t hi)
+        {
+            return std::uniform_int_distribution<int64_t>(lo, hi)(*this);
+        }
+
+        double normal()
+        {
+            const double u1 = uniform(), u2 = uniform();
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+        }
+
+        double normal(double mean, double sd) { return mean + sd * normal(); }
+
+        // Jump to block `index` (discarding any partly used block)
+        void seek(uint64_t index)
+        {
+            counter = index;
+            word = 4;
+        }
+        void discard(uint64_t blocks) { seek(counter + blocks); }
+        uint64_t position() const { return counter; }
+        uint64_t streamId() const { return id; }
+
+        // Bulk fills: one Philox block per pair of outputs, blocks generated LANES at a
+        // time in lane-major arrays (vectorizes), blocks split across OpenMP threads.
+        // The stream advances by ceil(n / 2) blocks; results do not depend on threads.
+        void fillUniform(std::span<double> out, double lo = 0.0, double hi = 1.0)
+        {
+            fill(out, [lo, hi](const uint32_t *w, double *pair)
+                 {
+                pair[0] = lo + (hi - lo) * Philox::toUniform(w[0], w[1]);
+                pair[1] = lo + (hi - lo) * Philox::toUniform(w[2], w[3]); });
+        }
+
+        void fillNormal(std::span<double> out, double mean = 0.0, double sd = 1.0)
+        {
+            fill(out, [mean, sd](const uint32_t *w, double *pair)
+                 {
+                const double radius = sd * std::sqrt(-2.0 * std::log(Philox::toUniform(w[0], w[1])));
+                const double angle = 6.283185307179586 * Philox::toUniform(w[2], w[3]);
+                pair[0] = mean + radius * std::cos(angle);
+                pair[1] = mean + radius * std::sin(angle); });
+        }
+
+    private:
+        static constexpr size_t LANES = 16;
+
+        Philox philox;
+        uint64_t id;
+        uint64_t counter = 0;
+        Philox::Block block{};
+        int word = 4;
+
+        // words[l * 4 + j] = word j of block (first + l), l < LANES
+        void generateLanes(uint64_t first, uint32_t *words) const
+        {
+            uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                c0[l] = static_cast<uint32_t>(first + l);
+                c1[l] = static_cast<uint32_t>((first + l) >> 32);
+                c2[l] = static_cast<uint32_t>(id);
+                c3[l] = static_cast<uint32_t>(id >> 32);
+            }
+            std::array<uint32_t, 2> key = philox.keyWords();
+            for (int round = 0; round < 10; ++round)
+            {
+                for (size_t l = 0; l < LANES; ++l)
+                {
+                    const uint64_t p0 = uint64_t(0xD2511F53u) * c0[l];
+                    const uint64_t p1 = uint64_t(0xCD9E8D57u) * c2[l];
+                    const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ key[0];
+                    const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ key[1];
+                    c1[l] = static_cast<uint32_t>(p1);
+                    c3[l] = static_cast<uint32_t>(p0);
+                    c0[l] = n0;
+                    c2[l] = n2;
+                }
+                key[0] += 0x9E3779B9u;
+                key[1] += 0xBB67AE85u;
+            }
+            for (size_t l = 0; l < LANES; ++l)
+            {
+                words[l * 4 + 0] = c0[l];
+                words[l * 4 + 1] = c1[l];
+                words[l * 4 + 2] = c2[l];
+                words[l * 4 + 3] = c3[l];
+            }
+        }
+
+        template <typename Transform>
+        void fill(std::span<double> out, Transform transform)
+        {
+            const uint64_t first = counter;
+            const size_t pairs = (out.size() + 1) / 2;
+            const long groups = static_cast<long>((pairs + LANES - 1) / LANES);
+#pragma omp parallel for schedule(static)
+            for (long g = 0; g < groups; ++g)
+            {
+                uint32_t words[LANES * 4];
+                double values[LANES * 2];
+                const size_t pair0 = static_cast<size_t>(g) * LANES;
+                generateLanes(first + pair0, words);
+                for (size_t l = 0; l < LANES; ++l)
+                    transform(words + l * 4, values + l * 2);
+                const size_t begin = pair0 * 2, end = std::min(out.size(), begin + LANES * 2);
+                for (size_t i = begin; i < end; ++i)
+                    out[i] = values[i - begin];
+            }
+            seek(first + pairs);
+        }
+    };
+
+    // ========================================================================
+    // STREAM FACTORIES
+    // ========================================================================
+
+    // Stream for one entity of a domain; the same (seed, domain, entity) always
+    // replays the same sequence
+    inline Stream stream(std::string_view domain, uint64_t entity = 0)
+    {
+        return Stream(globalSeed(), streamId(domain, entity));
+    }
+
+    // 0, 1, 2, ... in order of each thread's first call
+    inline uint64_t threadOrdinal()
+    {
+        static std::atomic<uint64_t> next{0};
+        thread_local const uint64_t ordinal = next++;
+        return ordinal;
+    }
+
+    // Stream private to the calling thread (entity = thread ordinal). For work whose
+    // result must not depend on scheduling, use stream(domain, entity) instead.
+    // Typical use: `thread_local uqff_rng::Stream rng = uqff_rng::threadStream("name");`
+    inline Stream threadStream(std::string_view domain)
+    {
+        return stream(domain, uint64_t(1) << 63 | threadOrdinal());
+    }
+}
+
+#endif // UQFF_RNG_H
@@ -0,0 +1,546 @@
+#ifndef UQFF_RULES_H
+#define UQFF_RULES_H
+
+// Declarative hypergraph rewriting rules, applied a generation at a time
+//   auto rule = uqff_rules::compile("{{x,y},{x,z}} -> {{x,z},{x,w},{y,w},{z,w}}");
+//   uqff_rules::rewriteGeneration(store, rule, max_node);
+// Identifiers are pattern variables and integers are fixed node ids. A variable
+// that appears only on the right-hand side is a fresh node per application.
+// Matched edges are consumed. Distinct variables may bind the same node.
+// compile() orders the left-hand side so that each edge after the first is looked
+// up through the incidence list of a node bound before it. An edge sharing no bound
+// node falls back to a scan of all edges.
+// One generation:
+//   1. match   every live edge seeds a search (in parallel); the first match found
+//              is kept. Incidence lists are walked from just after the seed edge,
+//              so seeds around a hub pick different partners instead of all
+//              competing for the hub's first edge.
+//   2. select  matches are taken in seed order. A seed whose match reuses an edge
+//              already taken is searched again with the taken edges excluded, so
+//              no match is left among the free edges: a maximal (not maximum)
+//              non-overlapping set.
+//   3. build   right-hand sides of the selected matches, in parallel, one buffer.
+//   4. apply   remove the matched edges, then append the new ones in match order.
+// The result depends only on the graph, never on the thread count.
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "uqff_hypergraph.h"
+
+namespace uqff_rules
+{
+    using HypergraphStore = uqff_hypergraph::HypergraphStore;
+    using Node = HypergraphStore::Node;
+    using EdgeId = HypergraphStore::EdgeId;
+
+    // ========================================================================
+    // COMPILED FORM
+    // ========================================================================
+
+    // One pattern position: variable `var`, or the fixed node `node` when var < 0
+    struct Term
+    {
+        int var = -1;
+        Node node = 0;
+    };
+    using Pattern = std::vector<Term>;
+
+    // Left-hand edge lhs[pattern], found through the incidence list of the node at
+    // position `anchor` (fixed or bound by an earlier step); anchor < 0 scans all edges
+    struct Step
+    {
+        size_t pattern = 0;
+        int anchor = -1;
+    };
+
+    struct CompiledRule
+    {
+        std::string text;
+        std::vector<std::string> variables; // left-hand variables first, then fresh ones
+        size_t lhs_variables = 0;
+        std::vector<Pattern> lhs, rhs;
+        std::vector<Step> steps; // match order over lhs
+        size_t rhs_positions = 0;
+
+        size_t freshNodes() const { return variables.size() - lhs_variables; }
+
+        // Largest fixed node id on either side (-1 when the rule has none)
+        Node maxFixedNode() const
+        {
+            Node largest = -1;
+            for (const auto *side : {&lhs, &rhs})
+                for (const Pattern &p : *side)
+                    for (const Term &t : p)
+                        if (t.var < 0)
+                            largest = std::max(largest, t.node);
+            return largest;
+        }
+    };
+
+    // ========================================================================
+    // PARSER
+    // ========================================================================
+
+    namespace detail
+    {
+        using EdgeTokens = std::vector<std::vector<std::string>>;
+
+        class Parser
+        {
+        public:
+            explicit Parser(std::string_view text) : s(text) {}
+
+            void parse(EdgeTokens &lhs, EdgeTokens &rhs)
+            {
+                lhs = edgeSet();
+                skipSpace();
+                if (s.substr(pos, 2) != "->")
+                    fail("expected '->'");
+                pos += 2;
+                rhs = edgeSet();
+                skipSpace();
+                if (pos != s.size())
+                    fail("unexpected trailing text");
+            }
+
+        private:
+            std::string_view s;
+            size_t pos = 0;
+
+            [[noreturn]] void fail(const char *what) const
+            {
+                throw std::invalid_argument("uqff_rules: " + std::string(what) + " at position " +
+                                            std::to_string(pos) + " in \"" + std::string(s) + "\"");
+            }
+
+            void skipSpace()
+            {
+                while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos])))
+                    ++pos;
+            }
+
+            bool accept(char c)
+            {
+                skipSpace();
+                if (pos < s.size() && s[pos] == c)
+                {
+                    ++pos;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char c)
+            {
+                if (!accept(c))
+                    fail(c == '{' ? "expected '{'" : c == '}' ? "expected '}'"
+                                                              : "expected ','");
+            }
+
+            // identifier or non-negative integer
+            std::string term()
+            {
+                skipSpace();
+                const size_t start = pos;
+                if (pos < s.size() && std::isdigit(static_cast<unsigned char>(s[pos])))
+                {
+                    while (pos < s.size() && std::isdigit(static_cast<unsigned char>(s[pos])))
+                        ++pos;
+                }
+                else if (pos < s.size() && (std::isalpha(static_cast<unsigned char>(s[pos])) || s[pos] == '_'))
+                {
+                    while (pos < s.size() && (std::isalnum(static_cast<unsigned char>(s[pos])) || s[pos] == '_'))
+                        ++pos;
+                }
+                else
+                    fail("expected a variable or node id");
+                return std::string(s.substr(start, pos - start));
+            }
+
+            // '{' [item {',' item}] '}'
+            template <typename Item>
+            void list(Item item)
+            {
+                expect('{');
+                if (accept('}'))
+                    return;
+                do
+                    item();
+                while (accept(','));
+                expect('}');
+            }
+
+            EdgeTokens edgeSet()
+            {
+                EdgeTokens edges;
+                list([&]
+                     {
+                    edges.emplace_back();
+                    list([&] { edges.back().push_back(term()); }); });
+                return edges;
+            }
+        };
+
+        inline int variableIndex(std::vector<std::string> &variables, const std::string &name)
+        {
+            auto it = std::find(variables.begin(), variables.end(), name);
+            if (it == variables.end())
+            {
+                variables.push_back(name);
+                return static_cast<int>(variables.size() - 1);
+            }
+            return static_cast<int>(it - variables.begin());
+        }
+
+        inline Pattern toPattern(const std::vector<std::string> &tokens, std::vector<std::string> &variables)
+        {
+            Pattern p;
+            for (const std::string &t : tokens)
+            {
+                if (std::isdigit(static_cast<unsigned char>(t[0])))
+                {
+                    const unsigned long long id = std::stoull(t);
+                    if (id > static_cast<unsigned long long>(std::numeric_limits<Node>::max()))
+                        throw std::invalid_argument("uqff_rules: node id " + t + " out of range");
+                    p.push_back({-1, static_cast<Node>(id)});
+                }
+                else
+                    p.push_back({variableIndex(variables, t), 0});
+            }
+            return p;
+        }
+    }
+
+    // "{{x,y},{x,z}} -> {{x,z},{x,w},{y,w},{z,w}}"; throws std::invalid_argument
+    inline CompiledRule compile(std::string_view text)
+    {
+        detail::EdgeTokens lhs_tokens, rhs_tokens;
+        detail::Parser(text).parse(lhs_tokens, rhs_tokens);
+        if (lhs_tokens.empty())
+            throw std::invalid_argument("uqff_rules: empty left-hand side");
+
+        CompiledRule rule;
+        rule.text = std::string(text);
+        for (const auto &e : lhs_tokens)
+        {
+            if (e.empty())
+                throw std::invalid_argument("uqff_rules: empty edge on the left-hand side");
+            rule.lhs.push_back(detail::toPattern(e, rule.variables));
+        }
+        rule.lhs_variables = rule.variables.size();
+        for (const auto &e : rhs_tokens)
+        {
+            rule.rhs.push_back(detail::toPattern(e, rule.variables));
+            rule.rhs_positions += e.size();
+        }
+
+        // Match order: always continue with an edge that has a fixed or bound node
+        std::vector<char> placed(rule.lhs.size(), 0), bound(rule.lhs_variables, 0);
+        auto anchorOf = [&](const Pattern &p)
+        {
+            for (size_t i = 0; i < p.size(); ++i)
+                if (p[i].var < 0 || bound[p[i].var])
+                    return static_cast<int>(i);
+            return -1;
+        };
+        for (size_t k = 0; k < rule.lhs.size(); ++k)
+        {
+            Step next{rule.lhs.size(), -1};
+            for (size_t p = 0; p < rule.lhs.size(); ++p)
+            {
+                if (placed[p])
+                    continue;
+                const int anchor = anchorOf(rule.lhs[p]);
+                if (next.pattern == rule.lhs.size() || (next.anchor < 0 && anchor >= 0))
+                    next = {p, anchor};
+            }
+            placed[next.pattern] = 1;
+            for (const Term &t : rule.lhs[next.pattern])
+                if (t.var >= 0)
+                    bound[t.var] = 1;
+            rule.steps.push_back(next);
+        }
+        return rule;
+    }
+
+    // ========================================================================
+    // MATCHING
+    // ========================================================================
+
+    // Flat match list: match m uses edges[m * lhs.size() + p] for lhs[p] and binds
+    // variable v to bindings[m * lhs_variables + v]
+    struct Matches
+    {
+        size_t edges_per_match = 0;
+        size_t bindings_per_match = 0;
+        std::vector<EdgeId> edges;
+        std::vector<Node> bindings;
+
+        size_t size() const { return edges_per_match ? edges.size() / edges_per_match : 0; }
+
+        void append(const Matches &other)
+        {
+            edges.insert(edges.end(), other.edges.begin(), other.edges.end());
+            bindings.insert(bindings.end(), other.bindings.begin(), other.bindings.end());
+        }
+    };
+
+    namespace detail
+    {
+        // Backtracking search for one match containing a given seed edge. Edges marked
+        // in `excluded` (indexed by edge id) are never used.
+        class Searcher
+        {
+        public:
+            Searcher(const HypergraphStore &store, const CompiledRule &rule, const std::vector<uint8_t> *excluded = nullptr)
+                : store(store), rule(rule), excluded(excluded), binding(rule.lhs_variables, UNBOUND), matched(rule.lhs.size())
+            {
+            }
+
+            bool search(EdgeId seed)
+            {
+                std::fill(binding.begin(), binding.end(), UNBOUND);
+                trail.clear();
+                return tryEdge(0, seed, seed);
+            }
+
+            void emit(Matches &out) const
+            {
+                out.edges.insert(out.edges.end(), matched.begin(), matched.end());
+                out.bindings.insert(out.bindings.end(), binding.begin(), binding.end());
+            }
+
+        private:
+            static constexpr Node UNBOUND = -1;
+
+            const HypergraphStore &store;
+            const CompiledRule &rule;
+            const std::vector<uint8_t> *excluded;
+            std::vector<Node> binding;
+            std::vector<EdgeId> matched; // by lhs pattern
+            std::vector<int> trail;      // variables bound so far, for undo
+
+            void undo(size_t mark)
+            {
+                while (trail.size() > mark)
+                {
+                    binding[trail.back()] = UNBOUND;
+                    trail.pop_back();
+                }
+            }
+
+            bool tryEdge(size_t k, EdgeId e, EdgeId seed)
+            {
+                const Pattern &p = rule.lhs[rule.steps[k].pattern];
+                if (excluded && (*excluded)[e])
+                    return false;
+                const auto nodes = store.edge(e);
+                if (nodes.size() != p.size())
+                    return false;
+                for (size_t j = 0; j < k; ++j)
+                    if (matched[rule.steps[j].pattern] == e)
+                        return false;
+                const size_t mark = trail.size();
+                for (size_t i = 0; i < p.size(); ++i)
+                {
+                    const Term &t = p[i];
+                    const Node want = t.var < 0 ? t.node : binding[t.var];
+                    if (want == UNBOUND)
+                    {
+                        binding[t.var] = nodes[i];
+                        trail.push_back(t.var);
+                    }
+                    else if (want != nodes[i])
+                    {
+                        undo(mark);
+                        return false;
+                    }
+                }
+                matched[rule.steps[k].pattern] = e;
+                if (extend(k + 1, seed))
+                    return true;
+                undo(mark);
+                return false;
+            }
+
+            bool extend(size_t k, EdgeId seed)
+            {
+                if (k == rule.steps.size())
+                    return true;
+                const Step &step = rule.steps[k];
+                if (step.anchor >= 0)
+                {
+                    const Term &t = rule.lhs[step.pattern][step.anchor];
+                    const auto list = store.incidentEdges(t.var < 0 ? t.node : binding[t.var]);
+                    const size_t start = static_cast<size_t>(std::upper_bound(list.begin(), list.end(), seed) - list.begin());
+                    for (size_t i = 0; i < list.size(); ++i)
+                    {
+                        const size_t at = start + i < list.size() ? start + i : start + i - list.size();
+                        if (tryEdge(k, list[at], seed))
+                            return true;
+                    }
+                    return false;
+                }
+                const size_t count = store.edgeCount();
+                for (size_t i = 1; i <= count; ++i)
+                {
+                    const EdgeId e = static_cast<EdgeId>((seed + i) % count);
+                    if (store.isLive(e) && tryEdge(k, e, seed))
+                        return true;
+                }
+                return false;
+            }
+        };
+    }
+
+    // First match seeded by each live edge, in seed order (possibly overlapping).
+    // The store must be compacted (incidence lists are read as sorted CSR ranges).
+    inline Matches findMatches(const HypergraphStore &store, const CompiledRule &rule)
+    {
+        if (!store.isCompacted())
+            throw std::logic_error("uqff_rules::findMatches: store is not compacted");
+        Matches found;
+        found.edges_per_match = rule.lhs.size();
+        found.bindings_per_match = rule.lhs_variables;
+
+        // Seeds: edges through the first step's fixed node, else every edge id
+        const Step &first = rule.steps.front();
+        const std::span<const EdgeId> anchored = first.anchor >= 0 ? store.incidentEdges(rule.lhs[first.pattern][first.anchor].node)
+                                                                   : std::span<const EdgeId>{};
+        const size_t seeds = first.anchor >= 0 ? anchored.size() : store.edgeCount();
+
+        constexpr size_t CHUNK = 4096;
+        const long chunks = static_cast<long>((seeds + CHUNK - 1) / CHUNK);
+        std::vector<Matches> parts(static_cast<size_t>(chunks));
+#pragma omp parallel for schedule(dynamic)
+        for (long c = 0; c < chunks; ++c)
+        {
+            detail::Searcher searcher(store, rule);
+            const size_t end = std::min(seeds, static_cast<size_t>(c + 1) * CHUNK);
+            for (size_t i = static_cast<size_t>(c) * CHUNK; i < end; ++i)
+            {
+                const EdgeId seed = first.anchor >= 0 ? anchored[i] : static_cast<EdgeId>(i);
+                if (store.isLive(seed) && searcher.search(seed))
+                    searcher.emit(parts[c]);
+            }
+        }
+        for (const Matches &part : parts)
+            found.append(part);
+        return found;
+    }
+
+    // ========================================================================
+    // GENERATION UPDATE
+    // ========================================================================
+
+    struct RewriteStats
+    {
+        size_t matches = 0; // candidate matches (one per seed at most)
+        size_t applied = 0; // non-overlapping matches rewritten
+        size_t removed = 0; // edges consumed
+        size_t added = 0;   // edges created
+        double seconds = 0.0;
+    };
+
+    // Rewrite a maximal set of non-overlapping matches at once; fresh nodes are
+    // numbered above max_node, every node in the store and every fixed id in the
+    // rule, and max_node is advanced past them
+    inline RewriteStats rewriteGeneration(HypergraphStore &store, const CompiledRule &rule, int &max_node)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        RewriteStats stats;
+        store.compact();
+        const Matches found = findMatches(store, rule);
+        stats.matches = found.size();
+
+        // A seed whose first match collides is searched again around the taken edges;
+        // taking only adds edges, so a seed with no free match now never gets one later
+        const size_t per_match = rule.lhs.size();
+        const size_t seed_position = rule.steps.front().pattern;
+        Matches chosen;
+        chosen.edges_per_match = per_match;
+        chosen.bindings_per_match = rule.lhs_variables;
+        std::vector<uint8_t> taken(store.edgeCount(), 0);
+        detail::Searcher retry(store, rule, &taken);
+        auto take = [&](const EdgeId *edges)
+        {
+            for (size_t p = 0; p < per_match; ++p)
+                taken[edges[p]] = 1;
+        };
+        for (size_t m = 0; m < found.size(); ++m)
+        {
+            const EdgeId *edges = found.edges.data() + m * per_match;
+            if (std::none_of(edges, edges + per_match, [&](EdgeId e)
+                             { return taken[e] != 0; }))
+            {
+                take(edges);
+                chosen.edges.insert(chosen.edges.end(), edges, edges + per_match);
+                const Node *binding = found.bindings.data() + m * rule.lhs_variables;
+                chosen.bindings.insert(chosen.bindings.end(), binding, binding + rule.lhs_variables);
+            }
+            else if (retry.search(edges[seed_position]))
+            {
+                const size_t at = chosen.edges.size();
+                retry.emit(chosen);
+                take(chosen.edges.data() + at);
+            }
+        }
+
+        const size_t fresh = rule.freshNodes();
+        const Node base = std::max({max_node, store.maxNode(), rule.maxFixedNode()});
+        const size_t applied_count = chosen.size();
+        if (fresh > 0 && applied_count > static_cast<size_t>(std::numeric_limits<Node>::max() - base) / fresh)
+            throw std::length_error("uqff_rules: fresh node ids overflow");
+        const long applied = static_cast<long>(applied_count);
+        std::vector<Node> rhs_nodes(applied_count * rule.rhs_positions);
+#pragma omp parallel for schedule(static)
+        for (long m = 0; m < applied; ++m)
+        {
+            const Node *binding = chosen.bindings.data() + static_cast<size_t>(m) * rule.lhs_variables;
+            const Node first_fresh = base + 1 + static_cast<Node>(static_cast<size_t>(m) * fresh);
+            Node *out = rhs_nodes.data() + static_cast<size_t>(m) * rule.rhs_positions;
+            for (const Pattern &p : rule.rhs)
+            {
+                for (const Term &t : p)
+                {
+                    if (t.var < 0)
+                        *out++ = t.node;
+                    else if (static_cast<size_t>(t.var) < rule.lhs_variables)
+                        *out++ = binding[t.var];
+                    else
+                        *out++ = first_fresh + static_cast<Node>(static_cast<size_t>(t.var) - rule.lhs_variables);
+                }
+            }
+        }
+
+        for (EdgeId e : chosen.edges)
+            store.removeEdge(e);
+        const Node *in = rhs_nodes.data();
+        for (size_t m = 0; m < applied_count; ++m)
+        {
+            for (const Pattern &p : rule.rhs)
+            {
+                store.addEdge(std::span<const Node>(in, p.size()));
+                in += p.size();
+            }
+        }
+
+        max_node = std::max(base + static_cast<Node>(applied_count * fresh), store.maxNode());
+        stats.applied = applied_count;
+        stats.removed = applied_count * per_match;
+        stats.added = applied_count * rule.rhs.size();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+}
+
+#endif // UQFF_RULES_H
@@ -0,0 +1,325 @@
+#ifndef UQFF_SIMD_H
+#define UQFF_SIMD_H
+
+// SIMD helpers for PhysicsTerm::computeBatch kernels (and the FluidSolver advection row kernel)
+// Compile-time dispatch: AVX-512F (8 lanes), AVX2 (4 lanes), otherwise scalar.
+// A kernel is written once as a generic lambda over `auto t`; forEachLane()
+// instantiates it for uqff_simd::Vec on full vectors and for double on the tail.
+// exp/sin/cos are Cephes-style polynomial approximations (~1-2 ulp); lanes outside
+// the reduced range (huge |x|, NaN, overflow/underflow) are patched with std:: calls.
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace uqff_simd
+{
+    // Scalar overloads (tail of every batch, and the whole batch on scalar builds)
+    inline double exp(double x) { return std::exp(x); }
+    inline double sin(double x) { return std::sin(x); }
+    inline double cos(double x) { return std::cos(x); }
+
+#if defined(__AVX512F__)
+
+    // ========================================================================
+    // AVX-512F: 8 x double
+    // ========================================================================
+
+    struct Vec
+    {
+        static constexpr size_t lanes = 8;
+        __m512d v;
+
+        Vec() = default;
+        Vec(__m512d x) : v(x) {}
+        Vec(double x) : v(_mm512_set1_pd(x)) {}
+
+        static Vec load(const double *p) { return _mm512_loadu_pd(p); }
+        void store(double *p) const { _mm512_storeu_pd(p, v); }
+    };
+
+    using Mask = __mmask8;
+
+    inline Vec operator+(Vec a, Vec b) { return _mm512_add_pd(a.v, b.v); }
+    inline Vec operator-(Vec a, Vec b) { return _mm512_sub_pd(a.v, b.v); }
+    inline Vec operator*(Vec a, Vec b) { return _mm512_mul_pd(a.v, b.v); }
+    inline Vec operator/(Vec a, Vec b) { return _mm512_div_pd(a.v, b.v); }
+    inline Vec operator-(Vec a) { return _mm512_sub_pd(_mm512_setzero_pd(), a.v); }
+
+    inline Vec vfloor(Vec a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    inline Vec vabs(Vec a) { return _mm512_abs_pd(a.v); }
+    inline Vec vmin(Vec a, Vec b) { return _mm512_min_pd(a.v, b.v); }
+    inline Vec vmax(Vec a, Vec b) { return _mm512_max_pd(a.v, b.v); }
+
+    inline Mask eq(Vec a, Vec b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ); }
+    inline Mask ge(Vec a, Vec b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ); }
+    inline Mask lt(Vec a, Vec b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+    inline Mask outside(Vec a, double lo, double hi) // true for NaN as well
+    {
+        return _mm512_cmp_pd_mask(a.v, _mm512_set1_pd(lo), _CMP_NGE_UQ) |
+               _mm512_cmp_pd_mask(a.v, _mm512_set1_pd(hi), _CMP_NLE_UQ);
+    }
+    inline Mask mask_or(Mask a, Mask b) { return a | b; }
+    inline Mask mask_xor(Mask a, Mask b) { return a ^ b; }
+    inline unsigned bits(Mask m) { return m; }
+
+    // m ? a : b
+    inline Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_pd(m, b.v, a.v); }
+
+    // 2^n for integral n in [-1022, 1023]
+    inline Vec pow2i(Vec n)
+    {
+        __m512d biased = _mm512_add_pd(n.v, _mm512_set1_pd(1023.0 + 4503599627370496.0));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_castpd_si512(biased), 52));
+    }
+
+    // start, start + 1, ..., start + 7
+    inline Vec ramp(double start) { return _mm512_add_pd(_mm512_set1_pd(start), _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7)); }
+
+    // Truncating conversion of every lane to int32 (idx holds 8 ints, 32-byte aligned)
+    inline void truncToInt(Vec a, int *idx) { _mm256_store_si256(reinterpret_cast<__m256i *>(idx), _mm512_cvttpd_epi32(a.v)); }
+
+    // first[l] = base[idx[l]], second[l] = base[idx[l] + 1]. Each lane's pair is one
+    // 16-byte load; the pairs are then transposed into lane order instead of gathered.
+    inline void loadPairs(const double *base, const int *idx, Vec &first, Vec &second)
+    {
+        auto pair2 = [&](int a, int b)
+        { return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(base + idx[a])), _mm_loadu_pd(base + idx[b]), 1); };
+        __m512d even = _mm512_insertf64x4(_mm512_castpd256_pd512(pair2(0, 2)), pair2(4, 6), 1);
+        __m512d odd = _mm512_insertf64x4(_mm512_castpd256_pd512(pair2(1, 3)), pair2(5, 7), 1);
+        first = _mm512_unpacklo_pd(even, odd);
+        second = _mm512_unpackhi_pd(even, odd);
+    }
+
+#define UQFF_SIMD_LANES 8
+
+#elif defined(__AVX2__)
+
+    // ========================================================================
+    // AVX2: 4 x double
+    // ========================================================================
+
+    struct Vec
+    {
+        static constexpr size_t lanes = 4;
+        __m256d v;
+
+        Vec() = default;
+        Vec(__m256d x) : v(x) {}
+        Vec(double x) : v(_mm256_set1_pd(x)) {}
+
+        static Vec load(const double *p) { return _mm256_loadu_pd(p); }
+        void store(double *p) const { _mm256_storeu_pd(p, v); }
+    };
+
+    using Mask = __m256d;
+
+    inline Vec operator+(Vec a, Vec b) { return _mm256_add_pd(a.v, b.v); }
+    inline Vec operator-(Vec a, Vec b) { return _mm256_sub_pd(a.v, b.v); }
+    inline Vec operator*(Vec a, Vec b) { return _mm256_mul_pd(a.v, b.v); }
+    inline Vec operator/(Vec a, Vec b) { return _mm256_div_pd(a.v, b.v); }
+    inline Vec operator-(Vec a) { return _mm256_sub_pd(_mm256_setzero_pd(), a.v); }
+
+    inline Vec vfloor(Vec a) { return _mm256_floor_pd(a.v); }
+    inline Vec vabs(Vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+    inline Vec vmin(Vec a, Vec b) { return _mm256_min_pd(a.v, b.v); }
+    inline Vec vmax(Vec a, Vec b) { return _mm256_max_pd(a.v, b.v); }
+
+    inline Mask eq(Vec a, Vec b) { return _mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ); }
+    inline Mask ge(Vec a, Vec b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+    inline Mask lt(Vec a, Vec b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    inline Mask outside(Vec a, double lo, double hi) // true for NaN as well
+    {
+        return _mm256_or_pd(_mm256_cmp_pd(a.v, _mm256_set1_pd(lo), _CMP_NGE_UQ),
+                            _mm256_cmp_pd(a.v, _mm256_set1_pd(hi), _CMP_NLE_UQ));
+    }
+    inline Mask mask_or(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+    inline Mask mask_xor(Mask a, Mask b) { return _mm256_xor_pd(a, b); }
+    inline unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+
+    // m ? a : b
+    inline Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_pd(b.v, a.v, m); }
+
+    // 2^n for integral n in [-1022, 1023]
+    inline Vec pow2i(Vec n)
+    {
+        __m256d biased = _mm256_add_pd(n.v, _mm256_set1_pd(1023.0 + 4503599627370496.0));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+    }
+
+    // start, start + 1, start + 2, start + 3
+    inline Vec ramp(double start) { return _mm256_add_pd(_mm256_set1_pd(start), _mm256_setr_pd(0, 1, 2, 3)); }
+
+    // Truncating conversion of every lane to int32 (idx holds 4 ints, 16-byte aligned)
+    inline void truncToInt(Vec a, int *idx) { _mm_store_si128(reinterpret_cast<__m128i *>(idx), _mm256_cvttpd_epi32(a.v)); }
+
+    // first[l] = base[idx[l]], second[l] = base[idx[l] + 1]. Each lane's pair is one
+    // 16-byte load; the pairs are then transposed into lane order instead of gathered.
+    inline void loadPairs(const double *base, const int *idx, Vec &first, Vec &second)
+    {
+        auto pair2 = [&](int a, int b)
+        { return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(base + idx[a])), _mm_loadu_pd(base + idx[b]), 1); };
+        __m256d even = pair2(0, 2); // a0 b0 | a2 b2
+        __m256d odd = pair2(1, 3);  // a1 b1 | a3 b3
+        first = _mm256_unpacklo_pd(even, odd);
+        second = _mm256_unpackhi_pd(even, odd);
+    }
+
+#define UQFF_SIMD_LANES 4
+
+#else
+
+#define UQFF_SIMD_LANES 1
+
+#endif
+
+#if UQFF_SIMD_LANES > 1
+
+    // ========================================================================
+    // VECTOR MATH (shared by both ISAs, written against the primitives above)
+    // ========================================================================
+
+    // Recompute flagged lanes with the scalar library function
+    template <typename F>
+    inline Vec patch(Vec x, Vec r, Mask m, F f)
+    {
+        unsigned lanes_to_fix = bits(m);
+        if (lanes_to_fix == 0)
+            return r;
+        alignas(64) double xs[Vec::lanes];
+        alignas(64) double rs[Vec::lanes];
+        x.store(xs);
+        r.store(rs);
+        for (size_t i = 0; i < Vec::lanes; ++i)
+        {
+            if (lanes_to_fix & (1u << i))
+                rs[i] = f(xs[i]);
+        }
+        return Vec::load(rs);
+    }
+
+    inline Vec exp(Vec x)
+    {
+        // exp(x) = 2^n * exp(g), |g| <= ln2/2, Pade approximant (Cephes exp.c)
+        const Mask slow = outside(x, -708.0, 709.0);
+        Vec xc = vmin(vmax(x, Vec(-708.0)), Vec(709.0));
+
+        Vec n = vfloor(1.4426950408889634073599 * xc + 0.5);
+        xc = xc - n * 6.93145751953125e-1;
+        xc = xc - n * 1.42860682030941723212e-6;
+
+        Vec xx = xc * xc;
+        Vec p = xc * ((1.26177193074810590878e-4 * xx + 3.02994407707441961300e-2) * xx + 9.99999999999999999910e-1);
+        Vec q = ((3.00198505138664455042e-6 * xx + 2.52448340349684104192e-3) * xx + 2.27265548208155028766e-1) * xx +
+                2.00000000000000000009e0;
+        Vec r = (1.0 + 2.0 * (p / (q - p))) * pow2i(n);
+
+        return patch(x, r, slow, [](double v) { return std::exp(v); });
+    }
+
+    // Shared octant reduction for sin/cos (Cephes sin.c); valid for |x| < 2^29
+    inline void reduceOctant(Vec ax, Vec &z, Vec &j)
+    {
+        Vec y = vfloor(ax * 1.27323954473516268615); // 4/pi
+        Vec odd = y - 2.0 * vfloor(y * 0.5);
+        y = y + odd;
+        j = y - 8.0 * vfloor(y * 0.125);
+        z = ((ax - y * 7.85398125648498535156e-1) - y * 3.77489470793079817668e-8) - y * 2.69515142907905952645e-15;
+    }
+
+    inline Vec sinPoly(Vec z, Vec zz)
+    {
+        return z + z * zz * (((((1.58962301576546568060e-10 * zz - 2.50507477628578072866e-8) * zz + 2.75573136213857245213e-6) * zz - 1.98412698295895385996e-4) * zz + 8.33333333332211858878e-3) * zz - 1.66666666666666307295e-1);
+    }
+
+    inline Vec cosPoly(Vec zz)
+    {
+        return 1.0 - 0.5 * zz + zz * zz * (((((-1.13585365213876817300e-11 * zz + 2.08757008419747316778e-9) * zz - 2.75573141792967388112e-7) * zz + 2.48015872888517045348e-5) * zz - 1.38888888888730564116e-3) * zz + 4.16666666666665929218e-2);
+    }
+
+    constexpr double kTrigLimit = 536870912.0; // 2^29: beyond this the 3-part reduction loses accuracy
+
+    inline Vec sin(Vec x)
+    {
+        Vec ax = vabs(x), z, j;
+        reduceOctant(ax, z, j);
+        Vec zz = z * z;
+        Mask use_cos = mask_or(eq(j, Vec(2.0)), eq(j, Vec(6.0)));
+        Mask negate = mask_xor(ge(j, Vec(4.0)), lt(x, Vec(0.0)));
+        Vec r = select(use_cos, cosPoly(zz), sinPoly(z, zz));
+        r = select(negate, -r, r);
+        return patch(x, r, outside(x, -kTrigLimit, kTrigLimit), [](double v) { return std::sin(v); });
+    }
+
+    inline Vec cos(Vec x)
+    {
+        Vec ax = vabs(x), z, j;
+        reduceOctant(ax, z, j);
+        Vec zz = z * z;
+        Mask use_sin = mask_or(eq(j, Vec(2.0)), eq(j, Vec(6.0)));
+        Mask negate = mask_or(eq(j, Vec(2.0)), eq(j, Vec(4.0)));
+        Vec r = select(use_sin, sinPoly(z, zz), cosPoly(zz));
+        r = select(negate, -r, r);
+        return patch(x, r, outside(x, -kTrigLimit, kTrigLimit), [](double v) { return std::cos(v); });
+    }
+
+#endif
+
+    // ========================================================================
+    // BATCH DRIVER
+    // ========================================================================
+
+    // Multi-column kernels: kernel(i, x) handles rows [i, i + lanes) where x is a Vec
+    // (full vectors) or a double (tail, one row), and reads/writes its columns with
+    // loadAs(x, column + i) / storeTo(column + i, value)
+    inline double loadAs(double, const double *p) { return *p; }
+    inline void storeTo(double *p, double x) { *p = x; }
+    inline double nanWhereZero(double test, double x) { return test == 0.0 ? std::numeric_limits<double>::quiet_NaN() : x; }
+#if UQFF_SIMD_LANES > 1
+    inline Vec loadAs(Vec, const double *p) { return Vec::load(p); }
+    inline void storeTo(double *p, Vec x) { x.store(p); }
+    inline Vec nanWhereZero(Vec test, Vec x) { return select(eq(test, Vec(0.0)), Vec(std::numeric_limits<double>::quiet_NaN()), x); }
+#endif
+
+    template <typename Kernel>
+    inline void forEachBlock(size_t begin, size_t end, Kernel &&kernel)
+    {
+        size_t i = begin;
+#if UQFF_SIMD_LANES > 1
+        for (; i + Vec::lanes <= end; i += Vec::lanes)
+        {
+            kernel(i, Vec(0.0));
+        }
+#endif
+        for (; i < end; ++i)
+        {
+            kernel(i, 0.0);
+        }
+    }
+
+    // out[i] = kernel(t[i]); kernel is a generic lambda valid for Vec and double
+    template <typename Kernel>
+    inline void forEachLane(std::span<const double> t, std::span<double> out, Kernel &&kernel)
+    {
+        size_t i = 0;
+#if UQFF_SIMD_LANES > 1
+        for (; i + Vec::lanes <= t.size(); i += Vec::lanes)
+        {
+            Vec r = kernel(Vec::load(t.data() + i));
+            r.store(out.data() + i);
+        }
+#endif
+        for (; i < t.size(); ++i)
+        {
+            out[i] = kernel(t[i]);
+        }
+    }
+
+} // namespace uqff_simd
+
+#endif // UQFF_SIMD_H
@@ -0,0 +1,191 @@
+#ifndef UQFF_THREAD_POOL_H
+#define UQFF_THREAD_POOL_H
+
+// Fixed-size thread pool for fork-join loops (term graph levels, sweeps)
+// Every call is a fork-join: the calling thread participates as participant 0,
+// helpers are 1..N, and the call returns once all work has run.
+//   parallelFor()    - small loops; indices handed out from a shared counter
+//   parallelRanges() - large loops; grain-sized chunks claimed in index order,
+//                      so work in flight stays close to the lowest open index
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Current fork-join job (one at a time); run once by every participant
+    std::function<void(size_t)> job;
+    size_t finished_workers = 0;
+    unsigned long long generation = 0;
+    std::exception_ptr failure;
+    bool stopping = false;
+
+    void runJob(size_t participant)
+    {
+        try
+        {
+            job(participant);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!failure)
+                failure = std::current_exception();
+        }
+    }
+
+    void workerLoop(size_t participant)
+    {
+        unsigned long long seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                wake.wait(lock, [&]
+                          { return stopping || generation != seen; });
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+            runJob(participant);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (++finished_workers == workers.size())
+                    done.notify_all();
+            }
+        }
+    }
+
+public:
+    // threads = number of helper threads (0 runs everything on the caller)
+    explicit ThreadPool(size_t threads = defaultThreads())
+    {
+        workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers.emplace_back([this, i]
+                                 { workerLoop(i + 1); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &w : workers)
+        {
+            w.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    static size_t defaultThreads()
+    {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    // Total threads that take part in a job (helpers + caller)
+    size_t concurrency() const { return workers.size() + 1; }
+
+    // Run fn(participant) once on every participant; rethrows the first exception
+    void runOnAll(const std::function<void(size_t)> &fn)
+    {
+        if (workers.empty())
+        {
+            fn(0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            job = fn;
+            finished_workers = 0;
+            failure = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+
+        runJob(0);
+
+        std::exception_ptr err;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            // Every helper must check in, so none can still be reading this job
+            done.wait(lock, [&]
+                      { return finished_workers == workers.size(); });
+            job = nullptr;
+            err = failure;
+        }
+        if (err)
+            std::rethrow_exception(err);
+    }
+
+    // Run fn(i) for every i in [0, n)
+    void parallelFor(size_t n, const std::function<void(size_t)> &fn)
+    {
+        if (n == 0)
+            return;
+        if (workers.empty() || n == 1)
+        {
+            for (size_t i = 0; i < n; ++i)
+                fn(i);
+            return;
+        }
+
+        std::atomic<size_t> next_index{0};
+        runOnAll([&](size_t)
+                 {
+                     for (size_t i = next_index.fetch_add(1); i < n; i = next_index.fetch_add(1))
+                         fn(i);
+                 });
+    }
+
+    // Run fn(participant, begin, end) over [0, n) in chunks of at most `grain`.
+    // Chunks are claimed from a shared counter in index order: each participant's
+    // indices are increasing, and every chunk in flight started within one chunk per
+    // participant of the oldest unfinished one. Consumers that must emit results in
+    // order (sweep rows) therefore only ever wait on a handful of chunks, and a
+    // participant that finishes early simply claims the next one.
+    void parallelRanges(size_t n, size_t grain, const std::function<void(size_t, size_t, size_t)> &fn)
+    {
+        if (n == 0)
+            return;
+        if (grain == 0)
+            grain = 1;
+        if (workers.empty() || n <= grain)
+        {
+            for (size_t begin = 0; begin < n; begin += grain)
+                fn(0, begin, std::min(n, begin + grain));
+            return;
+        }
+
+        std::atomic<size_t> next_chunk{0};
+        const size_t chunks = (n + grain - 1) / grain;
+        runOnAll([&](size_t self)
+                 {
+                     for (size_t k = next_chunk.fetch_add(1); k < chunks; k = next_chunk.fetch_add(1))
+                         fn(self, k * grain, std::min(n, (k + 1) * grain));
+                 });
+    }
+};
+
+#endif // UQFF_THREAD_POOL_H
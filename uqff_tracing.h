@@ -13,6 +13,18 @@
  *
  * Integrates with VerboseLogger for unified logging/tracing output
  *
+ * Hot path: spans, events and metrics are copied as fixed-size 64-byte binary records
+ * into a per-thread lock-free ring buffer (single producer, single consumer). A
+ * background writer thread drains all rings, orders records by timestamp and does
+ * all text formatting and file I/O. A full ring drops records (counted and reported)
+ * rather than blocking the traced thread.
+ *
+ * Spans nest: each records its parent span (the innermost open span on the creating
+ * thread, or an explicit parent for work handed to another thread) and the tracing
+ * thread. initialize() can also write a Chrome Trace Event Format JSON file
+ * (chrome://tracing, ui.perfetto.dev) with one complete event per span, SpanType as
+ * the category and one track per thread.
+ *
  * Author: Daniel T. Murphy
  * Date: December 1, 2025 (Last Updated: December 4, 2025)
  * Status: ACTIVE - Used by MAIN_1_CoAnQi.exe (runtime verified Dec 4 @ 17:40:40)
@@ -27,12 +39,26 @@
 #include <sstream>
 #include <string>
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <set>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
 
 #ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include <windows.h>
 #endif
 
@@ -63,61 +89,153 @@ enum class SpanType
 };
 
 /**
- * TraceSpan - Represents a single traced operation
- * Automatically measures duration and logs on destruction (RAII pattern)
+ * TraceRecord - One fixed-size binary trace record (one cache line)
+ * Text longer than `text` continues in the following `continuation` records,
+ * each of which is used entirely as raw text bytes.
  */
-class TraceSpan
+struct alignas(64) TraceRecord
+{
+    enum Kind : uint8_t
+    {
+        SPAN_START,
+        SPAN_END,
+        EVENT,
+        METRIC,
+        ATTR_TEXT,
+        ATTR_DOUBLE,
+        ATTR_INT
+    };
+
+    static constexpr size_t TEXT_BYTES = 32;
+    static constexpr char SEPARATOR = '\x1f'; // Between name and unit / attribute key and value
+
+    uint64_t timestamp_ns; // steady_clock, relative to the tracer epoch
+    uint64_t span_id;
+    union
+    {
+        double value;      // METRIC, ATTR_DOUBLE
+        int64_t int_value; // ATTR_INT, SPAN_START parent id, SPAN_END duration (ns)
+    };
+    uint32_t thread_index;
+    uint8_t kind;
+    uint8_t code;         // TraceLevel or SpanType
+    uint8_t continuation; // Number of text-only records that follow
+    uint8_t reserved;
+    uint32_t text_len;    // Total text length across this record and its continuations
+    char text[TEXT_BYTES - sizeof(uint32_t)];
+};
+static_assert(sizeof(TraceRecord) == 64, "TraceRecord must be one cache line");
+
+/**
+ * TraceRing - Single-producer / single-consumer ring of TraceRecords
+ * The owning thread pushes; only the tracer's writer thread pops.
+ */
+class TraceRing
 {
+public:
+    static constexpr size_t CAPACITY = 8192; // Records (512 KiB); power of two
+    static constexpr size_t MAX_RECORDS_PER_ENTRY = 64;
+
+    const uint32_t thread_index;
+    atomic<bool> retired{false}; // Owning thread has exited
+    atomic<uint64_t> dropped{0};
+    atomic<bool> nudged{false}; // Producer asked the writer for an early drain
+
 private:
-    string spanName;
-    SpanType spanType;
-    chrono::high_resolution_clock::time_point startTime;
-    map<string, string> attributes;
-    bool completed;
-    ofstream *traceFile;
+    unique_ptr<TraceRecord[]> slots;
+    alignas(64) atomic<uint64_t> head{0}; // Written by the producer
+    uint64_t cached_tail = 0;             // Producer's last view of tail
+    alignas(64) atomic<uint64_t> tail{0}; // Written by the consumer
+
+public:
+    explicit TraceRing(uint32_t index) : thread_index(index), slots(new TraceRecord[CAPACITY]) {}
 
-    string spanTypeToString(SpanType type) const
+    // Producer: claim n consecutive records, or nullptr (and count a drop) if the ring is full
+    TraceRecord *reserve(size_t n, uint64_t &start)
     {
-        switch (type)
+        start = head.load(memory_order_relaxed);
+        if (start + n - cached_tail > CAPACITY)
         {
-        case SpanType::SYSTEM_CALCULATION:
-            return "SYSTEM_CALC";
-        case SpanType::PHYSICS_TERM_EVAL:
-            return "PHYSICS_TERM";
-        case SpanType::MODULE_INIT:
-            return "MODULE_INIT";
-        case SpanType::WOLFRAM_CALL:
-            return "WOLFRAM_CALL";
-        case SpanType::OPTIMIZATION:
-            return "OPTIMIZATION";
-        case SpanType::VALIDATION:
-            return "VALIDATION";
-        case SpanType::CROSS_MODULE_COMM:
-            return "CROSS_MODULE";
-        case SpanType::SIMULATION_STEP:
-            return "SIMULATION";
-        case SpanType::STATISTICAL_ANALYSIS:
-            return "STATISTICS";
-        default:
-            return "UNKNOWN";
+            cached_tail = tail.load(memory_order_acquire);
+            if (start + n - cached_tail > CAPACITY)
+            {
+                dropped.fetch_add(1, memory_order_relaxed);
+                return nullptr;
+            }
         }
+        return &slots[start & (CAPACITY - 1)];
     }
 
-public:
-    TraceSpan(const string &name, SpanType type, ofstream *file = nullptr)
-        : spanName(name), spanType(type), completed(false), traceFile(file)
+    TraceRecord &at(uint64_t position) { return slots[position & (CAPACITY - 1)]; }
+
+    void publish(uint64_t start, size_t n) { head.store(start + n, memory_order_release); }
+
+    // Producer: true once per drain when the ring passes half full
+    bool needsDrain(uint64_t end) const
     {
-        startTime = chrono::high_resolution_clock::now();
+        return end - cached_tail > CAPACITY / 2;
+    }
 
-        if (traceFile && traceFile->is_open())
+    // Consumer: copy out everything published so far
+    void drain(vector<TraceRecord> &out)
+    {
+        uint64_t t = tail.load(memory_order_relaxed);
+        uint64_t h = head.load(memory_order_acquire);
+        for (; t != h; ++t)
         {
-            auto now = chrono::system_clock::now();
-            auto now_c = chrono::system_clock::to_time_t(now);
-            *traceFile << "[SPAN_START] " << put_time(localtime(&now_c), "%Y-%m-%d %H:%M:%S")
-                       << " | " << spanTypeToString(spanType) << " | " << spanName << endl;
+            out.push_back(slots[t & (CAPACITY - 1)]);
         }
+        tail.store(h, memory_order_release);
+        nudged.store(false, memory_order_relaxed);
+    }
+
+    bool empty() const { return head.load(memory_order_acquire) == tail.load(memory_order_acquire); }
+};
+
+class UQFFTracer;
+
+/**
+ * TraceSpan - Represents a single traced operation
+ * Automatically measures duration and records its end on destruction (RAII pattern)
+ */
+class TraceSpan
+{
+private:
+    struct Attribute
+    {
+        string key;
+        string text;
+        double value = 0.0;
+        int64_t int_value = 0;
+        TraceRecord::Kind kind;
+    };
+
+    UQFFTracer *tracer;
+    string spanName;
+    SpanType spanType;
+    uint64_t spanId;
+    uint64_t parentId;
+    uint64_t enclosingId; // This thread's current span before this one opened
+    chrono::steady_clock::time_point startTime;
+    vector<Attribute> attributes;
+    bool completed;
+
+    // Innermost open span on this thread (0 = none)
+    static uint64_t &threadCurrent()
+    {
+        thread_local uint64_t current = 0;
+        return current;
     }
 
+public:
+    static constexpr uint64_t INHERIT_PARENT = ~uint64_t(0);
+
+    // parent = INHERIT_PARENT nests under this thread's innermost open span; pass
+    // currentId() captured on another thread to parent work handed off to a pool
+    TraceSpan(const string &name, SpanType type, UQFFTracer *owner, uint64_t parent = INHERIT_PARENT);
+
+    static uint64_t currentId() { return threadCurrent(); }
+
     ~TraceSpan()
     {
         if (!completed)
@@ -126,270 +244,716 @@ public:
         }
     }
 
-    // Add attributes to the span
+    // Add attributes to the span (kept raw; formatted by the writer thread)
     void setAttribute(const string &key, const string &value)
     {
-        attributes[key] = value;
+        attributes.push_back({key, value, 0.0, 0, TraceRecord::ATTR_TEXT});
     }
 
     void setAttribute(const string &key, double value)
     {
-        ostringstream oss;
-        oss << scientific << setprecision(6) << value;
-        attributes[key] = oss.str();
+        attributes.push_back({key, string(), value, 0, TraceRecord::ATTR_DOUBLE});
     }
 
     void setAttribute(const string &key, int value)
     {
-        attributes[key] = to_string(value);
+        attributes.push_back({key, string(), 0.0, value, TraceRecord::ATTR_INT});
     }
 
     // Mark span as complete
-    void end()
-    {
-        if (completed)
-            return;
-
-        auto endTime = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::microseconds>(endTime - startTime);
-
-        if (traceFile && traceFile->is_open())
-        {
-            auto now = chrono::system_clock::now();
-            auto now_c = chrono::system_clock::to_time_t(now);
+    void end();
 
-            *traceFile << "[SPAN_END] " << put_time(localtime(&now_c), "%Y-%m-%d %H:%M:%S")
-                       << " | " << spanTypeToString(spanType) << " | " << spanName
-                       << " | Duration: " << duration.count() << " µs";
-
-            if (!attributes.empty())
-            {
-                *traceFile << " | Attributes: {";
-                bool first = true;
-                for (const auto &attr : attributes)
-                {
-                    if (!first)
-                        *traceFile << ", ";
-                    *traceFile << attr.first << "=" << attr.second;
-                    first = false;
-                }
-                *traceFile << "}";
-            }
-
-            *traceFile << endl;
-        }
-
-        completed = true;
-    }
+    uint64_t getId() const { return spanId; }
+    uint64_t getParentId() const { return parentId; }
 
     // Get duration in microseconds
     long long getDurationMicroseconds() const
     {
-        auto now = chrono::high_resolution_clock::now();
+        auto now = chrono::steady_clock::now();
         return chrono::duration_cast<chrono::microseconds>(now - startTime).count();
     }
 };
 
 /**
  * UQFFTracer - Main tracing orchestrator
- * Thread-safe singleton pattern for global access
+ * Thread-safe singleton pattern for global access. Producers never take a lock
+ * after their first record; the writer thread owns the trace file.
  */
 class UQFFTracer
 {
 private:
     ofstream traceFile;
-    bool enabled;
-    TraceLevel minLevel;
+    atomic<bool> enabled;
+    atomic<int> minLevel;
+
+    // Rings of every thread that has traced; guarded by ringsMutex (registration and writer only)
+    mutex ringsMutex;
+    vector<shared_ptr<TraceRing>> rings;
+    uint32_t nextThreadIndex = 0;
+
+    // Background writer
+    mutex controlMutex; // Serializes initialize()/shutdown()
+    mutex wakeMutex;
+    condition_variable wake;
+    bool stopWriter = false;
+    bool drainRequested = false; // A ring passed half full; drain without waiting out the interval
+    thread writer;
+    static constexpr chrono::milliseconds DRAIN_INTERVAL{20};
+
+    // Clock anchors: record timestamps are steady_clock ns since `epoch`
+    chrono::steady_clock::time_point epoch;
+    chrono::system_clock::time_point wallEpoch;
+
+    // Writer-side state
+    map<uint64_t, map<string, string>> pendingAttributes; // By span id, until SPAN_END
+    map<uint64_t, uint64_t> openSpanParents;              // By span id, SPAN_START -> SPAN_END
+
+    // Optional Chrome Trace Event Format output
+    ofstream chromeFile;
+    bool chromeFirstEvent = true;
+    set<uint32_t> chromeThreads; // Threads that already have a name metadata event
+    time_t cachedSecond = 0;
+    string cachedTimestamp;
+
+    UQFFTracer() : enabled(false), minLevel(static_cast<int>(TraceLevel::TRACE_INFO)),
+                   epoch(chrono::steady_clock::now()), wallEpoch(chrono::system_clock::now())
+    {
+    }
 
-#ifdef _WIN32
-    CRITICAL_SECTION cs;
-#endif
+    ~UQFFTracer()
+    {
+        shutdown();
+    }
 
-    UQFFTracer() : enabled(false), minLevel(TraceLevel::TRACE_INFO)
+    struct RingHandle
     {
-#ifdef _WIN32
-        InitializeCriticalSection(&cs);
-#endif
+        shared_ptr<TraceRing> ring;
+        ~RingHandle()
+        {
+            if (ring)
+                ring->retired.store(true, memory_order_release);
+        }
+    };
+
+    TraceRing &localRing()
+    {
+        thread_local RingHandle handle;
+        if (!handle.ring)
+        {
+            lock_guard<mutex> lock(ringsMutex);
+            handle.ring = make_shared<TraceRing>(nextThreadIndex++);
+            rings.push_back(handle.ring);
+        }
+        return *handle.ring;
     }
 
-    ~UQFFTracer()
+    static const char *levelName(uint8_t level)
     {
-        if (traceFile.is_open())
+        switch (static_cast<TraceLevel>(level))
         {
-            traceFile.close();
+        case TraceLevel::TRACE_DEBUG:
+            return "DEBUG";
+        case TraceLevel::TRACE_INFO:
+            return "INFO";
+        case TraceLevel::TRACE_WARN:
+            return "WARN";
+        case TraceLevel::TRACE_ERROR:
+            return "ERROR";
+        case TraceLevel::TRACE_FATAL:
+            return "FATAL";
         }
-#ifdef _WIN32
-        DeleteCriticalSection(&cs);
-#endif
+        return "UNKNOWN";
     }
 
-    void lock()
+    // Wall-clock "%Y-%m-%d %H:%M:%S" for a record timestamp (reformatted once per second)
+    const string &formatTime(uint64_t timestamp_ns)
     {
+        auto wall = wallEpoch + chrono::duration_cast<chrono::system_clock::duration>(chrono::nanoseconds(timestamp_ns));
+        time_t secs = chrono::system_clock::to_time_t(wall);
+        if (secs != cachedSecond || cachedTimestamp.empty())
+        {
+            tm parts{};
 #ifdef _WIN32
-        EnterCriticalSection(&cs);
+            localtime_s(&parts, &secs);
 #else
-        // Placeholder for non-Windows
+            localtime_r(&secs, &parts);
 #endif
+            ostringstream oss;
+            oss << put_time(&parts, "%Y-%m-%d %H:%M:%S");
+            cachedSecond = secs;
+            cachedTimestamp = oss.str();
+        }
+        return cachedTimestamp;
     }
 
-    void unlock()
+    // Reassemble the text of the entry starting at records[i]
+    static string entryText(const vector<TraceRecord> &records, size_t i)
     {
-#ifdef _WIN32
-        LeaveCriticalSection(&cs);
-#else
-        // Placeholder for non-Windows
-#endif
+        const TraceRecord &r = records[i];
+        string text;
+        text.reserve(r.text_len);
+        size_t first = min<size_t>(r.text_len, sizeof(r.text));
+        text.append(r.text, first);
+        for (size_t c = 1; c <= r.continuation && text.size() < r.text_len; ++c)
+        {
+            const char *raw = reinterpret_cast<const char *>(&records[i + c]);
+            text.append(raw, min<size_t>(r.text_len - text.size(), sizeof(TraceRecord)));
+        }
+        return text;
     }
 
-public:
-    // Singleton instance
-    static UQFFTracer &getInstance()
+    static pair<string, string> splitText(const string &text)
     {
-        static UQFFTracer instance;
-        return instance;
+        size_t sep = text.find(TraceRecord::SEPARATOR);
+        if (sep == string::npos)
+            return {text, string()};
+        return {text.substr(0, sep), text.substr(sep + 1)};
     }
 
-    // Initialize tracing
-    void initialize(const string &filename = "uqff_trace.log", TraceLevel level = TraceLevel::TRACE_INFO)
+    void formatEntry(const vector<TraceRecord> &records, size_t i)
     {
-        lock();
+        const TraceRecord &r = records[i];
+        const string text = entryText(records, i);
 
-        if (traceFile.is_open())
+        switch (r.kind)
         {
-            traceFile.close();
+        case TraceRecord::SPAN_START:
+            openSpanParents[r.span_id] = static_cast<uint64_t>(r.int_value);
+            traceFile << "[SPAN_START] " << formatTime(r.timestamp_ns)
+                      << " | " << spanTypeName(r.code) << " | " << text
+                      << " | span=" << r.span_id << " parent=" << r.int_value << " thread=" << r.thread_index << '\n';
+            break;
+
+        case TraceRecord::ATTR_TEXT:
+        case TraceRecord::ATTR_DOUBLE:
+        case TraceRecord::ATTR_INT:
+        {
+            auto kv = splitText(text);
+            if (r.kind == TraceRecord::ATTR_DOUBLE)
+            {
+                ostringstream oss;
+                oss << scientific << setprecision(6) << r.value;
+                kv.second = oss.str();
+            }
+            else if (r.kind == TraceRecord::ATTR_INT)
+            {
+                kv.second = to_string(r.int_value);
+            }
+            pendingAttributes[r.span_id][kv.first] = kv.second;
+            break;
         }
 
-        traceFile.open(filename, ios::out | ios::app);
-        if (traceFile.is_open())
+        case TraceRecord::SPAN_END:
         {
-            enabled = true;
-            minLevel = level;
+            uint64_t parent = 0;
+            auto open = openSpanParents.find(r.span_id);
+            if (open != openSpanParents.end())
+            {
+                parent = open->second;
+                openSpanParents.erase(open);
+            }
 
-            auto now = chrono::system_clock::now();
-            auto now_c = chrono::system_clock::to_time_t(now);
+            traceFile << "[SPAN_END] " << formatTime(r.timestamp_ns)
+                      << " | " << spanTypeName(r.code) << " | " << text
+                      << " | Duration: " << r.int_value / 1000 << " µs"
+                      << " | span=" << r.span_id << " parent=" << parent << " thread=" << r.thread_index;
+
+            map<string, string> attrs;
+            auto it = pendingAttributes.find(r.span_id);
+            if (it != pendingAttributes.end())
+            {
+                attrs = std::move(it->second);
+                pendingAttributes.erase(it);
+
+                traceFile << " | Attributes: {";
+                bool first = true;
+                for (const auto &attr : attrs)
+                {
+                    if (!first)
+                        traceFile << ", ";
+                    traceFile << attr.first << "=" << attr.second;
+                    first = false;
+                }
+                traceFile << "}";
+            }
+            traceFile << '\n';
 
-            traceFile << "\n\n========================================" << endl;
-            traceFile << "UQFF TRACING SESSION STARTED" << endl;
-            traceFile << "Time: " << put_time(localtime(&now_c), "%Y-%m-%d %H:%M:%S") << endl;
-            traceFile << "========================================\n"
-                      << endl;
+            if (chromeFile.is_open())
+            {
+                // Complete event: ts is the span start, both in microseconds
+                ostream &out = chromeEvent(r.thread_index);
+                out << "{\"name\":\"" << jsonEscape(text) << "\",\"cat\":\"" << spanTypeName(r.code)
+                    << "\",\"ph\":\"X\",\"ts\":" << microseconds(r.timestamp_ns - static_cast<uint64_t>(r.int_value))
+                    << ",\"dur\":" << microseconds(static_cast<uint64_t>(r.int_value))
+                    << ",\"pid\":1,\"tid\":" << r.thread_index
+                    << ",\"args\":{\"span_id\":" << r.span_id << ",\"parent_id\":" << parent;
+                for (const auto &attr : attrs)
+                {
+                    out << ",\"" << jsonEscape(attr.first) << "\":\"" << jsonEscape(attr.second) << "\"";
+                }
+                out << "}}";
+            }
+            break;
         }
 
-        unlock();
+        case TraceRecord::EVENT:
+            traceFile << "[" << levelName(r.code) << "] " << formatTime(r.timestamp_ns) << " | " << text << '\n';
+            if (chromeFile.is_open())
+            {
+                chromeEvent(r.thread_index) << "{\"name\":\"" << jsonEscape(text) << "\",\"cat\":\"" << levelName(r.code)
+                                            << "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << microseconds(r.timestamp_ns)
+                                            << ",\"pid\":1,\"tid\":" << r.thread_index << "}";
+            }
+            break;
+
+        case TraceRecord::METRIC:
+        {
+            auto nameUnit = splitText(text);
+            traceFile << "[METRIC] " << formatTime(r.timestamp_ns) << " | " << nameUnit.first << " = "
+                      << scientific << setprecision(6) << r.value;
+            if (!nameUnit.second.empty())
+            {
+                traceFile << " " << nameUnit.second;
+            }
+            traceFile << '\n';
+            if (chromeFile.is_open() && isfinite(r.value))
+            {
+                chromeEvent(r.thread_index) << "{\"name\":\"" << jsonEscape(nameUnit.first)
+                                            << "\",\"ph\":\"C\",\"ts\":" << microseconds(r.timestamp_ns)
+                                            << ",\"pid\":1,\"args\":{\"value\":" << scientific << setprecision(9) << r.value << "}}";
+            }
+            break;
+        }
+        }
     }
 
-    // Check if tracing is enabled
-    bool isEnabled() const { return enabled; }
+    // ========================================================================
+    // Chrome Trace Event Format helpers (writer thread only)
+    // ========================================================================
 
-    // Create a new span
-    unique_ptr<TraceSpan> createSpan(const string &name, SpanType type)
+    static string microseconds(uint64_t ns)
     {
-        if (!enabled)
-            return nullptr;
-        return make_unique<TraceSpan>(name, type, &traceFile);
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                 static_cast<unsigned long long>(ns % 1000));
+        return buf;
     }
 
-    // Log a trace event
-    void logEvent(const string &message, TraceLevel level = TraceLevel::TRACE_INFO)
+    static string jsonEscape(const string &text)
     {
-        if (!enabled || level < minLevel)
-            return;
+        string out;
+        out.reserve(text.size());
+        for (unsigned char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += static_cast<char>(c);
+            }
+            else if (c < 0x20)
+            {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            }
+            else
+            {
+                out += static_cast<char>(c);
+            }
+        }
+        return out;
+    }
 
-        lock();
+    // Separator for the next event, plus a thread-name record the first time a thread appears
+    ostream &chromeEvent(uint32_t thread_index)
+    {
+        if (chromeThreads.insert(thread_index).second)
+        {
+            chromeFile << (chromeFirstEvent ? "\n" : ",\n")
+                       << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread_index
+                       << ",\"args\":{\"name\":\"thread " << thread_index << "\"}}";
+            chromeFirstEvent = false;
+        }
+        chromeFile << (chromeFirstEvent ? "\n" : ",\n");
+        chromeFirstEvent = false;
+        return chromeFile;
+    }
 
-        if (traceFile.is_open())
+    static const char *spanTypeName(uint8_t type)
+    {
+        switch (static_cast<SpanType>(type))
         {
-            auto now = chrono::system_clock::now();
-            auto now_c = chrono::system_clock::to_time_t(now);
+        case SpanType::SYSTEM_CALCULATION:
+            return "SYSTEM_CALC";
+        case SpanType::PHYSICS_TERM_EVAL:
+            return "PHYSICS_TERM";
+        case SpanType::MODULE_INIT:
+            return "MODULE_INIT";
+        case SpanType::WOLFRAM_CALL:
+            return "WOLFRAM_CALL";
+        case SpanType::OPTIMIZATION:
+            return "OPTIMIZATION";
+        case SpanType::VALIDATION:
+            return "VALIDATION";
+        case SpanType::CROSS_MODULE_COMM:
+            return "CROSS_MODULE";
+        case SpanType::SIMULATION_STEP:
+            return "SIMULATION";
+        case SpanType::STATISTICAL_ANALYSIS:
+            return "STATISTICS";
+        default:
+            return "UNKNOWN";
+        }
+    }
+
+    // One writer pass: drain every ring, order by time, format, flush
+    void drainAll()
+    {
+        vector<shared_ptr<TraceRing>> snapshot;
+        {
+            lock_guard<mutex> lock(ringsMutex);
+            snapshot = rings;
+        }
 
-            string levelStr;
-            switch (level)
+        // Entries (a head record plus its continuations) from all threads
+        vector<vector<TraceRecord>> perRing(snapshot.size());
+        uint64_t dropped = 0;
+        for (size_t k = 0; k < snapshot.size(); ++k)
+        {
+            snapshot[k]->drain(perRing[k]);
+            dropped += snapshot[k]->dropped.exchange(0, memory_order_relaxed);
+        }
+
+        struct EntryRef
+        {
+            uint64_t timestamp;
+            uint32_t ring;
+            uint32_t index;
+        };
+        vector<EntryRef> order;
+        for (size_t k = 0; k < perRing.size(); ++k)
+        {
+            const auto &recs = perRing[k];
+            for (size_t i = 0; i < recs.size(); i += 1 + recs[i].continuation)
+            {
+                order.push_back({recs[i].timestamp_ns, static_cast<uint32_t>(k), static_cast<uint32_t>(i)});
+            }
+        }
+        // Stable: entries of one thread keep their program order
+        stable_sort(order.begin(), order.end(), [](const EntryRef &a, const EntryRef &b)
+                    { return a.timestamp < b.timestamp; });
+
+        if (traceFile.is_open())
+        {
+            for (const auto &e : order)
+            {
+                formatEntry(perRing[e.ring], e.index);
+            }
+            if (dropped)
+            {
+                traceFile << "[WARN] " << formatTime(nowNs()) << " | Tracer dropped " << dropped
+                          << " records (ring buffer full)" << '\n';
+            }
+            if (!order.empty() || dropped)
             {
-            case TraceLevel::TRACE_DEBUG:
-                levelStr = "DEBUG";
-                break;
-            case TraceLevel::TRACE_INFO:
-                levelStr = "INFO";
-                break;
-            case TraceLevel::TRACE_WARN:
-                levelStr = "WARN";
-                break;
-            case TraceLevel::TRACE_ERROR:
-                levelStr = "ERROR";
-                break;
-            case TraceLevel::TRACE_FATAL:
-                levelStr = "FATAL";
-                break;
+                traceFile.flush();
+                if (chromeFile.is_open())
+                    chromeFile.flush();
             }
+        }
 
-            traceFile << "[" << levelStr << "] "
-                      << put_time(localtime(&now_c), "%Y-%m-%d %H:%M:%S")
-                      << " | " << message << endl;
+        // Forget rings whose threads have exited once they are empty
+        lock_guard<mutex> lock(ringsMutex);
+        rings.erase(remove_if(rings.begin(), rings.end(), [](const shared_ptr<TraceRing> &r)
+                              { return r->retired.load(memory_order_acquire) && r->empty(); }),
+                    rings.end());
+    }
+
+    void writerLoop()
+    {
+        unique_lock<mutex> lock(wakeMutex);
+        while (!stopWriter)
+        {
+            wake.wait_for(lock, DRAIN_INTERVAL, [&]
+                          { return stopWriter || drainRequested; });
+            drainRequested = false; // Requests made during this pass trigger another one
+            lock.unlock();
+            drainAll();
+            lock.lock();
         }
+    }
 
-        unlock();
+    void writeBanner(const char *title)
+    {
+        traceFile << "\n========================================\n";
+        traceFile << title << "\n";
+        traceFile << "Time: " << formatTime(nowNs()) << "\n";
+        traceFile << "========================================\n"
+                  << endl;
     }
 
-    // Log a performance metric
-    void logMetric(const string &metricName, double value, const string &unit = "")
+public:
+    // Singleton instance
+    static UQFFTracer &getInstance()
     {
-        if (!enabled)
+        static UQFFTracer instance;
+        return instance;
+    }
+
+    uint64_t nowNs() const
+    {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count());
+    }
+
+    uint64_t nanosecondsSinceEpoch(chrono::steady_clock::time_point t) const
+    {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(t - epoch).count());
+    }
+
+    // Append one entry to the calling thread's ring. `text` and optional `extra`
+    // (joined by TraceRecord::SEPARATOR) are copied raw; nothing is formatted here.
+    void emit(TraceRecord::Kind kind, uint8_t code, uint64_t span_id, uint64_t timestamp_ns,
+              double value, int64_t int_value, const string &text, const string *extra = nullptr)
+    {
+        TraceRing &ring = localRing();
+
+        size_t len = text.size() + (extra ? 1 + extra->size() : 0);
+        const size_t head_bytes = sizeof(TraceRecord::text);
+        const size_t max_len = head_bytes + (TraceRing::MAX_RECORDS_PER_ENTRY - 1) * sizeof(TraceRecord);
+        len = min(len, max_len);
+        const size_t continuation = len > head_bytes ? (len - head_bytes + sizeof(TraceRecord) - 1) / sizeof(TraceRecord) : 0;
+
+        uint64_t start;
+        if (!ring.reserve(1 + continuation, start))
             return;
 
-        lock();
+        TraceRecord &r = ring.at(start);
+        r.timestamp_ns = timestamp_ns;
+        r.span_id = span_id;
+        if (kind == TraceRecord::ATTR_INT || kind == TraceRecord::SPAN_START || kind == TraceRecord::SPAN_END)
+            r.int_value = int_value;
+        else
+            r.value = value;
+        r.thread_index = ring.thread_index;
+        r.kind = kind;
+        r.code = code;
+        r.continuation = static_cast<uint8_t>(continuation);
+        r.reserved = 0;
+        r.text_len = static_cast<uint32_t>(len);
+
+        // Scatter the text: head record first, then whole continuation records
+        size_t written = 0;
+        auto put = [&](const char *src, size_t n)
+        {
+            while (n > 0 && written < len)
+            {
+                char *dst;
+                size_t room;
+                if (written < head_bytes)
+                {
+                    dst = r.text + written;
+                    room = head_bytes - written;
+                }
+                else
+                {
+                    size_t off = written - head_bytes;
+                    dst = reinterpret_cast<char *>(&ring.at(start + 1 + off / sizeof(TraceRecord))) + off % sizeof(TraceRecord);
+                    room = sizeof(TraceRecord) - off % sizeof(TraceRecord);
+                }
+                size_t chunk = min({n, room, len - written});
+                memcpy(dst, src, chunk);
+                src += chunk;
+                n -= chunk;
+                written += chunk;
+            }
+        };
+        put(text.data(), text.size());
+        if (extra)
+        {
+            const char sep = TraceRecord::SEPARATOR;
+            put(&sep, 1);
+            put(extra->data(), extra->size());
+        }
 
-        if (traceFile.is_open())
+        ring.publish(start, 1 + continuation);
+
+        // Wake the writer early rather than wait out DRAIN_INTERVAL and start dropping
+        if (ring.needsDrain(start + 1 + continuation) && !ring.nudged.exchange(true, memory_order_relaxed))
         {
-            auto now = chrono::system_clock::now();
-            auto now_c = chrono::system_clock::to_time_t(now);
+            {
+                lock_guard<mutex> lock(wakeMutex);
+                drainRequested = true;
+            }
+            wake.notify_one();
+        }
+    }
+
+    // Per-thread span ids: ring index in the high bits, so no shared counter is touched
+    uint64_t nextSpanId()
+    {
+        thread_local uint64_t counter = 0;
+        return (static_cast<uint64_t>(localRing().thread_index) << 40) | ++counter;
+    }
 
-            traceFile << "[METRIC] " << put_time(localtime(&now_c), "%Y-%m-%d %H:%M:%S")
-                      << " | " << metricName << " = " << scientific << setprecision(6) << value;
+    // Initialize tracing; a non-empty chromeTraceFile also writes Chrome Trace Event JSON
+    void initialize(const string &filename = "uqff_trace.log", TraceLevel level = TraceLevel::TRACE_INFO,
+                    const string &chromeTraceFile = "")
+    {
+        lock_guard<mutex> control(controlMutex);
+        stopWriterThread();
 
-            if (!unit.empty())
+        if (traceFile.is_open())
+        {
+            traceFile.close();
+        }
+        closeChromeTrace();
+        if (!chromeTraceFile.empty())
+        {
+            chromeFile.open(chromeTraceFile, ios::out | ios::trunc);
+            if (chromeFile.is_open())
             {
-                traceFile << " " << unit;
+                chromeFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+                chromeFirstEvent = true;
+                chromeThreads.clear();
             }
+        }
 
-            traceFile << endl;
+        traceFile.open(filename, ios::out | ios::app);
+        if (traceFile.is_open())
+        {
+            minLevel.store(static_cast<int>(level), memory_order_relaxed);
+            writeBanner("UQFF TRACING SESSION STARTED");
+            stopWriter = false;
+            drainRequested = false;
+            writer = thread([this]
+                            { writerLoop(); });
+            enabled.store(true, memory_order_release);
         }
+    }
+
+    // Check if tracing is enabled
+    bool isEnabled() const { return enabled.load(memory_order_relaxed); }
 
-        unlock();
+    // Create a new span (nullptr while tracing is disabled)
+    unique_ptr<TraceSpan> createSpan(const string &name, SpanType type,
+                                     uint64_t parent = TraceSpan::INHERIT_PARENT)
+    {
+        if (!isEnabled())
+            return nullptr;
+        return make_unique<TraceSpan>(name, type, this, parent);
+    }
+
+    // Literal names: no string is built unless tracing is on
+    unique_ptr<TraceSpan> createSpan(const char *name, SpanType type,
+                                     uint64_t parent = TraceSpan::INHERIT_PARENT)
+    {
+        if (!isEnabled())
+            return nullptr;
+        return make_unique<TraceSpan>(string(name), type, this, parent);
     }
 
-    // Shutdown tracing
+    // Log a trace event
+    void logEvent(const string &message, TraceLevel level = TraceLevel::TRACE_INFO)
+    {
+        if (!isEnabled() || static_cast<int>(level) < minLevel.load(memory_order_relaxed))
+            return;
+        emit(TraceRecord::EVENT, static_cast<uint8_t>(level), 0, nowNs(), 0.0, 0, message);
+    }
+
+    // Log a performance metric
+    void logMetric(const string &metricName, double value, const string &unit = "")
+    {
+        if (!isEnabled())
+            return;
+        emit(TraceRecord::METRIC, 0, 0, nowNs(), value, 0, metricName, unit.empty() ? nullptr : &unit);
+    }
+
+    // Shutdown tracing (drains everything recorded so far)
     void shutdown()
     {
-        lock();
+        lock_guard<mutex> control(controlMutex);
+        enabled.store(false, memory_order_release);
+        stopWriterThread();
 
         if (traceFile.is_open())
         {
-            auto now = chrono::system_clock::now();
-            auto now_c = chrono::system_clock::to_time_t(now);
-
-            traceFile << "\n========================================" << endl;
-            traceFile << "UQFF TRACING SESSION ENDED" << endl;
-            traceFile << "Time: " << put_time(localtime(&now_c), "%Y-%m-%d %H:%M:%S") << endl;
-            traceFile << "========================================\n"
-                      << endl;
-
+            writeBanner("UQFF TRACING SESSION ENDED");
             traceFile.close();
-            enabled = false;
         }
-
-        unlock();
+        closeChromeTrace();
     }
 
     // Delete copy constructor and assignment operator
     UQFFTracer(const UQFFTracer &) = delete;
     UQFFTracer &operator=(const UQFFTracer &) = delete;
+
+private:
+    void closeChromeTrace()
+    {
+        if (!chromeFile.is_open())
+            return;
+        chromeFile << "\n]}\n";
+        chromeFile.close();
+        openSpanParents.clear();
+        pendingAttributes.clear();
+    }
+
+    void stopWriterThread()
+    {
+        if (!writer.joinable())
+            return;
+        {
+            lock_guard<mutex> lock(wakeMutex);
+            stopWriter = true;
+        }
+        wake.notify_all();
+        writer.join();
+        drainAll(); // Anything published after the writer's last pass
+    }
 };
 
+inline TraceSpan::TraceSpan(const string &name, SpanType type, UQFFTracer *owner, uint64_t parent)
+    : tracer(owner), spanName(name), spanType(type), spanId(owner->nextSpanId()),
+      parentId(parent == INHERIT_PARENT ? threadCurrent() : parent), enclosingId(threadCurrent()), completed(false)
+{
+    threadCurrent() = spanId;
+    startTime = chrono::steady_clock::now();
+    tracer->emit(TraceRecord::SPAN_START, static_cast<uint8_t>(spanType), spanId,
+                 tracer->nanosecondsSinceEpoch(startTime), 0.0, static_cast<int64_t>(parentId), spanName);
+}
+
+inline void TraceSpan::end()
+{
+    if (completed)
+        return;
+
+    auto endTime = chrono::steady_clock::now();
+    completed = true;
+    if (threadCurrent() == spanId)
+        threadCurrent() = enclosingId;
+    if (!tracer->isEnabled())
+        return;
+
+    // Attributes precede the end record in this thread's ring
+    const uint64_t ts = tracer->nanosecondsSinceEpoch(endTime);
+    for (const auto &attr : attributes)
+    {
+        tracer->emit(attr.kind, 0, spanId, ts, attr.value, attr.int_value, attr.key,
+                     attr.kind == TraceRecord::ATTR_TEXT ? &attr.text : nullptr);
+    }
+    const int64_t duration = chrono::duration_cast<chrono::nanoseconds>(endTime - startTime).count();
+    tracer->emit(TraceRecord::SPAN_END, static_cast<uint8_t>(spanType), spanId, ts, 0.0, duration, spanName);
+}
+
 // Convenience macros for tracing
 #define TRACE_INIT(filename) UQFFTracer::getInstance().initialize(filename)
 #define TRACE_SHUTDOWN() UQFFTracer::getInstance().shutdown()
 #define TRACE_EVENT(msg, level) UQFFTracer::getInstance().logEvent(msg, level)
 #define TRACE_METRIC(name, value, unit) UQFFTracer::getInstance().logMetric(name, value, unit)
-#define TRACE_SPAN(name, type) auto span_##__LINE__ = UQFFTracer::getInstance().createSpan(name, type)
+#define UQFF_TRACE_CONCAT_(a, b) a##b
+#define UQFF_TRACE_CONCAT(a, b) UQFF_TRACE_CONCAT_(a, b)
+#define TRACE_INIT_CHROME(filename, json_filename) \
+    UQFFTracer::getInstance().initialize(filename, TraceLevel::TRACE_INFO, json_filename)
+#define TRACE_SPAN(name, type) auto UQFF_TRACE_CONCAT(span_, __LINE__) = UQFFTracer::getInstance().createSpan(name, type)
 
 #endif // UQFF_TRACING_H